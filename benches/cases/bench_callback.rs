@@ -0,0 +1,374 @@
+// Copyright 2026 TiKV Project Authors. Licensed under Apache-2.0.
+
+use std::os::raw::{c_char, c_int, c_void};
+use std::ptr;
+use std::slice;
+use std::sync::Arc;
+
+use super::libc::{self, size_t};
+use super::raw_db::{check, key, open_db, RawDB, NUM_KEYS};
+use super::rocksdb::crocksdb_ffi::{
+    self, CompactionFilterDecision as RawCompactionFilterDecision, DBCompactionFilter, DBEnv,
+};
+use super::rocksdb::{
+    BlockBasedOptions, ColumnFamilyOptions, CompactOptions, CompactionFilter,
+    CompactionFilterDecision, CompactionFilterValueType, DBBottommostLevelCompaction, DBOptions,
+    Env, MergeOperands, ReadOptions, Writable,
+};
+use super::test::{black_box, Bencher};
+
+const MERGE_OPERANDS: usize = 8;
+const CIPHERTEXT: [u8; 16] = [16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1];
+
+struct KeepFilter;
+
+impl CompactionFilter for KeepFilter {
+    fn unsafe_filter(
+        &mut self,
+        _: usize,
+        _: &[u8],
+        value: &[u8],
+        _: CompactionFilterValueType,
+    ) -> CompactionFilterDecision {
+        black_box(value);
+        CompactionFilterDecision::Keep
+    }
+}
+
+extern "C" fn raw_keep_filter_name(_: *mut c_void) -> *const c_char {
+    b"keep\0".as_ptr() as *const c_char
+}
+
+extern "C" fn raw_keep_filter_destructor(_: *mut c_void) {}
+
+extern "C" fn raw_keep_filter(
+    _: *mut c_void,
+    _: c_int,
+    _: *const u8,
+    _: size_t,
+    _: CompactionFilterValueType,
+    value: *const u8,
+    value_len: size_t,
+    new_value: *mut *mut u8,
+    new_value_len: *mut size_t,
+    skip_until: *mut *mut u8,
+    skip_until_len: *mut size_t,
+) -> RawCompactionFilterDecision {
+    unsafe {
+        *new_value = ptr::null_mut();
+        *new_value_len = 0;
+        *skip_until = ptr::null_mut();
+        *skip_until_len = 0;
+        black_box(slice::from_raw_parts(value, value_len));
+    }
+    RawCompactionFilterDecision::Keep
+}
+
+fn run_bench_compaction(b: &mut Bencher, name: &str, cf_opts: ColumnFamilyOptions) {
+    let (_dir, db) = open_db(name, DBOptions::new(), cf_opts);
+    let cf = db.cf_handle("default").unwrap();
+    let mut compact_opts = CompactOptions::new();
+    compact_opts.set_bottommost_level_compaction(DBBottommostLevelCompaction::Force);
+    // Every iteration rewrites all keys of the bottommost level.
+    b.iter(|| db.compact_range_cf_opt(cf, &compact_opts, None, None));
+}
+
+#[bench]
+fn bench_compaction_with_filter_raw(b: &mut Bencher) {
+    unsafe {
+        let filter = crocksdb_ffi::crocksdb_compactionfilter_create(
+            ptr::null_mut(),
+            raw_keep_filter_destructor,
+            raw_keep_filter,
+            raw_keep_filter_name,
+        );
+        let raw = RawDB::open_with("_rust_rocksdb_bench_compaction_with_filter_raw", |opts| {
+            crocksdb_ffi::crocksdb_options_set_compaction_filter(opts, filter);
+        });
+        let compact_opts = crocksdb_ffi::crocksdb_compactoptions_create();
+        crocksdb_ffi::crocksdb_compactoptions_set_bottommost_level_compaction(
+            compact_opts,
+            DBBottommostLevelCompaction::Force,
+        );
+        b.iter(|| {
+            crocksdb_ffi::crocksdb_compact_range_cf_opt(
+                raw.db,
+                raw.cf,
+                compact_opts,
+                ptr::null(),
+                0,
+                ptr::null(),
+                0,
+            )
+        });
+        crocksdb_ffi::crocksdb_compactoptions_destroy(compact_opts);
+        // The options only borrow the filter.
+        drop(raw);
+        crocksdb_ffi::crocksdb_compactionfilter_destroy(filter);
+    }
+}
+
+#[bench]
+fn bench_compaction_with_filter(b: &mut Bencher) {
+    let mut cf_opts = ColumnFamilyOptions::new();
+    cf_opts.set_compaction_filter("keep", KeepFilter).unwrap();
+    run_bench_compaction(b, "_rust_rocksdb_bench_compaction_with_filter", cf_opts);
+}
+
+#[bench]
+fn bench_compaction_without_filter(b: &mut Bencher) {
+    run_bench_compaction(
+        b,
+        "_rust_rocksdb_bench_compaction_without_filter",
+        ColumnFamilyOptions::new(),
+    );
+}
+
+fn concat_merge(_: &[u8], existing_val: Option<&[u8]>, operands: &mut MergeOperands) -> Vec<u8> {
+    let mut result = existing_val.map_or_else(Vec::new, |v| v.to_vec());
+    for op in operands {
+        result.extend_from_slice(op);
+    }
+    result
+}
+
+unsafe extern "C" fn raw_concat_merge_name(_: *mut c_void) -> *const c_char {
+    b"concat\0".as_ptr() as *const c_char
+}
+
+unsafe extern "C" fn raw_concat_merge_destructor(_: *mut c_void) {}
+
+/// Concatenates the operands onto the existing value into a buffer that
+/// the C API frees.
+unsafe fn raw_concat(
+    existing_value: *const c_char,
+    existing_value_len: size_t,
+    operands_list: *const *const c_char,
+    operands_list_len: *const size_t,
+    num_operands: c_int,
+    success: *mut u8,
+    new_value_length: *mut size_t,
+) -> *const c_char {
+    let operands = slice::from_raw_parts(operands_list, num_operands as usize);
+    let lens = slice::from_raw_parts(operands_list_len, num_operands as usize);
+    let len = existing_value_len + lens.iter().sum::<size_t>();
+    let buf = libc::malloc(len) as *mut c_char;
+    assert!(!buf.is_null());
+    if existing_value_len > 0 {
+        ptr::copy_nonoverlapping(existing_value, buf, existing_value_len);
+    }
+    let mut offset = existing_value_len;
+    for (op, op_len) in operands.iter().zip(lens) {
+        ptr::copy_nonoverlapping(*op, buf.add(offset), *op_len);
+        offset += op_len;
+    }
+    *new_value_length = len;
+    *success = 1;
+    buf
+}
+
+unsafe extern "C" fn raw_concat_full_merge(
+    _: *mut c_void,
+    _: *const c_char,
+    _: size_t,
+    existing_value: *const c_char,
+    existing_value_len: size_t,
+    operands_list: *const *const c_char,
+    operands_list_len: *const size_t,
+    num_operands: c_int,
+    success: *mut u8,
+    new_value_length: *mut size_t,
+) -> *const c_char {
+    let existing_value_len = if existing_value.is_null() {
+        0
+    } else {
+        existing_value_len
+    };
+    raw_concat(
+        existing_value,
+        existing_value_len,
+        operands_list,
+        operands_list_len,
+        num_operands,
+        success,
+        new_value_length,
+    )
+}
+
+unsafe extern "C" fn raw_concat_partial_merge(
+    _: *mut c_void,
+    _: *const c_char,
+    _: size_t,
+    operands_list: *const *const c_char,
+    operands_list_len: *const size_t,
+    num_operands: c_int,
+    success: *mut u8,
+    new_value_length: *mut size_t,
+) -> *const c_char {
+    raw_concat(
+        ptr::null(),
+        0,
+        operands_list,
+        operands_list_len,
+        num_operands,
+        success,
+        new_value_length,
+    )
+}
+
+/// Every iteration merges into a key of its own, so the number of operands
+/// a read folds stays the same however long the benchmark runs.
+fn merge_key(i: usize) -> Vec<u8> {
+    format!("merge_{:016}", i).into_bytes()
+}
+
+#[bench]
+fn bench_merge_operator_raw(b: &mut Bencher) {
+    let raw = RawDB::open_with("_rust_rocksdb_bench_merge_operator_raw", |opts| unsafe {
+        let mo = crocksdb_ffi::crocksdb_mergeoperator_create(
+            ptr::null_mut(),
+            raw_concat_merge_destructor,
+            raw_concat_full_merge,
+            raw_concat_partial_merge,
+            None,
+            raw_concat_merge_name,
+        );
+        crocksdb_ffi::crocksdb_options_set_merge_operator(opts, mo);
+    });
+    let operand = b"operand";
+    let mut i = 0;
+    b.iter(|| unsafe {
+        let k = merge_key(i);
+        let mut err = ptr::null_mut();
+        for _ in 0..MERGE_OPERANDS {
+            crocksdb_ffi::crocksdb_merge_cf(
+                raw.db,
+                raw.wopts,
+                raw.cf,
+                k.as_ptr(),
+                k.len(),
+                operand.as_ptr(),
+                operand.len(),
+                &mut err,
+            );
+            check(err);
+        }
+        let mut len = 0;
+        let v = crocksdb_ffi::crocksdb_get_cf(
+            raw.db,
+            raw.ropts,
+            raw.cf,
+            k.as_ptr(),
+            k.len(),
+            &mut len,
+            &mut err,
+        );
+        check(err);
+        assert!(!v.is_null());
+        black_box(len);
+        crocksdb_ffi::crocksdb_free(v as *mut _);
+        i += 1;
+    });
+}
+
+#[bench]
+fn bench_merge_operator(b: &mut Bencher) {
+    let mut cf_opts = ColumnFamilyOptions::new();
+    cf_opts.add_merge_operator("concat", concat_merge);
+    let (_dir, db) = open_db(
+        "_rust_rocksdb_bench_merge_operator",
+        DBOptions::new(),
+        cf_opts,
+    );
+    let mut i = 0;
+    b.iter(|| {
+        let k = merge_key(i);
+        for _ in 0..MERGE_OPERANDS {
+            db.merge(&k, b"operand").unwrap();
+        }
+        black_box(db.get(&k).unwrap().unwrap().len());
+        i += 1;
+    });
+}
+
+#[bench]
+fn bench_uncached_get_encrypted_env_raw(b: &mut Bencher) {
+    unsafe {
+        let base_env = crocksdb_ffi::crocksdb_default_env_create();
+        let env: *mut DBEnv = crocksdb_ffi::crocksdb_ctr_encrypted_env_create(
+            base_env,
+            CIPHERTEXT.as_ptr() as *const c_char,
+            CIPHERTEXT.len(),
+        );
+        let block_opts = crocksdb_ffi::crocksdb_block_based_options_create();
+        crocksdb_ffi::crocksdb_block_based_options_set_no_block_cache(block_opts, true);
+        let raw = RawDB::open_with(
+            "_rust_rocksdb_bench_uncached_get_encrypted_env_raw",
+            |opts| {
+                crocksdb_ffi::crocksdb_options_set_env(opts, env);
+                crocksdb_ffi::crocksdb_options_set_block_based_table_factory(opts, block_opts);
+            },
+        );
+        crocksdb_ffi::crocksdb_block_based_options_destroy(block_opts);
+        crocksdb_ffi::crocksdb_readoptions_set_fill_cache(raw.ropts, false);
+        let mut i = 0;
+        b.iter(|| {
+            let k = key(i);
+            let mut len = 0;
+            let mut err = ptr::null_mut();
+            let v = crocksdb_ffi::crocksdb_get_cf(
+                raw.db,
+                raw.ropts,
+                raw.cf,
+                k.as_ptr(),
+                k.len(),
+                &mut len,
+                &mut err,
+            );
+            check(err);
+            assert!(!v.is_null());
+            black_box(len);
+            crocksdb_ffi::crocksdb_free(v as *mut _);
+            i = (i + 7) % NUM_KEYS;
+        });
+        // The options only borrow the envs.
+        drop(raw);
+        crocksdb_ffi::crocksdb_env_destroy(env);
+        crocksdb_ffi::crocksdb_env_destroy(base_env);
+    }
+}
+
+fn run_bench_uncached_get(b: &mut Bencher, name: &str, env: Option<Arc<Env>>) {
+    let mut opts = DBOptions::new();
+    if let Some(env) = env {
+        opts.set_env(env);
+    }
+    let mut block_opts = BlockBasedOptions::new();
+    block_opts.set_no_block_cache(true);
+    let mut cf_opts = ColumnFamilyOptions::new();
+    cf_opts.set_block_based_table_factory(&block_opts);
+    let (_dir, db) = open_db(name, opts, cf_opts);
+    let mut ropts = ReadOptions::new();
+    ropts.set_fill_cache(false);
+    let mut i = 0;
+    // Without a block cache every get reads, and decrypts, a data block.
+    b.iter(|| {
+        black_box(db.get_opt(&key(i), &ropts).unwrap().unwrap().len());
+        i = (i + 7) % NUM_KEYS;
+    });
+}
+
+#[bench]
+fn bench_uncached_get_encrypted_env(b: &mut Bencher) {
+    let env = Env::new_default_ctr_encrypted_env(&CIPHERTEXT).unwrap();
+    run_bench_uncached_get(
+        b,
+        "_rust_rocksdb_bench_uncached_get_encrypted_env",
+        Some(Arc::new(env)),
+    );
+}
+
+#[bench]
+fn bench_uncached_get_default_env(b: &mut Bencher) {
+    run_bench_uncached_get(b, "_rust_rocksdb_bench_uncached_get_default_env", None);
+}
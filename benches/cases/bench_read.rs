@@ -0,0 +1,174 @@
+// Copyright 2026 TiKV Project Authors. Licensed under Apache-2.0.
+
+use std::ptr;
+
+use super::raw_db::{check, key, open_db, RawDB, NUM_KEYS};
+use super::rocksdb::crocksdb_ffi::{self, DBCFHandle};
+use super::rocksdb::{ColumnFamilyOptions, DBOptions, SeekKey};
+use super::test::{black_box, Bencher};
+
+const SCAN_LEN: usize = 1000;
+
+#[bench]
+fn bench_get_raw(b: &mut Bencher) {
+    let raw = RawDB::open("_rust_rocksdb_bench_get_raw", false);
+    let mut i = 0;
+    b.iter(|| unsafe {
+        let k = key(i);
+        let mut len = 0;
+        let mut err = ptr::null_mut();
+        let v = crocksdb_ffi::crocksdb_get_cf(
+            raw.db,
+            raw.ropts,
+            raw.cf,
+            k.as_ptr(),
+            k.len(),
+            &mut len,
+            &mut err,
+        );
+        check(err);
+        black_box(len);
+        crocksdb_ffi::crocksdb_free(v as *mut _);
+        i += 1;
+    });
+}
+
+#[bench]
+fn bench_get_pinned_raw(b: &mut Bencher) {
+    let raw = RawDB::open("_rust_rocksdb_bench_get_pinned_raw", false);
+    let mut i = 0;
+    b.iter(|| unsafe {
+        let k = key(i);
+        let mut err = ptr::null_mut();
+        let v = crocksdb_ffi::crocksdb_get_pinned(raw.db, raw.ropts, k.as_ptr(), k.len(), &mut err);
+        check(err);
+        let mut len = 0;
+        black_box(crocksdb_ffi::crocksdb_pinnableslice_value(v, &mut len));
+        crocksdb_ffi::crocksdb_pinnableslice_destroy(v);
+        i += 1;
+    });
+}
+
+#[bench]
+fn bench_get_rust(b: &mut Bencher) {
+    let (_dir, db) = open_db(
+        "_rust_rocksdb_bench_get_rust",
+        DBOptions::new(),
+        ColumnFamilyOptions::new(),
+    );
+    let mut i = 0;
+    b.iter(|| {
+        black_box(db.get(&key(i)).unwrap().unwrap().len());
+        i += 1;
+    });
+}
+
+fn run_bench_multi_get_cf_raw(b: &mut Bencher, batch_size: usize) {
+    let raw = RawDB::open("_rust_rocksdb_bench_multi_get_cf_raw", false);
+    let cfs = vec![raw.cf as *const DBCFHandle; batch_size];
+    let mut values = vec![ptr::null_mut(); batch_size];
+    let mut value_sizes = vec![0; batch_size];
+    let mut errs = vec![ptr::null_mut(); batch_size];
+    let mut i = 0;
+    b.iter(|| unsafe {
+        let keys: Vec<_> = (i..i + batch_size).map(key).collect();
+        let key_ptrs: Vec<_> = keys.iter().map(|k| k.as_ptr()).collect();
+        let key_sizes: Vec<_> = keys.iter().map(|k| k.len()).collect();
+        crocksdb_ffi::crocksdb_multi_get_cf(
+            raw.db,
+            raw.ropts,
+            cfs.as_ptr(),
+            batch_size,
+            key_ptrs.as_ptr(),
+            key_sizes.as_ptr(),
+            values.as_mut_ptr(),
+            value_sizes.as_mut_ptr(),
+            errs.as_mut_ptr(),
+        );
+        for j in 0..batch_size {
+            check(errs[j]);
+            black_box(value_sizes[j]);
+            crocksdb_ffi::crocksdb_free(values[j] as *mut _);
+        }
+        i = (i + batch_size) % NUM_KEYS;
+    });
+}
+
+#[bench]
+fn bench_multi_get_cf_raw_1(b: &mut Bencher) {
+    run_bench_multi_get_cf_raw(b, 1);
+}
+
+#[bench]
+fn bench_multi_get_cf_raw_16(b: &mut Bencher) {
+    run_bench_multi_get_cf_raw(b, 16);
+}
+
+#[bench]
+fn bench_multi_get_cf_raw_128(b: &mut Bencher) {
+    run_bench_multi_get_cf_raw(b, 128);
+}
+
+fn run_bench_get_cf_loop_rust(b: &mut Bencher, batch_size: usize) {
+    let (_dir, db) = open_db(
+        "_rust_rocksdb_bench_get_cf_loop_rust",
+        DBOptions::new(),
+        ColumnFamilyOptions::new(),
+    );
+    let cf = db.cf_handle("default").unwrap();
+    let mut i = 0;
+    b.iter(|| {
+        for k in (i..i + batch_size).map(key) {
+            black_box(db.get_cf(cf, &k).unwrap().unwrap().len());
+        }
+        i = (i + batch_size) % NUM_KEYS;
+    });
+}
+
+#[bench]
+fn bench_get_cf_loop_rust_16(b: &mut Bencher) {
+    run_bench_get_cf_loop_rust(b, 16);
+}
+
+#[bench]
+fn bench_get_cf_loop_rust_128(b: &mut Bencher) {
+    run_bench_get_cf_loop_rust(b, 128);
+}
+
+#[bench]
+fn bench_iter_scan_raw(b: &mut Bencher) {
+    let raw = RawDB::open("_rust_rocksdb_bench_iter_scan_raw", false);
+    b.iter(|| unsafe {
+        let iter = crocksdb_ffi::crocksdb_create_iterator(raw.db, raw.ropts);
+        crocksdb_ffi::crocksdb_iter_seek_to_first(iter);
+        let mut n = 0;
+        while n < SCAN_LEN && crocksdb_ffi::crocksdb_iter_valid(iter) {
+            let (mut klen, mut vlen) = (0, 0);
+            black_box(crocksdb_ffi::crocksdb_iter_key(iter, &mut klen));
+            black_box(crocksdb_ffi::crocksdb_iter_value(iter, &mut vlen));
+            crocksdb_ffi::crocksdb_iter_next(iter);
+            n += 1;
+        }
+        crocksdb_ffi::crocksdb_iter_destroy(iter);
+    });
+}
+
+#[bench]
+fn bench_iter_scan_rust(b: &mut Bencher) {
+    let (_dir, db) = open_db(
+        "_rust_rocksdb_bench_iter_scan_rust",
+        DBOptions::new(),
+        ColumnFamilyOptions::new(),
+    );
+    b.iter(|| {
+        let mut iter = db.iter();
+        let mut valid = iter.seek(SeekKey::Start).unwrap();
+        let mut n = 0;
+        while n < SCAN_LEN && valid {
+            black_box(iter.key());
+            black_box(iter.value());
+            valid = iter.next().unwrap();
+            n += 1;
+        }
+    });
+}
@@ -0,0 +1,210 @@
+// Copyright 2026 TiKV Project Authors. Licensed under Apache-2.0.
+
+use std::ffi::CString;
+use std::ptr;
+
+use super::raw_db::{check, key, open_db, value, RawDB};
+use super::rocksdb::crocksdb_ffi;
+use super::rocksdb::{
+    ColumnFamilyOptions, DBOptions, EnvOptions, IngestExternalFileOptions, SstFileWriter, Writable,
+    WriteBatch, WriteOptions,
+};
+use super::test::Bencher;
+
+const BATCH_SIZE: usize = 16;
+const NUM_BATCHES: usize = 4;
+const SST_KEYS: usize = 256;
+
+#[bench]
+fn bench_writebatch_raw(b: &mut Bencher) {
+    let raw = RawDB::open("_rust_rocksdb_bench_writebatch_raw", false);
+    let v = value();
+    let mut i = 0;
+    unsafe {
+        let wb = crocksdb_ffi::crocksdb_writebatch_create();
+        b.iter(|| {
+            crocksdb_ffi::crocksdb_writebatch_clear(wb);
+            for k in (i..i + BATCH_SIZE).map(key) {
+                crocksdb_ffi::crocksdb_writebatch_put(wb, k.as_ptr(), k.len(), v.as_ptr(), v.len());
+            }
+            let mut err = ptr::null_mut();
+            crocksdb_ffi::crocksdb_write(raw.db, raw.wopts, wb, &mut err);
+            check(err);
+            i += BATCH_SIZE;
+        });
+        crocksdb_ffi::crocksdb_writebatch_destroy(wb);
+    }
+}
+
+#[bench]
+fn bench_writebatch_rust(b: &mut Bencher) {
+    let (_dir, db) = open_db(
+        "_rust_rocksdb_bench_writebatch_rust",
+        DBOptions::new(),
+        ColumnFamilyOptions::new(),
+    );
+    let mut wopts = WriteOptions::new();
+    wopts.disable_wal(true);
+    let v = value();
+    let mut i = 0;
+    let wb = WriteBatch::new();
+    b.iter(|| {
+        wb.clear();
+        for k in (i..i + BATCH_SIZE).map(key) {
+            wb.put(&k, &v).unwrap();
+        }
+        db.write_opt(&wb, &wopts).unwrap();
+        i += BATCH_SIZE;
+    });
+}
+
+#[bench]
+fn bench_write_multi_batch_raw(b: &mut Bencher) {
+    let raw = RawDB::open("_rust_rocksdb_bench_write_multi_batch_raw", true);
+    let v = value();
+    let mut i = 0;
+    unsafe {
+        let batches: Vec<_> = (0..NUM_BATCHES)
+            .map(|_| crocksdb_ffi::crocksdb_writebatch_create())
+            .collect();
+        b.iter(|| {
+            for wb in &batches {
+                crocksdb_ffi::crocksdb_writebatch_clear(*wb);
+                for k in (i..i + BATCH_SIZE / NUM_BATCHES).map(key) {
+                    crocksdb_ffi::crocksdb_writebatch_put(
+                        *wb,
+                        k.as_ptr(),
+                        k.len(),
+                        v.as_ptr(),
+                        v.len(),
+                    );
+                }
+                i += BATCH_SIZE / NUM_BATCHES;
+            }
+            let mut err = ptr::null_mut();
+            crocksdb_ffi::crocksdb_write_multi_batch(
+                raw.db,
+                raw.wopts,
+                batches.as_ptr(),
+                batches.len(),
+                &mut err,
+            );
+            check(err);
+        });
+        for wb in batches {
+            crocksdb_ffi::crocksdb_writebatch_destroy(wb);
+        }
+    }
+}
+
+#[bench]
+fn bench_write_multi_batch_rust(b: &mut Bencher) {
+    let opts = DBOptions::new();
+    opts.enable_multi_batch_write(true);
+    let (_dir, db) = open_db(
+        "_rust_rocksdb_bench_write_multi_batch_rust",
+        opts,
+        ColumnFamilyOptions::new(),
+    );
+    let mut wopts = WriteOptions::new();
+    wopts.disable_wal(true);
+    let v = value();
+    let mut i = 0;
+    let batches: Vec<_> = (0..NUM_BATCHES).map(|_| WriteBatch::new()).collect();
+    b.iter(|| {
+        for wb in &batches {
+            wb.clear();
+            for k in (i..i + BATCH_SIZE / NUM_BATCHES).map(key) {
+                wb.put(&k, &v).unwrap();
+            }
+            i += BATCH_SIZE / NUM_BATCHES;
+        }
+        db.multi_batch_write(&batches, &wopts).unwrap();
+    });
+}
+
+#[bench]
+fn bench_sst_file_writer_ingest_raw(b: &mut Bencher) {
+    let raw = RawDB::open("_rust_rocksdb_bench_sst_file_writer_ingest_raw", false);
+    let dir = tempfile::Builder::new()
+        .prefix("_rust_rocksdb_bench_sst_file_writer_ingest_raw_files")
+        .tempdir()
+        .unwrap();
+    let v = value();
+    let mut n = 0;
+    unsafe {
+        let env_opts = crocksdb_ffi::crocksdb_envoptions_create();
+        let opts = crocksdb_ffi::crocksdb_options_create();
+        let ingest_opts = crocksdb_ffi::crocksdb_ingestexternalfileoptions_create();
+        crocksdb_ffi::crocksdb_ingestexternalfileoptions_set_move_files(ingest_opts, true);
+        b.iter(|| {
+            // Every file covers its own key range, so it is ingested into the
+            // bottommost level instead of piling up in L0.
+            let path = dir.path().join(format!("ingest_{}.sst", n));
+            let path = CString::new(path.to_str().unwrap()).unwrap();
+            let writer = crocksdb_ffi::crocksdb_sstfilewriter_create(env_opts, opts);
+            let info = crocksdb_ffi::crocksdb_externalsstfileinfo_create();
+            let mut err = ptr::null_mut();
+            crocksdb_ffi::crocksdb_sstfilewriter_open(writer, path.as_ptr(), &mut err);
+            check(err);
+            for i in 0..SST_KEYS {
+                let k = format!("sst_{:08}_{:04}", n, i);
+                crocksdb_ffi::crocksdb_sstfilewriter_put(
+                    writer,
+                    k.as_ptr(),
+                    k.len(),
+                    v.as_ptr(),
+                    v.len(),
+                    &mut err,
+                );
+                check(err);
+            }
+            crocksdb_ffi::crocksdb_sstfilewriter_finish(writer, info, &mut err);
+            check(err);
+            crocksdb_ffi::crocksdb_externalsstfileinfo_destroy(info);
+            crocksdb_ffi::crocksdb_sstfilewriter_destroy(writer);
+            let files = [path.as_ptr()];
+            crocksdb_ffi::crocksdb_ingest_external_file_cf(
+                raw.db,
+                raw.cf,
+                files.as_ptr(),
+                files.len(),
+                ingest_opts,
+                &mut err,
+            );
+            check(err);
+            n += 1;
+        });
+        crocksdb_ffi::crocksdb_ingestexternalfileoptions_destroy(ingest_opts);
+        crocksdb_ffi::crocksdb_options_destroy(opts);
+        crocksdb_ffi::crocksdb_envoptions_destroy(env_opts);
+    }
+}
+
+#[bench]
+fn bench_sst_file_writer_ingest(b: &mut Bencher) {
+    let (dir, db) = open_db(
+        "_rust_rocksdb_bench_sst_file_writer_ingest",
+        DBOptions::new(),
+        ColumnFamilyOptions::new(),
+    );
+    let mut ingest_opts = IngestExternalFileOptions::new();
+    ingest_opts.move_files(true);
+    let v = value();
+    let mut n = 0;
+    b.iter(|| {
+        // Every file covers its own key range, so it is ingested into the
+        // bottommost level instead of piling up in L0.
+        let path = dir.path().join(format!("ingest_{}.sst", n));
+        let path = path.to_str().unwrap();
+        let mut writer = SstFileWriter::new(EnvOptions::new(), ColumnFamilyOptions::new());
+        writer.open(path).unwrap();
+        for i in 0..SST_KEYS {
+            let k = format!("sst_{:08}_{:04}", n, i);
+            writer.put(k.as_bytes(), &v).unwrap();
+        }
+        writer.finish().unwrap();
+        db.ingest_external_file(&ingest_opts, &[path]).unwrap();
+        n += 1;
+    });
+}
@@ -1,8 +1,13 @@
 extern crate test;
 
 extern crate crc;
+extern crate libc;
 extern crate rand;
 extern crate rocksdb;
 extern crate tempfile;
 
+mod bench_callback;
+mod bench_read;
 mod bench_wal;
+mod bench_write;
+mod raw_db;
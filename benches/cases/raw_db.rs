@@ -0,0 +1,145 @@
+// Copyright 2026 TiKV Project Authors. Licensed under Apache-2.0.
+
+//! Fixtures shared by the C API benchmarks. `RawDB` drives `crocksdb_*`
+//! functions directly so their cost can be compared with the Rust wrappers.
+
+use std::ffi::{CStr, CString};
+use std::os::raw::c_char;
+use std::ptr;
+
+use super::rocksdb::crocksdb_ffi::{
+    self, DBCFHandle, DBInstance, DBReadOptions, DBWriteOptions, Options,
+};
+use super::rocksdb::{ColumnFamilyOptions, DBOptions, FlushOptions, WriteOptions, DB};
+use super::tempfile::TempDir;
+
+pub const NUM_KEYS: usize = 10_000;
+pub const VALUE_SIZE: usize = 128;
+
+pub fn key(i: usize) -> Vec<u8> {
+    format!("key_{:08}", i % NUM_KEYS).into_bytes()
+}
+
+pub fn value() -> Vec<u8> {
+    vec![b'v'; VALUE_SIZE]
+}
+
+pub unsafe fn check(err: *mut c_char) {
+    if !err.is_null() {
+        let msg = CStr::from_ptr(err).to_string_lossy().into_owned();
+        crocksdb_ffi::crocksdb_free(err as *mut _);
+        panic!("{}", msg);
+    }
+}
+
+pub struct RawDB {
+    pub db: *mut DBInstance,
+    pub cf: *mut DBCFHandle,
+    pub ropts: *mut DBReadOptions,
+    pub wopts: *mut DBWriteOptions,
+    opts: *mut Options,
+    _dir: TempDir,
+}
+
+impl RawDB {
+    /// Opens a DB through the C API and fills it with `NUM_KEYS` flushed
+    /// keys.
+    pub fn open(name: &str, multi_batch_write: bool) -> RawDB {
+        RawDB::open_with(name, |opts| unsafe {
+            crocksdb_ffi::crocksdb_options_set_enable_multi_batch_write(opts, multi_batch_write);
+        })
+    }
+
+    /// Like `open`, but lets `configure` adjust the options first. Objects
+    /// the options only borrow, such as compaction filters and envs, must
+    /// outlive the returned DB.
+    pub fn open_with<F: FnOnce(*mut Options)>(name: &str, configure: F) -> RawDB {
+        let dir = tempfile::Builder::new().prefix(name).tempdir().unwrap();
+        let path = CString::new(dir.path().to_str().unwrap()).unwrap();
+        let default_cf = CString::new("default").unwrap();
+        unsafe {
+            let opts = crocksdb_ffi::crocksdb_options_create();
+            crocksdb_ffi::crocksdb_options_set_create_if_missing(opts, true);
+            configure(opts);
+            let names = [default_cf.as_ptr()];
+            let cf_opts = [opts as *const Options];
+            let mut cf = ptr::null_mut();
+            let mut err = ptr::null_mut();
+            let db = crocksdb_ffi::crocksdb_open_column_families(
+                opts,
+                path.as_ptr(),
+                1,
+                names.as_ptr(),
+                cf_opts.as_ptr(),
+                &mut cf,
+                &mut err,
+            );
+            check(err);
+            let wopts = crocksdb_ffi::crocksdb_writeoptions_create();
+            crocksdb_ffi::crocksdb_writeoptions_disable_wal(wopts, 1);
+            let raw = RawDB {
+                db,
+                cf,
+                ropts: crocksdb_ffi::crocksdb_readoptions_create(),
+                wopts,
+                opts,
+                _dir: dir,
+            };
+            let v = value();
+            for i in 0..NUM_KEYS {
+                let k = key(i);
+                crocksdb_ffi::crocksdb_put(
+                    raw.db,
+                    raw.wopts,
+                    k.as_ptr(),
+                    k.len(),
+                    v.as_ptr(),
+                    v.len(),
+                    &mut err,
+                );
+                check(err);
+            }
+            let fopts = crocksdb_ffi::crocksdb_flushoptions_create();
+            crocksdb_ffi::crocksdb_flushoptions_set_wait(fopts, true);
+            crocksdb_ffi::crocksdb_flush(raw.db, fopts, &mut err);
+            crocksdb_ffi::crocksdb_flushoptions_destroy(fopts);
+            check(err);
+            raw
+        }
+    }
+}
+
+impl Drop for RawDB {
+    fn drop(&mut self) {
+        unsafe {
+            crocksdb_ffi::crocksdb_column_family_handle_destroy(self.cf);
+            crocksdb_ffi::crocksdb_close(self.db);
+            crocksdb_ffi::crocksdb_readoptions_destroy(self.ropts);
+            crocksdb_ffi::crocksdb_writeoptions_destroy(self.wopts);
+            crocksdb_ffi::crocksdb_options_destroy(self.opts);
+        }
+    }
+}
+
+/// Opens a DB through the Rust wrappers and fills it with `NUM_KEYS` flushed
+/// keys.
+pub fn open_db(name: &str, mut opts: DBOptions, cf_opts: ColumnFamilyOptions) -> (TempDir, DB) {
+    let dir = tempfile::Builder::new().prefix(name).tempdir().unwrap();
+    opts.create_if_missing(true);
+    let db = DB::open_cf(
+        opts,
+        dir.path().to_str().unwrap(),
+        vec![("default", cf_opts)],
+    )
+    .unwrap();
+    let mut wopts = WriteOptions::new();
+    wopts.disable_wal(true);
+    let v = value();
+    for i in 0..NUM_KEYS {
+        db.put_opt(&key(i), &v, &wopts).unwrap();
+    }
+    let mut fopts = FlushOptions::default();
+    fopts.set_wait(true);
+    db.flush(&fopts).unwrap();
+    (dir, db)
+}
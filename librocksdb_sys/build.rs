@@ -18,7 +18,7 @@ extern crate cmake;
 use cc::Build;
 use cmake::Config;
 use std::path::{Path, PathBuf};
-use std::{env, str};
+use std::{env, fs, str};
 
 // On these platforms jemalloc-sys will use a prefixed jemalloc which cannot be linked together
 // with RocksDB.
@@ -125,6 +125,25 @@ fn link_cpp(build: &mut Build) {
     build.cpp_link_stdlib(None);
 }
 
+// Checks the variables set by rocksdb/cmake/modules/Finduring.cmake.
+fn uring_found(build_dir: &str) -> bool {
+    let cache = match fs::read_to_string(format!("{}/CMakeCache.txt", build_dir)) {
+        Ok(cache) => cache,
+        Err(_) => return false,
+    };
+    ["uring_INCLUDE_DIR:", "uring_LIBRARIES:"]
+        .iter()
+        .all(|var| {
+            cache.lines().any(|line| {
+                line.starts_with(var)
+                    && line
+                        .split('=')
+                        .nth(1)
+                        .map_or(false, |v| !v.is_empty() && !v.ends_with("-NOTFOUND"))
+            })
+        })
+}
+
 fn build_rocksdb() -> Build {
     let target = env::var("TARGET").expect("TARGET was not set");
     let target_os = env::var("CARGO_CFG_TARGET_OS").unwrap();
@@ -142,6 +161,9 @@ fn build_rocksdb() -> Build {
     if cfg!(feature = "sse") {
         cfg.define("FORCE_SSE42", "ON");
     }
+    if cfg!(feature = "io_uring") && target_os == "linux" {
+        cfg.define("WITH_LIBURING", "ON");
+    }
     // RocksDB cmake script expect libz.a being under ${DEP_Z_ROOT}/lib, but libz-sys crate put it
     // under ${DEP_Z_ROOT}/build. Append the path to CMAKE_PREFIX_PATH to get around it.
     env::set_var("CMAKE_PREFIX_PATH", {
@@ -170,6 +192,12 @@ fn build_rocksdb() -> Build {
         .very_verbose(true)
         .build();
     let build_dir = format!("{}/build", dst.display());
+    // RocksDB's cmake script silently builds without io_uring if liburing is
+    // missing, so only advertise it to crocksdb if it was found.
+    let io_uring = cfg!(feature = "io_uring") && target_os == "linux" && uring_found(&build_dir);
+    if io_uring {
+        println!("cargo:rustc-link-lib=uring");
+    }
     let mut build = Build::new();
     if target_os == "windows" {
         let profile = match &*env::var("PROFILE").unwrap_or_else(|_| "debug".to_owned()) {
@@ -202,6 +230,9 @@ fn build_rocksdb() -> Build {
     if cfg!(feature = "encryption") {
         build.define("OPENSSL", None);
     }
+    if io_uring {
+        build.define("ROCKSDB_IOURING_PRESENT", None);
+    }
 
     println!("cargo:rustc-link-lib=static=rocksdb");
     println!("cargo:rustc-link-lib=static=titan");
@@ -11,12 +11,27 @@
 
 #include <stdlib.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
 #include <limits>
-
+#include <list>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "cache/cache_key.h"
 #include "db/column_family.h"
+#include "env/composite_env_wrapper.h"
+#include "env/env_encryption_ctr.h"
+#include "file/filename.h"
 #include "file/random_access_file_reader.h"
 #include "file/sequence_file_reader.h"
 #include "file/writable_file_writer.h"
+#include "rocksdb/advanced_cache.h"
 #include "rocksdb/cache.h"
 #include "rocksdb/compaction_filter.h"
 #include "rocksdb/comparator.h"
@@ -38,6 +53,7 @@
 #include "rocksdb/options.h"
 #include "rocksdb/perf_context.h"
 #include "rocksdb/rate_limiter.h"
+#include "rocksdb/secondary_cache.h"
 #include "rocksdb/slice_transform.h"
 #include "rocksdb/sst_dump_tool.h"
 #include "rocksdb/sst_file_reader.h"
@@ -46,24 +62,41 @@
 #include "rocksdb/status.h"
 #include "rocksdb/table.h"
 #include "rocksdb/table_properties.h"
+#include "rocksdb/thread_status.h"
+#include "rocksdb/trace_reader_writer.h"
+#include "rocksdb/trace_record.h"
+#include "rocksdb/trace_record_result.h"
 #include "rocksdb/types.h"
 #include "rocksdb/universal_compaction.h"
 #include "rocksdb/utilities/backup_engine.h"
+#include "rocksdb/utilities/cache_dump_load.h"
 #include "rocksdb/utilities/checkpoint.h"
 #include "rocksdb/utilities/db_ttl.h"
 #include "rocksdb/utilities/debug.h"
 #include "rocksdb/utilities/options_util.h"
+#include "rocksdb/utilities/replayer.h"
 #include "rocksdb/utilities/table_properties_collectors.h"
 #include "rocksdb/write_batch.h"
 #include "rocksdb/write_buffer_manager.h"
 #include "src/blob_format.h"
 #include "table/block_based/block_based_table_factory.h"
+#include "table/block_based/block_based_table_reader.h"
 #include "table/sst_file_writer_collectors.h"
 #include "table/table_reader.h"
 #include "titan/checkpoint.h"
 #include "titan/db.h"
 #include "titan/options.h"
+#include "util/aligned_buffer.h"
 #include "util/coding.h"
+#include "util/math.h"
+
+#ifdef ROCKSDB_IOURING_PRESENT
+#include <liburing.h>
+#endif
+
+#ifdef OPENSSL
+#include "encryption/encryption.h"
+#endif
 
 #if !defined(ROCKSDB_MAJOR) || !defined(ROCKSDB_MINOR) || \
     !defined(ROCKSDB_PATCH)
@@ -78,9 +111,16 @@ using rocksdb::BackgroundErrorReason;
 using rocksdb::BackupEngine;
 using rocksdb::BackupEngineOptions;
 using rocksdb::BackupInfo;
+using rocksdb::BlockAccessCipherStream;
 using rocksdb::BlockBasedTableOptions;
 using rocksdb::BlockCipher;
 using rocksdb::Cache;
+using rocksdb::CacheDumpOptions;
+using rocksdb::CacheDumpReader;
+using rocksdb::CacheDumpWriter;
+using rocksdb::CacheDumpedLoader;
+using rocksdb::CacheDumper;
+using rocksdb::CacheEntryRole;
 using rocksdb::Checkpoint;
 using rocksdb::ColumnFamilyDescriptor;
 using rocksdb::ColumnFamilyHandle;
@@ -91,8 +131,11 @@ using rocksdb::CompactionJobInfo;
 using rocksdb::CompactionOptionsFIFO;
 using rocksdb::CompactRangeOptions;
 using rocksdb::Comparator;
+using rocksdb::CompressedSecondaryCacheOptions;
 using rocksdb::CompressionType;
 using rocksdb::ConfigOptions;
+using rocksdb::CTRCipherStream;
+using rocksdb::CTREncryptionProvider;
 using rocksdb::CuckooTableOptions;
 using rocksdb::DB;
 using rocksdb::DBOptions;
@@ -106,7 +149,10 @@ using rocksdb::EventListener;
 using rocksdb::ExternalFileIngestionInfo;
 using rocksdb::ExternalSstFileInfo;
 using rocksdb::FileLock;
+using rocksdb::FileOperationInfo;
 using rocksdb::FileOptions;
+using rocksdb::FileSystem;
+using rocksdb::FileType;
 using rocksdb::FilterBitsBuilder;
 using rocksdb::FilterBitsReader;
 using rocksdb::FilterBuildingContext;
@@ -114,10 +160,16 @@ using rocksdb::FilterPolicy;
 using rocksdb::FlushJobInfo;
 using rocksdb::FlushOptions;
 using rocksdb::FSRandomAccessFile;
+using rocksdb::FSRandomAccessFileOwnerWrapper;
+using rocksdb::FSReadRequest;
 using rocksdb::HistogramData;
 using rocksdb::HyperClockCacheOptions;
 using rocksdb::InfoLogLevel;
 using rocksdb::IngestExternalFileOptions;
+using rocksdb::IODebugContext;
+using rocksdb::IOHandleDeleter;
+using rocksdb::IOOptions;
+using rocksdb::IOStatus;
 using rocksdb::Iterator;
 using rocksdb::KeyVersion;
 using rocksdb::LiveFileMetaData;
@@ -128,6 +180,8 @@ using rocksdb::MergeInstanceOptions;
 using rocksdb::MergeOperator;
 using rocksdb::NewBloomFilterPolicy;
 using rocksdb::NewEncryptedEnv;
+using rocksdb::NewFileTraceReader;
+using rocksdb::NewFileTraceWriter;
 using rocksdb::NewGenericRateLimiter;
 using rocksdb::NewLRUCache;
 using rocksdb::NewRibbonFilterPolicy;
@@ -142,7 +196,10 @@ using rocksdb::Range;
 using rocksdb::RangePtr;
 using rocksdb::RateLimiter;
 using rocksdb::ReadOptions;
+using rocksdb::ReplayOptions;
+using rocksdb::Replayer;
 using rocksdb::RestoreOptions;
+using rocksdb::SecondaryCache;
 using rocksdb::SequenceNumber;
 using rocksdb::SequentialFile;
 using rocksdb::Slice;
@@ -155,12 +212,23 @@ using rocksdb::SstPartitioner;
 using rocksdb::SstPartitionerFactory;
 using rocksdb::Statistics;
 using rocksdb::Status;
+using rocksdb::SystemClock;
 using rocksdb::SubcompactionJobInfo;
+using rocksdb::TableFileCreationBriefInfo;
+using rocksdb::TableFileCreationInfo;
 using rocksdb::TableFileCreationReason;
+using rocksdb::TableFileDeletionInfo;
 using rocksdb::TableProperties;
 using rocksdb::TablePropertiesCollection;
 using rocksdb::TablePropertiesCollector;
 using rocksdb::TablePropertiesCollectorFactory;
+using rocksdb::ThreadStatus;
+using rocksdb::TraceExecutionResult;
+using rocksdb::TraceOptions;
+using rocksdb::TraceReader;
+using rocksdb::TraceRecordResult;
+using rocksdb::TraceType;
+using rocksdb::TraceWriter;
 using rocksdb::UserCollectedProperties;
 using rocksdb::WALRecoveryMode;
 using rocksdb::WritableFile;
@@ -170,6 +238,7 @@ using rocksdb::WriteOptions;
 using rocksdb::WriteStallCondition;
 using rocksdb::WriteStallInfo;
 
+using rocksdb::BlockBasedTable;
 using rocksdb::BlockBasedTableFactory;
 using rocksdb::BottommostLevelCompaction;
 using rocksdb::ColumnFamilyData;
@@ -179,14 +248,23 @@ using rocksdb::CompactionOptions;
 using rocksdb::CompactionReason;
 using rocksdb::DecodeFixed32;
 using rocksdb::DecodeFixed64;
+using rocksdb::EncodeFixed64;
 using rocksdb::ExternalSstFilePropertyNames;
+using rocksdb::FloorLog2;
+using rocksdb::GetVarint32;
+using rocksdb::GetVarint64;
 using rocksdb::IOStatsContext;
 using rocksdb::LDBTool;
 using rocksdb::LevelMetaData;
 using rocksdb::MemoryAllocator;
+using rocksdb::OffsetableCacheKey;
 using rocksdb::PerfContext;
 using rocksdb::PerfLevel;
 using rocksdb::PutFixed64;
+using rocksdb::PutVarint32;
+using rocksdb::PutVarint32Varint32;
+using rocksdb::PutVarint64;
+using rocksdb::PutVarint64Varint64;
 using rocksdb::RandomAccessFile;
 using rocksdb::RandomAccessFileReader;
 using rocksdb::RandomRWFile;
@@ -209,6 +287,7 @@ using rocksdb::titandb::TitanReadOptions;
 using TitanCheckpoint = rocksdb::titandb::Checkpoint;
 
 #ifdef OPENSSL
+using rocksdb::encryption::AESEncryptionProvider;
 using rocksdb::encryption::EncryptionMethod;
 using rocksdb::encryption::FileEncryptionInfo;
 using rocksdb::encryption::KeyManager;
@@ -268,6 +347,8 @@ struct crocksdb_readoptions_t {
   ReadOptions rep;
   Slice upper_bound;  // stack variable to set pointer to in ReadOptions
   Slice lower_bound;
+  Slice timestamp;
+  Slice iter_start_ts;
 };
 struct crocksdb_writeoptions_t {
   WriteOptions rep;
@@ -348,6 +429,12 @@ struct crocksdb_hyper_clock_cache_options_t {
 struct crocksdb_cache_t {
   shared_ptr<Cache> rep;
 };
+class CountingSecondaryCache;
+struct crocksdb_secondary_cache_t {
+  shared_ptr<SecondaryCache> rep;
+  // Owned by `rep`.
+  CountingSecondaryCache* counting;
+};
 struct crocksdb_memory_allocator_t {
   shared_ptr<MemoryAllocator> rep;
 };
@@ -386,6 +473,9 @@ struct crocksdb_concurrent_task_limiter_t {
 };
 struct crocksdb_statistics_t {
   std::shared_ptr<Statistics> rep;
+  // Tickers and histograms `rep` knows about.
+  uint32_t num_tickers = rocksdb::TICKER_ENUM_MAX;
+  uint32_t num_histograms = rocksdb::HISTOGRAM_ENUM_MAX;
 };
 struct crocksdb_histogramdata_t {
   HistogramData rep;
@@ -419,6 +509,12 @@ struct crocksdb_keyversions_t {
   std::vector<KeyVersion> rep;
 };
 
+struct crocksdb_split_keys_t {
+  std::vector<std::string> keys;
+  uint64_t sst_size = 0;
+  uint64_t memtable_size = 0;
+};
+
 struct crocksdb_compactionfiltercontext_t {
   CompactionFilter::Context rep;
 };
@@ -510,6 +606,9 @@ struct crocksdb_compactionfilterfactory_t : public CompactionFilterFactory {
 };
 
 struct crocksdb_comparator_t : public Comparator {
+  crocksdb_comparator_t() = default;
+  explicit crocksdb_comparator_t(size_t ts_sz) : Comparator(ts_sz) {}
+
   void* state_;
   void (*destructor_)(void*);
   int (*compare_)(void*, const char* a, size_t alen, const char* b,
@@ -629,6 +728,8 @@ struct crocksdb_env_t {
   bool is_default;
   std::shared_ptr<EncryptionProvider> encryption_provider;
   std::shared_ptr<BlockCipher> block_cipher;
+  // The env `rep` wraps, if it owns one.
+  std::unique_ptr<Env> wrapped;
 };
 
 struct crocksdb_slicetransform_t : public SliceTransform {
@@ -742,6 +843,248 @@ static char* CopyString(const std::string& str) {
   return result;
 }
 
+/* op tracing */
+
+// Latencies of sampled operations are recorded into histograms owned by the
+// calling thread, so recording never contends with other threads. Readers
+// merge the histograms of all live threads with those of exited threads.
+struct OpLatencyHistogram {
+  void Add(uint64_t nanos, const uint64_t* perf) {
+    count.fetch_add(1, std::memory_order_relaxed);
+    total_nanos.fetch_add(nanos, std::memory_order_relaxed);
+    uint64_t max = max_nanos.load(std::memory_order_relaxed);
+    while (nanos > max && !max_nanos.compare_exchange_weak(
+                              max, nanos, std::memory_order_relaxed)) {
+    }
+    for (size_t i = 0; i < kNumPerfCounters; i++) {
+      perf_counters[i].fetch_add(perf[i], std::memory_order_relaxed);
+    }
+    buckets[Bucket(nanos)].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void MergeInto(crocksdb_op_latency_t* out) const {
+    crocksdb_op_latency_t h;
+    h.count = count.load(std::memory_order_relaxed);
+    h.total_nanos = total_nanos.load(std::memory_order_relaxed);
+    h.max_nanos = max_nanos.load(std::memory_order_relaxed);
+    h.block_cache_hit_count =
+        perf_counters[0].load(std::memory_order_relaxed);
+    h.block_read_count = perf_counters[1].load(std::memory_order_relaxed);
+    h.block_read_byte = perf_counters[2].load(std::memory_order_relaxed);
+    h.internal_key_skipped_count =
+        perf_counters[3].load(std::memory_order_relaxed);
+    h.internal_delete_skipped_count =
+        perf_counters[4].load(std::memory_order_relaxed);
+    for (size_t i = 0; i < crocksdb_op_latency_buckets; i++) {
+      h.buckets[i] = buckets[i].load(std::memory_order_relaxed);
+    }
+    crocksdb_op_latency_merge(out, &h);
+  }
+
+  void Reset() {
+    count.store(0, std::memory_order_relaxed);
+    total_nanos.store(0, std::memory_order_relaxed);
+    max_nanos.store(0, std::memory_order_relaxed);
+    for (auto& c : perf_counters) {
+      c.store(0, std::memory_order_relaxed);
+    }
+    for (auto& b : buckets) {
+      b.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  static size_t Bucket(uint64_t nanos) {
+    static constexpr int kSubBits = crocksdb_op_latency_sub_bucket_bits;
+    if (nanos < (uint64_t{1} << kSubBits)) {
+      return static_cast<size_t>(nanos);
+    }
+    int msb = FloorLog2(nanos);
+    size_t sub = static_cast<size_t>(nanos >> (msb - kSubBits)) &
+                 ((size_t{1} << kSubBits) - 1);
+    size_t bucket = (static_cast<size_t>(msb - kSubBits + 1) << kSubBits) + sub;
+    return std::min(bucket, size_t{crocksdb_op_latency_buckets - 1});
+  }
+
+  static constexpr size_t kNumPerfCounters = 5;
+  std::atomic<uint64_t> count{0};
+  std::atomic<uint64_t> total_nanos{0};
+  std::atomic<uint64_t> max_nanos{0};
+  std::atomic<uint64_t> perf_counters[kNumPerfCounters] = {};
+  std::atomic<uint64_t> buckets[crocksdb_op_latency_buckets] = {};
+};
+
+struct ThreadOpLatency {
+  OpLatencyHistogram ops[crocksdb_traced_op_count];
+};
+
+struct OpTraceRegistry {
+  std::mutex mu;
+  std::unordered_set<ThreadOpLatency*> threads;
+  // Merged histograms of threads that have exited.
+  crocksdb_op_latency_t retired[crocksdb_traced_op_count] = {};
+};
+
+static std::atomic<uint32_t> op_trace_sample_every{0};
+
+static OpTraceRegistry* GetOpTraceRegistry() {
+  // Leaked so that threads exiting during shutdown can still retire their
+  // histograms.
+  static OpTraceRegistry* registry = new OpTraceRegistry;
+  return registry;
+}
+
+struct ThreadOpLatencyHolder {
+  ThreadOpLatencyHolder() {
+    OpTraceRegistry* registry = GetOpTraceRegistry();
+    std::lock_guard<std::mutex> lock(registry->mu);
+    registry->threads.insert(&rep);
+  }
+
+  ~ThreadOpLatencyHolder() {
+    OpTraceRegistry* registry = GetOpTraceRegistry();
+    std::lock_guard<std::mutex> lock(registry->mu);
+    registry->threads.erase(&rep);
+    for (int op = 0; op < crocksdb_traced_op_count; op++) {
+      rep.ops[op].MergeInto(&registry->retired[op]);
+    }
+  }
+
+  ThreadOpLatency rep;
+};
+
+static thread_local uint32_t op_trace_countdown = 0;
+
+// Times the enclosing operation if it is sampled. An operation that is not
+// sampled costs a relaxed load and, while tracing is enabled, a thread-local
+// decrement.
+class OpTraceScope {
+ public:
+  explicit OpTraceScope(int op) : op_(op) {
+    uint32_t every = op_trace_sample_every.load(std::memory_order_relaxed);
+    if (every == 0) {
+      return;
+    }
+    if (op_trace_countdown > 0 && op_trace_countdown < every) {
+      op_trace_countdown--;
+      return;
+    }
+    op_trace_countdown = every - 1;
+    sampled_ = true;
+    saved_level_ = rocksdb::GetPerfLevel();
+    if (saved_level_ < PerfLevel::kEnableCount) {
+      rocksdb::SetPerfLevel(PerfLevel::kEnableCount);
+    }
+    ReadPerf(perf_);
+    start_nanos_ = SystemClock::Default()->NowNanos();
+  }
+
+  ~OpTraceScope() {
+    if (!sampled_) {
+      return;
+    }
+    uint64_t nanos = SystemClock::Default()->NowNanos() - start_nanos_;
+    uint64_t perf[OpLatencyHistogram::kNumPerfCounters];
+    ReadPerf(perf);
+    for (size_t i = 0; i < OpLatencyHistogram::kNumPerfCounters; i++) {
+      perf[i] -= perf_[i];
+    }
+    if (saved_level_ < PerfLevel::kEnableCount) {
+      rocksdb::SetPerfLevel(saved_level_);
+    }
+    static thread_local ThreadOpLatencyHolder holder;
+    holder.rep.ops[op_].Add(nanos, perf);
+  }
+
+ private:
+  static void ReadPerf(uint64_t* perf) {
+    const PerfContext* pc = rocksdb::get_perf_context();
+    perf[0] = pc->block_cache_hit_count;
+    perf[1] = pc->block_read_count;
+    perf[2] = pc->block_read_byte;
+    perf[3] = pc->internal_key_skipped_count;
+    perf[4] = pc->internal_delete_skipped_count;
+  }
+
+  const int op_;
+  bool sampled_ = false;
+  PerfLevel saved_level_ = PerfLevel::kUninitialized;
+  uint64_t start_nanos_ = 0;
+  uint64_t perf_[OpLatencyHistogram::kNumPerfCounters] = {};
+};
+
+void crocksdb_op_tracing_set_sample_every(uint32_t every) {
+  op_trace_sample_every.store(every, std::memory_order_relaxed);
+}
+
+uint32_t crocksdb_op_tracing_sample_every() {
+  return op_trace_sample_every.load(std::memory_order_relaxed);
+}
+
+void crocksdb_op_tracing_get(int op, crocksdb_op_latency_t* latency) {
+  memset(latency, 0, sizeof(*latency));
+  OpTraceRegistry* registry = GetOpTraceRegistry();
+  std::lock_guard<std::mutex> lock(registry->mu);
+  crocksdb_op_latency_merge(latency, &registry->retired[op]);
+  for (ThreadOpLatency* t : registry->threads) {
+    t->ops[op].MergeInto(latency);
+  }
+}
+
+void crocksdb_op_tracing_reset() {
+  OpTraceRegistry* registry = GetOpTraceRegistry();
+  std::lock_guard<std::mutex> lock(registry->mu);
+  memset(registry->retired, 0, sizeof(registry->retired));
+  for (ThreadOpLatency* t : registry->threads) {
+    for (auto& h : t->ops) {
+      h.Reset();
+    }
+  }
+}
+
+void crocksdb_op_latency_merge(crocksdb_op_latency_t* dst,
+                               const crocksdb_op_latency_t* src) {
+  dst->count += src->count;
+  dst->total_nanos += src->total_nanos;
+  dst->max_nanos = std::max(dst->max_nanos, src->max_nanos);
+  dst->block_cache_hit_count += src->block_cache_hit_count;
+  dst->block_read_count += src->block_read_count;
+  dst->block_read_byte += src->block_read_byte;
+  dst->internal_key_skipped_count += src->internal_key_skipped_count;
+  dst->internal_delete_skipped_count += src->internal_delete_skipped_count;
+  for (size_t i = 0; i < crocksdb_op_latency_buckets; i++) {
+    dst->buckets[i] += src->buckets[i];
+  }
+}
+
+uint64_t crocksdb_op_latency_bucket_lower_nanos(size_t bucket) {
+  static constexpr int kSubBits = crocksdb_op_latency_sub_bucket_bits;
+  if (bucket < (size_t{1} << kSubBits)) {
+    return bucket;
+  }
+  int shift = static_cast<int>(bucket >> kSubBits) - 1;
+  uint64_t sub = bucket & ((size_t{1} << kSubBits) - 1);
+  return ((uint64_t{1} << kSubBits) + sub) << shift;
+}
+
+uint64_t crocksdb_op_latency_percentile_nanos(
+    const crocksdb_op_latency_t* latency, double p) {
+  if (latency->count == 0) {
+    return 0;
+  }
+  double target = std::ceil(static_cast<double>(latency->count) * p / 100.0);
+  uint64_t rank = std::max<uint64_t>(static_cast<uint64_t>(target), 1);
+  uint64_t seen = 0;
+  for (size_t i = 0; i + 1 < crocksdb_op_latency_buckets; i++) {
+    seen += latency->buckets[i];
+    if (seen >= rank) {
+      // Report the bucket's upper bound, which never exceeds the maximum.
+      return std::min(crocksdb_op_latency_bucket_lower_nanos(i + 1) - 1,
+                      latency->max_nanos);
+    }
+  }
+  return latency->max_nanos;
+}
+
 crocksdb_t* crocksdb_open(const crocksdb_options_t* options, const char* name,
                           char** errptr) {
   DB* db;
@@ -1136,6 +1479,66 @@ void crocksdb_delete_range_cf(crocksdb_t* db,
                                          Slice(end_key, end_keylen)));
 }
 
+void crocksdb_put_cf_with_ts(crocksdb_t* db,
+                             const crocksdb_writeoptions_t* options,
+                             crocksdb_column_family_handle_t* column_family,
+                             const char* key, size_t keylen, const char* ts,
+                             size_t tslen, const char* val, size_t vallen,
+                             char** errptr) {
+  SaveError(errptr,
+            db->rep->Put(options->rep, column_family->rep, Slice(key, keylen),
+                         Slice(ts, tslen), Slice(val, vallen)));
+}
+
+void crocksdb_delete_cf_with_ts(crocksdb_t* db,
+                                const crocksdb_writeoptions_t* options,
+                                crocksdb_column_family_handle_t* column_family,
+                                const char* key, size_t keylen, const char* ts,
+                                size_t tslen, char** errptr) {
+  SaveError(errptr, db->rep->Delete(options->rep, column_family->rep,
+                                    Slice(key, keylen), Slice(ts, tslen)));
+}
+
+void crocksdb_single_delete_cf_with_ts(
+    crocksdb_t* db, const crocksdb_writeoptions_t* options,
+    crocksdb_column_family_handle_t* column_family, const char* key,
+    size_t keylen, const char* ts, size_t tslen, char** errptr) {
+  SaveError(errptr, db->rep->SingleDelete(options->rep, column_family->rep,
+                                          Slice(key, keylen), Slice(ts, tslen)));
+}
+
+void crocksdb_delete_range_cf_with_ts(
+    crocksdb_t* db, const crocksdb_writeoptions_t* options,
+    crocksdb_column_family_handle_t* column_family, const char* begin_key,
+    size_t begin_keylen, const char* end_key, size_t end_keylen, const char* ts,
+    size_t tslen, char** errptr) {
+  SaveError(errptr,
+            db->rep->DeleteRange(options->rep, column_family->rep,
+                                 Slice(begin_key, begin_keylen),
+                                 Slice(end_key, end_keylen), Slice(ts, tslen)));
+}
+
+void crocksdb_increase_full_history_ts_low(
+    crocksdb_t* db, crocksdb_column_family_handle_t* column_family,
+    const char* ts_low, size_t ts_lowlen, char** errptr) {
+  SaveError(errptr, db->rep->IncreaseFullHistoryTsLow(
+                        column_family->rep, std::string(ts_low, ts_lowlen)));
+}
+
+char* crocksdb_get_full_history_ts_low(
+    crocksdb_t* db, crocksdb_column_family_handle_t* column_family,
+    size_t* ts_lowlen, char** errptr) {
+  std::string ts_low;
+  Status s = db->rep->GetFullHistoryTsLow(column_family->rep, &ts_low);
+  if (!s.ok()) {
+    *ts_lowlen = 0;
+    SaveError(errptr, s);
+    return nullptr;
+  }
+  *ts_lowlen = ts_low.size();
+  return CopyString(ts_low);
+}
+
 void crocksdb_merge(crocksdb_t* db, const crocksdb_writeoptions_t* options,
                     const char* key, size_t keylen, const char* val,
                     size_t vallen, char** errptr) {
@@ -1153,6 +1556,7 @@ void crocksdb_merge_cf(crocksdb_t* db, const crocksdb_writeoptions_t* options,
 
 void crocksdb_write(crocksdb_t* db, const crocksdb_writeoptions_t* options,
                     crocksdb_writebatch_t* batch, char** errptr) {
+  OpTraceScope trace(crocksdb_traced_op_write);
   SaveError(errptr, db->rep->Write(options->rep, &batch->rep));
 }
 
@@ -1161,6 +1565,7 @@ void crocksdb_write_callback(crocksdb_t* db,
                              crocksdb_writebatch_t* batch,
                              crocksdb_post_write_callback_t* callback,
                              char** errptr) {
+  OpTraceScope trace(crocksdb_traced_op_write);
   SaveError(errptr, db->rep->Write(options->rep, &batch->rep, callback));
 }
 
@@ -1168,6 +1573,7 @@ void crocksdb_write_multi_batch(crocksdb_t* db,
                                 const crocksdb_writeoptions_t* options,
                                 crocksdb_writebatch_t** batches,
                                 size_t batch_size, char** errptr) {
+  OpTraceScope trace(crocksdb_traced_op_write);
   std::vector<WriteBatch*> ws;
   for (size_t i = 0; i < batch_size; i++) {
     ws.push_back(&batches[i]->rep);
@@ -1180,6 +1586,7 @@ void crocksdb_write_multi_batch_callback(
     crocksdb_t* db, const crocksdb_writeoptions_t* options,
     crocksdb_writebatch_t** batches, size_t batch_size,
     crocksdb_post_write_callback_t* callback, char** errptr) {
+  OpTraceScope trace(crocksdb_traced_op_write);
   std::vector<WriteBatch*> ws;
   for (size_t i = 0; i < batch_size; i++) {
     ws.push_back(&batches[i]->rep);
@@ -1191,6 +1598,7 @@ void crocksdb_write_multi_batch_callback(
 char* crocksdb_get(crocksdb_t* db, const crocksdb_readoptions_t* options,
                    const char* key, size_t keylen, size_t* vallen,
                    char** errptr) {
+  OpTraceScope trace(crocksdb_traced_op_get);
   char* result = nullptr;
   std::string tmp;
   Status s = db->rep->Get(options->rep, Slice(key, keylen), &tmp);
@@ -1210,6 +1618,7 @@ char* crocksdb_get_cf(crocksdb_t* db, const crocksdb_readoptions_t* options,
                       crocksdb_column_family_handle_t* column_family,
                       const char* key, size_t keylen, size_t* vallen,
                       char** errptr) {
+  OpTraceScope trace(crocksdb_traced_op_get);
   char* result = nullptr;
   std::string tmp;
   Status s =
@@ -1226,19 +1635,25 @@ char* crocksdb_get_cf(crocksdb_t* db, const crocksdb_readoptions_t* options,
   return result;
 }
 
-void crocksdb_multi_get(crocksdb_t* db, const crocksdb_readoptions_t* options,
-                        size_t num_keys, const char* const* keys_list,
-                        const size_t* keys_list_sizes, char** values_list,
-                        size_t* values_list_sizes, char** errs) {
+// Uses the batched MultiGet, which reads the blocks the keys need from each
+// file with one MultiRead, rather than looking the keys up one by one.
+static void MultiGetBatched(crocksdb_t* db,
+                            const crocksdb_readoptions_t* options,
+                            ColumnFamilyHandle** column_families,
+                            size_t num_keys, const char* const* keys_list,
+                            const size_t* keys_list_sizes, char** values_list,
+                            size_t* values_list_sizes, char** errs) {
   std::vector<Slice> keys(num_keys);
   for (size_t i = 0; i < num_keys; i++) {
     keys[i] = Slice(keys_list[i], keys_list_sizes[i]);
   }
-  std::vector<std::string> values(num_keys);
-  std::vector<Status> statuses = db->rep->MultiGet(options->rep, keys, &values);
+  std::vector<PinnableSlice> values(num_keys);
+  std::vector<Status> statuses(num_keys);
+  db->rep->MultiGet(options->rep, num_keys, column_families, keys.data(),
+                    values.data(), statuses.data());
   for (size_t i = 0; i < num_keys; i++) {
     if (statuses[i].ok()) {
-      values_list[i] = CopyString(values[i]);
+      values_list[i] = CopyString(values[i].ToString());
       values_list_sizes[i] = values[i].size();
       errs[i] = nullptr;
     } else {
@@ -1253,36 +1668,30 @@ void crocksdb_multi_get(crocksdb_t* db, const crocksdb_readoptions_t* options,
   }
 }
 
+void crocksdb_multi_get(crocksdb_t* db, const crocksdb_readoptions_t* options,
+                        size_t num_keys, const char* const* keys_list,
+                        const size_t* keys_list_sizes, char** values_list,
+                        size_t* values_list_sizes, char** errs) {
+  OpTraceScope trace(crocksdb_traced_op_multi_get);
+  std::vector<ColumnFamilyHandle*> cfs(num_keys,
+                                       db->rep->DefaultColumnFamily());
+  MultiGetBatched(db, options, cfs.data(), num_keys, keys_list,
+                  keys_list_sizes, values_list, values_list_sizes, errs);
+}
+
 void crocksdb_multi_get_cf(
     crocksdb_t* db, const crocksdb_readoptions_t* options,
     const crocksdb_column_family_handle_t* const* column_families,
     size_t num_keys, const char* const* keys_list,
     const size_t* keys_list_sizes, char** values_list,
     size_t* values_list_sizes, char** errs) {
-  std::vector<Slice> keys(num_keys);
+  OpTraceScope trace(crocksdb_traced_op_multi_get);
   std::vector<ColumnFamilyHandle*> cfs(num_keys);
   for (size_t i = 0; i < num_keys; i++) {
-    keys[i] = Slice(keys_list[i], keys_list_sizes[i]);
     cfs[i] = column_families[i]->rep;
   }
-  std::vector<std::string> values(num_keys);
-  std::vector<Status> statuses =
-      db->rep->MultiGet(options->rep, cfs, keys, &values);
-  for (size_t i = 0; i < num_keys; i++) {
-    if (statuses[i].ok()) {
-      values_list[i] = CopyString(values[i]);
-      values_list_sizes[i] = values[i].size();
-      errs[i] = nullptr;
-    } else {
-      values_list[i] = nullptr;
-      values_list_sizes[i] = 0;
-      if (!statuses[i].IsNotFound()) {
-        errs[i] = strdup(statuses[i].ToString().c_str());
-      } else {
-        errs[i] = nullptr;
-      }
-    }
-  }
+  MultiGetBatched(db, options, cfs.data(), num_keys, keys_list,
+                  keys_list_sizes, values_list, values_list_sizes, errs);
 }
 
 crocksdb_iterator_t* crocksdb_create_iterator(
@@ -1622,25 +2031,35 @@ unsigned char crocksdb_iter_valid(const crocksdb_iterator_t* iter) {
 }
 
 void crocksdb_iter_seek_to_first(crocksdb_iterator_t* iter) {
+  OpTraceScope trace(crocksdb_traced_op_iter_seek);
   iter->rep->SeekToFirst();
 }
 
 void crocksdb_iter_seek_to_last(crocksdb_iterator_t* iter) {
+  OpTraceScope trace(crocksdb_traced_op_iter_seek);
   iter->rep->SeekToLast();
 }
 
 void crocksdb_iter_seek(crocksdb_iterator_t* iter, const char* k, size_t klen) {
+  OpTraceScope trace(crocksdb_traced_op_iter_seek);
   iter->rep->Seek(Slice(k, klen));
 }
 
 void crocksdb_iter_seek_for_prev(crocksdb_iterator_t* iter, const char* k,
                                  size_t klen) {
+  OpTraceScope trace(crocksdb_traced_op_iter_seek);
   iter->rep->SeekForPrev(Slice(k, klen));
 }
 
-void crocksdb_iter_next(crocksdb_iterator_t* iter) { iter->rep->Next(); }
+void crocksdb_iter_next(crocksdb_iterator_t* iter) {
+  OpTraceScope trace(crocksdb_traced_op_iter_next);
+  iter->rep->Next();
+}
 
-void crocksdb_iter_prev(crocksdb_iterator_t* iter) { iter->rep->Prev(); }
+void crocksdb_iter_prev(crocksdb_iterator_t* iter) {
+  OpTraceScope trace(crocksdb_traced_op_iter_next);
+  iter->rep->Prev();
+}
 
 const char* crocksdb_iter_key(const crocksdb_iterator_t* iter, size_t* klen) {
   Slice s = iter->rep->key();
@@ -1654,6 +2073,13 @@ const char* crocksdb_iter_value(const crocksdb_iterator_t* iter, size_t* vlen) {
   return s.data();
 }
 
+const char* crocksdb_iter_timestamp(const crocksdb_iterator_t* iter,
+                                    size_t* tslen) {
+  Slice s = iter->rep->timestamp();
+  *tslen = s.size();
+  return s.data();
+}
+
 void crocksdb_iter_get_error(const crocksdb_iterator_t* iter, char** errptr) {
   SaveError(errptr, iter->rep->status());
 }
@@ -1787,6 +2213,30 @@ void crocksdb_writebatch_delete_cf(
   b->rep.Delete(column_family->rep, Slice(key, klen));
 }
 
+void crocksdb_writebatch_put_cf_with_ts(
+    crocksdb_writebatch_t* b, crocksdb_column_family_handle_t* column_family,
+    const char* key, size_t klen, const char* ts, size_t tslen,
+    const char* val, size_t vlen, char** errptr) {
+  SaveError(errptr, b->rep.Put(column_family->rep, Slice(key, klen),
+                               Slice(ts, tslen), Slice(val, vlen)));
+}
+
+void crocksdb_writebatch_delete_cf_with_ts(
+    crocksdb_writebatch_t* b, crocksdb_column_family_handle_t* column_family,
+    const char* key, size_t klen, const char* ts, size_t tslen,
+    char** errptr) {
+  SaveError(errptr, b->rep.Delete(column_family->rep, Slice(key, klen),
+                                  Slice(ts, tslen)));
+}
+
+void crocksdb_writebatch_single_delete_cf_with_ts(
+    crocksdb_writebatch_t* b, crocksdb_column_family_handle_t* column_family,
+    const char* key, size_t klen, const char* ts, size_t tslen,
+    char** errptr) {
+  SaveError(errptr, b->rep.SingleDelete(column_family->rep, Slice(key, klen),
+                                        Slice(ts, tslen)));
+}
+
 void crocksdb_writebatch_single_delete(crocksdb_writebatch_t* b,
                                        const char* key, size_t klen) {
   b->rep.SingleDelete(Slice(key, klen));
@@ -2563,114 +3013,745 @@ void crocksdb_options_add_eventlistener(crocksdb_options_t* opt,
   opt->rep.listeners.emplace_back(std::shared_ptr<EventListener>(t));
 }
 
-crocksdb_cuckoo_table_options_t* crocksdb_cuckoo_options_create() {
-  return new crocksdb_cuckoo_table_options_t;
-}
+/* event ring */
 
-void crocksdb_cuckoo_options_destroy(crocksdb_cuckoo_table_options_t* options) {
-  delete options;
-}
+// Bounded multi-producer queue of event records (Vyukov's MPMC queue), filled
+// by background threads and drained by the host. A full queue drops records
+// instead of blocking.
+struct crocksdb_event_ring_t {
+  struct Rep {
+    struct Slot {
+      std::atomic<size_t> seq;
+      crocksdb_event_record_t record;
+    };
 
-void crocksdb_cuckoo_options_set_hash_ratio(
-    crocksdb_cuckoo_table_options_t* options, double v) {
-  options->rep.hash_table_ratio = v;
-}
+    explicit Rep(size_t capacity)
+        : mask(capacity - 1), slots(new Slot[capacity]) {
+      for (size_t i = 0; i < capacity; i++) {
+        slots[i].seq.store(i, std::memory_order_relaxed);
+      }
+    }
 
-void crocksdb_cuckoo_options_set_max_search_depth(
-    crocksdb_cuckoo_table_options_t* options, uint32_t v) {
-  options->rep.max_search_depth = v;
-}
+    void Push(const crocksdb_event_record_t& record) {
+      size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+      for (;;) {
+        Slot& slot = slots[pos & mask];
+        size_t seq = slot.seq.load(std::memory_order_acquire);
+        auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+          if (enqueue_pos.compare_exchange_weak(pos, pos + 1,
+                                                std::memory_order_relaxed)) {
+            slot.record = record;
+            slot.seq.store(pos + 1, std::memory_order_release);
+            return;
+          }
+        } else if (diff < 0) {
+          dropped.fetch_add(1, std::memory_order_relaxed);
+          return;
+        } else {
+          pos = enqueue_pos.load(std::memory_order_relaxed);
+        }
+      }
+    }
 
-void crocksdb_cuckoo_options_set_cuckoo_block_size(
-    crocksdb_cuckoo_table_options_t* options, uint32_t v) {
-  options->rep.cuckoo_block_size = v;
-}
+    bool Pop(crocksdb_event_record_t* record) {
+      size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+      for (;;) {
+        Slot& slot = slots[pos & mask];
+        size_t seq = slot.seq.load(std::memory_order_acquire);
+        auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+        if (diff == 0) {
+          if (dequeue_pos.compare_exchange_weak(pos, pos + 1,
+                                                std::memory_order_relaxed)) {
+            *record = slot.record;
+            slot.seq.store(pos + mask + 1, std::memory_order_release);
+            return true;
+          }
+        } else if (diff < 0) {
+          return false;
+        } else {
+          pos = dequeue_pos.load(std::memory_order_relaxed);
+        }
+      }
+    }
 
-void crocksdb_cuckoo_options_set_identity_as_first_hash(
-    crocksdb_cuckoo_table_options_t* options, unsigned char v) {
-  options->rep.identity_as_first_hash = v;
-}
+    const size_t mask;
+    std::unique_ptr<Slot[]> slots;
+    std::atomic<size_t> enqueue_pos{0};
+    std::atomic<size_t> dequeue_pos{0};
+    std::atomic<uint64_t> dropped{0};
+  };
+  std::shared_ptr<Rep> rep;
+};
 
-void crocksdb_cuckoo_options_set_use_module_hash(
-    crocksdb_cuckoo_table_options_t* options, unsigned char v) {
-  options->rep.use_module_hash = v;
-}
+class EventRingListener : public EventListener {
+ public:
+  explicit EventRingListener(std::shared_ptr<crocksdb_event_ring_t::Rep> ring)
+      : ring_(std::move(ring)) {}
 
-void crocksdb_options_set_cuckoo_table_factory(
-    crocksdb_options_t* opt, crocksdb_cuckoo_table_options_t* table_options) {
-  if (table_options) {
-    opt->rep.table_factory.reset(
-        rocksdb::NewCuckooTableFactory(table_options->rep));
+  const char* Name() const override { return "crocksdb.EventRingListener"; }
+
+  void OnFlushBegin(DB* db, const FlushJobInfo& info) override {
+    FlushStart* slot = FindFlushStart(db, info);
+    if (slot == nullptr) {
+      slot = &flush_starts_[flush_start_next_++ % kFlushStartSlots];
+    }
+    slot->db = db;
+    slot->job_id = info.job_id;
+    slot->cf_id = info.cf_id;
+    slot->micros = SystemClock::Default()->NowMicros();
   }
-}
 
-crocksdb_options_t* crocksdb_options_create() { return new crocksdb_options_t; }
+  void OnFlushCompleted(DB* db, const FlushJobInfo& info) override {
+    crocksdb_event_record_t r = NewRecord(crocksdb_event_flush_completed);
+    FlushStart* slot = FindFlushStart(db, info);
+    if (slot != nullptr) {
+      r.elapsed_micros = SystemClock::Default()->NowMicros() - slot->micros;
+    }
+    r.job_id = info.job_id;
+    r.file_number = info.file_number;
+    r.output_bytes = TableSize(info.table_properties);
+    r.num_output_files = 1;
+    r.reason = static_cast<int32_t>(info.flush_reason);
+    r.output_level = 0;
+    SetCfName(&r, info.cf_name);
+    SetPath(&r, info.file_path);
+    ring_->Push(r);
+  }
+
+  void OnCompactionCompleted(DB* /*db*/,
+                             const CompactionJobInfo& info) override {
+    crocksdb_event_record_t r = NewRecord(crocksdb_event_compaction_completed);
+    r.job_id = info.job_id;
+    r.input_bytes = info.stats.total_input_bytes;
+    r.output_bytes = info.stats.total_output_bytes;
+    r.num_input_files = info.input_files.size();
+    r.num_output_files = info.output_files.size();
+    r.elapsed_micros = info.stats.elapsed_micros;
+    r.reason = static_cast<int32_t>(info.compaction_reason);
+    r.status_code = static_cast<int32_t>(info.status.code());
+    r.input_level = info.base_input_level;
+    r.output_level = info.output_level;
+    SetCfName(&r, info.cf_name);
+    if (!info.output_files.empty()) {
+      SetPath(&r, info.output_files.front());
+    }
+    ring_->Push(r);
+  }
 
-crocksdb_options_t* crocksdb_options_copy(const crocksdb_options_t* other) {
-  return new crocksdb_options_t{Options(other->rep)};
-}
+  void OnExternalFileIngested(DB* /*db*/,
+                              const ExternalFileIngestionInfo& info) override {
+    crocksdb_event_record_t r =
+        NewRecord(crocksdb_event_external_file_ingested);
+    r.file_number = rocksdb::TableFileNameToNumber(info.internal_file_path);
+    r.output_bytes = TableSize(info.table_properties);
+    r.num_output_files = 1;
+    r.output_level = info.picked_level;
+    SetCfName(&r, info.cf_name);
+    SetPath(&r, info.internal_file_path);
+    ring_->Push(r);
+  }
 
-void crocksdb_options_destroy(crocksdb_options_t* options) { delete options; }
+  void OnStallConditionsChanged(const WriteStallInfo& info) override {
+    crocksdb_event_record_t r =
+        NewRecord(crocksdb_event_stall_conditions_changed);
+    r.reason = static_cast<int32_t>(info.condition.cur);
+    r.prev_reason = static_cast<int32_t>(info.condition.prev);
+    SetCfName(&r, info.cf_name);
+    ring_->Push(r);
+  }
 
-void crocksdb_column_family_descriptor_destroy(
-    crocksdb_column_family_descriptor* cf_desc) {
-  delete cf_desc;
-}
+  void OnBackgroundError(BackgroundErrorReason reason,
+                         Status* status) override {
+    crocksdb_event_record_t r = NewRecord(crocksdb_event_background_error);
+    r.reason = static_cast<int32_t>(reason);
+    r.status_code = static_cast<int32_t>(status->code());
+    ring_->Push(r);
+  }
 
-const char* crocksdb_name_from_column_family_descriptor(
-    const crocksdb_column_family_descriptor* cf_desc) {
-  return cf_desc->rep.name.c_str();
-}
+ private:
+  // Start of a flush, recorded by the flush thread. An atomic flush gives all
+  // its column families the same job id, and reports them all as begun before
+  // completing any.
+  struct FlushStart {
+    const DB* db = nullptr;
+    int job_id = 0;
+    uint32_t cf_id = 0;
+    uint64_t micros = 0;
+  };
+  static constexpr size_t kFlushStartSlots = 16;
+
+  // A flush begins and completes on the same thread, so the starts need no
+  // lock. Slots are reused round-robin, which also drops the starts of
+  // failed flushes; a completion whose start was reused reports 0.
+  static thread_local FlushStart flush_starts_[kFlushStartSlots];
+  static thread_local size_t flush_start_next_;
+
+  static FlushStart* FindFlushStart(const DB* db, const FlushJobInfo& info) {
+    for (FlushStart& slot : flush_starts_) {
+      if (slot.db == db && slot.job_id == info.job_id &&
+          slot.cf_id == info.cf_id) {
+        return &slot;
+      }
+    }
+    return nullptr;
+  }
 
-crocksdb_options_t* crocksdb_options_from_column_family_descriptor(
-    const crocksdb_column_family_descriptor* cf_desc) {
-  crocksdb_options_t* options = new crocksdb_options_t;
-  *static_cast<ColumnFamilyOptions*>(&options->rep) = cf_desc->rep.options;
-  return options;
-}
+  static crocksdb_event_record_t NewRecord(int type) {
+    crocksdb_event_record_t r;
+    memset(&r, 0, sizeof(r));
+    r.type = type;
+    r.input_level = -1;
+    r.output_level = -1;
+    return r;
+  }
 
-void crocksdb_options_increase_parallelism(crocksdb_options_t* opt,
-                                           int total_threads) {
-  opt->rep.IncreaseParallelism(total_threads);
-}
+  static uint64_t TableSize(const TableProperties& props) {
+    return props.data_size + props.index_size + props.filter_size;
+  }
 
-void crocksdb_options_optimize_for_point_lookup(crocksdb_options_t* opt,
-                                                uint64_t block_cache_size_mb) {
-  opt->rep.OptimizeForPointLookup(block_cache_size_mb);
-}
+  static void SetCfName(crocksdb_event_record_t* r, const std::string& name) {
+    r->cf_name_len = static_cast<uint32_t>(
+        std::min(name.size(), sizeof(r->cf_name)));
+    memcpy(r->cf_name, name.data(), r->cf_name_len);
+  }
 
-void crocksdb_options_optimize_level_style_compaction(
-    crocksdb_options_t* opt, uint64_t memtable_memory_budget) {
-  opt->rep.OptimizeLevelStyleCompaction(memtable_memory_budget);
-}
+  // Keeps the end of long paths, which holds the file name.
+  static void SetPath(crocksdb_event_record_t* r, const std::string& path) {
+    size_t len = std::min(path.size(), sizeof(r->path));
+    r->path_len = static_cast<uint32_t>(len);
+    memcpy(r->path, path.data() + path.size() - len, len);
+  }
 
-void crocksdb_options_optimize_universal_style_compaction(
-    crocksdb_options_t* opt, uint64_t memtable_memory_budget) {
-  opt->rep.OptimizeUniversalStyleCompaction(memtable_memory_budget);
-}
+  std::shared_ptr<crocksdb_event_ring_t::Rep> ring_;
+};
 
-void crocksdb_options_set_compaction_filter(
-    crocksdb_options_t* opt, crocksdb_compactionfilter_t* filter) {
-  opt->rep.compaction_filter = filter;
+thread_local EventRingListener::FlushStart
+    EventRingListener::flush_starts_[EventRingListener::kFlushStartSlots];
+thread_local size_t EventRingListener::flush_start_next_ = 0;
+
+crocksdb_event_ring_t* crocksdb_event_ring_create(size_t capacity) {
+  size_t cap = 2;
+  while (cap < capacity) {
+    cap <<= 1;
+  }
+  auto ring = new crocksdb_event_ring_t;
+  ring->rep = std::make_shared<crocksdb_event_ring_t::Rep>(cap);
+  return ring;
 }
 
-void crocksdb_options_set_compaction_filter_factory(
-    crocksdb_options_t* opt, crocksdb_compactionfilterfactory_t* factory) {
-  opt->rep.compaction_filter_factory =
-      std::shared_ptr<CompactionFilterFactory>(factory);
+void crocksdb_event_ring_destroy(crocksdb_event_ring_t* ring) { delete ring; }
+
+void crocksdb_options_add_event_ring(crocksdb_options_t* opt,
+                                     crocksdb_event_ring_t* ring) {
+  opt->rep.listeners.emplace_back(
+      std::make_shared<EventRingListener>(ring->rep));
 }
 
-void crocksdb_options_compaction_readahead_size(crocksdb_options_t* opt,
-                                                size_t s) {
-  opt->rep.compaction_readahead_size = s;
+size_t crocksdb_event_ring_drain(crocksdb_event_ring_t* ring,
+                                 crocksdb_event_record_t* records,
+                                 size_t max_records) {
+  size_t n = 0;
+  while (n < max_records && ring->rep->Pop(&records[n])) {
+    n++;
+  }
+  return n;
 }
 
-void crocksdb_options_set_comparator(crocksdb_options_t* opt,
-                                     crocksdb_comparator_t* cmp) {
-  opt->rep.comparator = cmp;
+uint64_t crocksdb_event_ring_dropped(const crocksdb_event_ring_t* ring) {
+  return ring->rep->dropped.load(std::memory_order_relaxed);
 }
 
-void crocksdb_options_set_merge_operator(
+/* file io stats */
+
+struct crocksdb_file_io_stats_t {
+  struct Histogram {
+    void Add(size_t bytes, uint64_t nanos, bool ok) {
+      count.fetch_add(1, std::memory_order_relaxed);
+      this->bytes.fetch_add(bytes, std::memory_order_relaxed);
+      total_nanos.fetch_add(nanos, std::memory_order_relaxed);
+      if (!ok) {
+        errors.fetch_add(1, std::memory_order_relaxed);
+      }
+      uint64_t max = max_nanos.load(std::memory_order_relaxed);
+      while (nanos > max && !max_nanos.compare_exchange_weak(
+                                max, nanos, std::memory_order_relaxed)) {
+      }
+      // Bucket i holds latencies below 2^i microseconds.
+      uint64_t micros = nanos / 1000;
+      size_t bucket = 0;
+      while (micros > 0 && bucket + 1 < kBuckets) {
+        micros >>= 1;
+        bucket++;
+      }
+      buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void Get(crocksdb_io_histogram_t* out) const {
+      out->count = count.load(std::memory_order_relaxed);
+      out->bytes = bytes.load(std::memory_order_relaxed);
+      out->errors = errors.load(std::memory_order_relaxed);
+      out->total_nanos = total_nanos.load(std::memory_order_relaxed);
+      out->max_nanos = max_nanos.load(std::memory_order_relaxed);
+      for (size_t i = 0; i < kBuckets; i++) {
+        out->buckets[i] = buckets[i].load(std::memory_order_relaxed);
+      }
+    }
+
+    void Reset() {
+      count.store(0, std::memory_order_relaxed);
+      bytes.store(0, std::memory_order_relaxed);
+      errors.store(0, std::memory_order_relaxed);
+      total_nanos.store(0, std::memory_order_relaxed);
+      max_nanos.store(0, std::memory_order_relaxed);
+      for (auto& b : buckets) {
+        b.store(0, std::memory_order_relaxed);
+      }
+    }
+
+    static const size_t kBuckets =
+        sizeof(crocksdb_io_histogram_t::buckets) / sizeof(uint64_t);
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<uint64_t> errors{0};
+    std::atomic<uint64_t> total_nanos{0};
+    std::atomic<uint64_t> max_nanos{0};
+    std::atomic<uint64_t> buckets[kBuckets] = {};
+  };
+
+  static const int kNumOps = crocksdb_file_io_sync + 1;
+  static const int kNumFileTypes = crocksdb_io_file_type_other + 1;
+  static const int kNumLevels = 8;
+
+  struct Rep {
+    // Level of every live table file. It is known when the file is created
+    // by a flush or compaction, or ingested, and files present before the
+    // first such event are filled in from the DB.
+    //
+    // `levels` is only locked when files come and go. IO lookups go through
+    // `level_slots`, a direct-mapped index by file number holding
+    // `file_number << 8 | level`, and take the lock only when two live files
+    // share a slot or the slot went stale after a deletion.
+    static const size_t kLevelSlots = 4096;
+    static constexpr uint64_t kEmptySlot = 0;
+    static constexpr uint64_t kStaleSlot = ~uint64_t{0};
+
+    static uint64_t PackSlot(uint64_t file_number, int level) {
+      return (file_number << 8) | static_cast<uint8_t>(level);
+    }
+
+    void SetLevel(uint64_t file_number, int level) {
+      std::lock_guard<std::mutex> lock(levels_mu);
+      levels[file_number] = level;
+      level_slots[file_number % kLevelSlots].store(
+          PackSlot(file_number, level), std::memory_order_relaxed);
+    }
+
+    int GetLevel(uint64_t file_number) {
+      auto& slot = level_slots[file_number % kLevelSlots];
+      uint64_t v = slot.load(std::memory_order_relaxed);
+      if (v == kEmptySlot) {
+        return -1;
+      }
+      if (v != kStaleSlot && (v >> 8) == file_number) {
+        return static_cast<int>(v & 0xff);
+      }
+      std::lock_guard<std::mutex> lock(levels_mu);
+      auto it = levels.find(file_number);
+      if (it == levels.end()) {
+        return -1;
+      }
+      if (slot.load(std::memory_order_relaxed) == kStaleSlot) {
+        slot.store(PackSlot(file_number, it->second),
+                   std::memory_order_relaxed);
+      }
+      return it->second;
+    }
+
+    void EraseLevel(uint64_t file_number) {
+      std::lock_guard<std::mutex> lock(levels_mu);
+      auto it = levels.find(file_number);
+      if (it == levels.end()) {
+        return;
+      }
+      auto& slot = level_slots[file_number % kLevelSlots];
+      // Another live file may share the slot, so it can't just be emptied.
+      if (slot.load(std::memory_order_relaxed) ==
+          PackSlot(file_number, it->second)) {
+        slot.store(kStaleSlot, std::memory_order_relaxed);
+      }
+      levels.erase(it);
+    }
+
+    void SeedLevels(DB* db) {
+      if (seeded.exchange(true)) {
+        return;
+      }
+      std::vector<LiveFileMetaData> files;
+      db->GetLiveFilesMetaData(&files);
+      for (auto& f : files) {
+        SetLevel(f.file_number, f.level);
+      }
+    }
+
+    void SetCompactionOutputLevel(const std::string& db_name, int job_id,
+                                  int level) {
+      std::lock_guard<std::mutex> lock(levels_mu);
+      compaction_output_levels[std::make_pair(db_name, job_id)] = level;
+    }
+
+    void EraseCompactionOutputLevel(const std::string& db_name, int job_id) {
+      std::lock_guard<std::mutex> lock(levels_mu);
+      compaction_output_levels.erase(std::make_pair(db_name, job_id));
+    }
+
+    int GetCompactionOutputLevel(const std::string& db_name, int job_id) {
+      std::lock_guard<std::mutex> lock(levels_mu);
+      auto it = compaction_output_levels.find(std::make_pair(db_name, job_id));
+      return it == compaction_output_levels.end() ? -1 : it->second;
+    }
+
+    void Record(int op, const FileOperationInfo& info) {
+      uint64_t number = 0;
+      int file_type = ParseIoFileName(info.path, &number);
+      uint64_t nanos = static_cast<uint64_t>(info.duration.count());
+      bool ok = info.status.ok();
+      by_file_type[op][file_type].Add(info.length, nanos, ok);
+      if (file_type == crocksdb_io_file_type_table) {
+        int level = GetLevel(number);
+        if (level >= 0 && level < kNumLevels) {
+          by_level[op][level].Add(info.length, nanos, ok);
+        }
+      }
+    }
+
+    // Like ParseFileName, but only for the types tracked here and without
+    // copying the path.
+    static int ParseIoFileName(const std::string& path, uint64_t* number) {
+      static const char kManifestPrefix[] = "MANIFEST-";
+      static const size_t kManifestPrefixLen = sizeof(kManifestPrefix) - 1;
+      size_t slash = path.find_last_of('/');
+      size_t start = slash == std::string::npos ? 0 : slash + 1;
+      const char* p = path.data() + start;
+      const char* end = path.data() + path.size();
+      bool manifest = static_cast<size_t>(end - p) > kManifestPrefixLen &&
+                      memcmp(p, kManifestPrefix, kManifestPrefixLen) == 0;
+      if (manifest) {
+        p += kManifestPrefixLen;
+      }
+      const char* digits = p;
+      uint64_t n = 0;
+      while (p < end && *p >= '0' && *p <= '9') {
+        n = n * 10 + static_cast<uint64_t>(*p - '0');
+        p++;
+      }
+      if (p == digits) {
+        return crocksdb_io_file_type_other;
+      }
+      *number = n;
+      Slice suffix(p, static_cast<size_t>(end - p));
+      if (manifest) {
+        return suffix.empty() ? crocksdb_io_file_type_manifest
+                              : crocksdb_io_file_type_other;
+      }
+      if (suffix == ".sst" || suffix == ".ldb") {
+        return crocksdb_io_file_type_table;
+      }
+      if (suffix == ".log") {
+        return crocksdb_io_file_type_wal;
+      }
+      if (suffix == ".blob") {
+        return crocksdb_io_file_type_blob;
+      }
+      return crocksdb_io_file_type_other;
+    }
+
+    std::mutex levels_mu;
+    std::unordered_map<uint64_t, int> levels;
+    std::map<std::pair<std::string, int>, int> compaction_output_levels;
+    std::atomic<uint64_t> level_slots[kLevelSlots] = {};
+    std::atomic<bool> seeded{false};
+    Histogram by_file_type[kNumOps][kNumFileTypes];
+    Histogram by_level[kNumOps][kNumLevels];
+    std::atomic<uint64_t> tables_created{0};
+    std::atomic<uint64_t> tables_created_bytes{0};
+    std::atomic<uint64_t> tables_deleted{0};
+  };
+  std::shared_ptr<Rep> rep = std::make_shared<Rep>();
+};
+
+class FileIOStatsListener : public EventListener {
+ public:
+  explicit FileIOStatsListener(
+      std::shared_ptr<crocksdb_file_io_stats_t::Rep> stats)
+      : stats_(std::move(stats)) {}
+
+  const char* Name() const override { return "crocksdb.FileIOStatsListener"; }
+
+  bool ShouldBeNotifiedOnFileIO() override { return true; }
+
+  void OnFileReadFinish(const FileOperationInfo& info) override {
+    stats_->Record(crocksdb_file_io_read, info);
+  }
+
+  void OnFileWriteFinish(const FileOperationInfo& info) override {
+    stats_->Record(crocksdb_file_io_write, info);
+  }
+
+  void OnFileSyncFinish(const FileOperationInfo& info) override {
+    stats_->Record(crocksdb_file_io_sync, info);
+  }
+
+  void OnFileRangeSyncFinish(const FileOperationInfo& info) override {
+    stats_->Record(crocksdb_file_io_sync, info);
+  }
+
+  void OnFlushBegin(DB* db, const FlushJobInfo& /*info*/) override {
+    stats_->SeedLevels(db);
+  }
+
+  void OnFlushCompleted(DB* db, const FlushJobInfo& info) override {
+    stats_->SeedLevels(db);
+    stats_->SetLevel(info.file_number, 0);
+  }
+
+  void OnCompactionBegin(DB* db, const CompactionJobInfo& info) override {
+    stats_->SeedLevels(db);
+    stats_->SetCompactionOutputLevel(db->GetName(), info.job_id,
+                                     info.output_level);
+  }
+
+  void OnCompactionCompleted(DB* db, const CompactionJobInfo& info) override {
+    stats_->SeedLevels(db);
+    stats_->EraseCompactionOutputLevel(db->GetName(), info.job_id);
+    for (auto& f : info.output_file_infos) {
+      stats_->SetLevel(f.file_number, f.level);
+    }
+  }
+
+  // Resolves the level before the file is written, so that its writes and
+  // the reads that verify it are attributed too.
+  void OnTableFileCreationStarted(
+      const TableFileCreationBriefInfo& info) override {
+    int level = -1;
+    switch (info.reason) {
+      case TableFileCreationReason::kFlush:
+      case TableFileCreationReason::kRecovery:
+        level = 0;
+        break;
+      case TableFileCreationReason::kCompaction:
+        level = stats_->GetCompactionOutputLevel(info.db_name, info.job_id);
+        break;
+      default:
+        break;
+    }
+    if (level >= 0) {
+      stats_->SetLevel(rocksdb::TableFileNameToNumber(info.file_path), level);
+    }
+  }
+
+  void OnExternalFileIngested(DB* db,
+                              const ExternalFileIngestionInfo& info) override {
+    stats_->SeedLevels(db);
+    stats_->SetLevel(rocksdb::TableFileNameToNumber(info.internal_file_path),
+                     info.picked_level);
+  }
+
+  void OnTableFileCreated(const TableFileCreationInfo& info) override {
+    if (info.status.ok()) {
+      stats_->tables_created.fetch_add(1, std::memory_order_relaxed);
+      stats_->tables_created_bytes.fetch_add(info.file_size,
+                                             std::memory_order_relaxed);
+    }
+  }
+
+  void OnTableFileDeleted(const TableFileDeletionInfo& info) override {
+    if (info.status.ok()) {
+      stats_->tables_deleted.fetch_add(1, std::memory_order_relaxed);
+    }
+    stats_->EraseLevel(rocksdb::TableFileNameToNumber(info.file_path));
+  }
+
+ private:
+  std::shared_ptr<crocksdb_file_io_stats_t::Rep> stats_;
+};
+
+crocksdb_file_io_stats_t* crocksdb_file_io_stats_create() {
+  return new crocksdb_file_io_stats_t;
+}
+
+void crocksdb_file_io_stats_destroy(crocksdb_file_io_stats_t* stats) {
+  delete stats;
+}
+
+void crocksdb_options_add_file_io_stats(crocksdb_options_t* opt,
+                                        crocksdb_file_io_stats_t* stats) {
+  opt->rep.listeners.emplace_back(
+      std::make_shared<FileIOStatsListener>(stats->rep));
+}
+
+void crocksdb_file_io_stats_by_file_type(const crocksdb_file_io_stats_t* stats,
+                                         int op, int file_type,
+                                         crocksdb_io_histogram_t* hist) {
+  memset(hist, 0, sizeof(*hist));
+  if (op < 0 || op >= crocksdb_file_io_stats_t::kNumOps || file_type < 0 ||
+      file_type >= crocksdb_file_io_stats_t::kNumFileTypes) {
+    return;
+  }
+  stats->rep->by_file_type[op][file_type].Get(hist);
+}
+
+void crocksdb_file_io_stats_by_level(const crocksdb_file_io_stats_t* stats,
+                                     int op, int level,
+                                     crocksdb_io_histogram_t* hist) {
+  memset(hist, 0, sizeof(*hist));
+  if (op < 0 || op >= crocksdb_file_io_stats_t::kNumOps || level < 0 ||
+      level >= crocksdb_file_io_stats_t::kNumLevels) {
+    return;
+  }
+  stats->rep->by_level[op][level].Get(hist);
+}
+
+void crocksdb_file_io_stats_table_files(const crocksdb_file_io_stats_t* stats,
+                                        uint64_t* created,
+                                        uint64_t* created_bytes,
+                                        uint64_t* deleted) {
+  auto& rep = *stats->rep;
+  *created = rep.tables_created.load(std::memory_order_relaxed);
+  *created_bytes = rep.tables_created_bytes.load(std::memory_order_relaxed);
+  *deleted = rep.tables_deleted.load(std::memory_order_relaxed);
+}
+
+void crocksdb_file_io_stats_reset(crocksdb_file_io_stats_t* stats) {
+  auto& rep = *stats->rep;
+  for (auto& op : rep.by_file_type) {
+    for (auto& h : op) {
+      h.Reset();
+    }
+  }
+  for (auto& op : rep.by_level) {
+    for (auto& h : op) {
+      h.Reset();
+    }
+  }
+  rep.tables_created.store(0, std::memory_order_relaxed);
+  rep.tables_created_bytes.store(0, std::memory_order_relaxed);
+  rep.tables_deleted.store(0, std::memory_order_relaxed);
+}
+
+crocksdb_cuckoo_table_options_t* crocksdb_cuckoo_options_create() {
+  return new crocksdb_cuckoo_table_options_t;
+}
+
+void crocksdb_cuckoo_options_destroy(crocksdb_cuckoo_table_options_t* options) {
+  delete options;
+}
+
+void crocksdb_cuckoo_options_set_hash_ratio(
+    crocksdb_cuckoo_table_options_t* options, double v) {
+  options->rep.hash_table_ratio = v;
+}
+
+void crocksdb_cuckoo_options_set_max_search_depth(
+    crocksdb_cuckoo_table_options_t* options, uint32_t v) {
+  options->rep.max_search_depth = v;
+}
+
+void crocksdb_cuckoo_options_set_cuckoo_block_size(
+    crocksdb_cuckoo_table_options_t* options, uint32_t v) {
+  options->rep.cuckoo_block_size = v;
+}
+
+void crocksdb_cuckoo_options_set_identity_as_first_hash(
+    crocksdb_cuckoo_table_options_t* options, unsigned char v) {
+  options->rep.identity_as_first_hash = v;
+}
+
+void crocksdb_cuckoo_options_set_use_module_hash(
+    crocksdb_cuckoo_table_options_t* options, unsigned char v) {
+  options->rep.use_module_hash = v;
+}
+
+void crocksdb_options_set_cuckoo_table_factory(
+    crocksdb_options_t* opt, crocksdb_cuckoo_table_options_t* table_options) {
+  if (table_options) {
+    opt->rep.table_factory.reset(
+        rocksdb::NewCuckooTableFactory(table_options->rep));
+  }
+}
+
+crocksdb_options_t* crocksdb_options_create() { return new crocksdb_options_t; }
+
+crocksdb_options_t* crocksdb_options_copy(const crocksdb_options_t* other) {
+  return new crocksdb_options_t{Options(other->rep)};
+}
+
+void crocksdb_options_destroy(crocksdb_options_t* options) { delete options; }
+
+void crocksdb_column_family_descriptor_destroy(
+    crocksdb_column_family_descriptor* cf_desc) {
+  delete cf_desc;
+}
+
+const char* crocksdb_name_from_column_family_descriptor(
+    const crocksdb_column_family_descriptor* cf_desc) {
+  return cf_desc->rep.name.c_str();
+}
+
+crocksdb_options_t* crocksdb_options_from_column_family_descriptor(
+    const crocksdb_column_family_descriptor* cf_desc) {
+  crocksdb_options_t* options = new crocksdb_options_t;
+  *static_cast<ColumnFamilyOptions*>(&options->rep) = cf_desc->rep.options;
+  return options;
+}
+
+void crocksdb_options_increase_parallelism(crocksdb_options_t* opt,
+                                           int total_threads) {
+  opt->rep.IncreaseParallelism(total_threads);
+}
+
+void crocksdb_options_optimize_for_point_lookup(crocksdb_options_t* opt,
+                                                uint64_t block_cache_size_mb) {
+  opt->rep.OptimizeForPointLookup(block_cache_size_mb);
+}
+
+void crocksdb_options_optimize_level_style_compaction(
+    crocksdb_options_t* opt, uint64_t memtable_memory_budget) {
+  opt->rep.OptimizeLevelStyleCompaction(memtable_memory_budget);
+}
+
+void crocksdb_options_optimize_universal_style_compaction(
+    crocksdb_options_t* opt, uint64_t memtable_memory_budget) {
+  opt->rep.OptimizeUniversalStyleCompaction(memtable_memory_budget);
+}
+
+void crocksdb_options_set_compaction_filter(
+    crocksdb_options_t* opt, crocksdb_compactionfilter_t* filter) {
+  opt->rep.compaction_filter = filter;
+}
+
+void crocksdb_options_set_compaction_filter_factory(
+    crocksdb_options_t* opt, crocksdb_compactionfilterfactory_t* factory) {
+  opt->rep.compaction_filter_factory =
+      std::shared_ptr<CompactionFilterFactory>(factory);
+}
+
+void crocksdb_options_compaction_readahead_size(crocksdb_options_t* opt,
+                                                size_t s) {
+  opt->rep.compaction_readahead_size = s;
+}
+
+void crocksdb_options_set_comparator(crocksdb_options_t* opt,
+                                     crocksdb_comparator_t* cmp) {
+  opt->rep.comparator = cmp;
+}
+
+void crocksdb_options_set_persist_user_defined_timestamps(
+    crocksdb_options_t* opt, unsigned char v) {
+  opt->rep.persist_user_defined_timestamps = v;
+}
+
+void crocksdb_options_set_merge_operator(
     crocksdb_options_t* opt, crocksdb_mergeoperator_t* merge_operator) {
   opt->rep.merge_operator = std::shared_ptr<MergeOperator>(merge_operator);
 }
@@ -3082,6 +4163,11 @@ void crocksdb_options_set_enable_pipelined_write(crocksdb_options_t* opt,
   opt->rep.enable_pipelined_write = v;
 }
 
+void crocksdb_options_set_enable_thread_tracking(crocksdb_options_t* opt,
+                                                 unsigned char v) {
+  opt->rep.enable_thread_tracking = v;
+}
+
 void crocksdb_options_set_enable_multi_batch_write(crocksdb_options_t* opt,
                                                    unsigned char v) {
   opt->rep.enable_multi_batch_write = v;
@@ -3420,6 +4506,8 @@ crocksdb_statistics_t* crocksdb_statistics_create() {
 crocksdb_statistics_t* crocksdb_titan_statistics_create() {
   crocksdb_statistics_t* statistics = new crocksdb_statistics_t;
   statistics->rep = rocksdb::titandb::CreateDBStatistics();
+  statistics->num_tickers = rocksdb::titandb::TITAN_TICKER_ENUM_MAX;
+  statistics->num_histograms = rocksdb::titandb::TITAN_HISTOGRAM_ENUM_MAX;
   return statistics;
 }
 
@@ -3495,6 +4583,75 @@ unsigned char crocksdb_statistics_get_histogram(
   return 0;
 }
 
+uint32_t crocksdb_statistics_num_tickers(crocksdb_statistics_t* statistics) {
+  return statistics->rep ? statistics->num_tickers : 0;
+}
+
+uint32_t crocksdb_statistics_num_histograms(
+    crocksdb_statistics_t* statistics) {
+  return statistics->rep ? statistics->num_histograms : 0;
+}
+
+// HistogramData has no 99.9th percentile, so it is read back from the
+// "P99.9:" field of the histogram's text form. Returns 0 if that field is
+// missing or unparsable, e.g. should the text form change.
+static double ParseP999(const std::string& histogram) {
+  static const char kP999[] = "P99.9:";
+  size_t pos = histogram.find(kP999);
+  if (pos == std::string::npos) {
+    return 0;
+  }
+  const char* start = histogram.c_str() + pos + sizeof(kP999) - 1;
+  char* end = nullptr;
+  double value = strtod(start, &end);
+  return end == start ? 0 : value;
+}
+
+void crocksdb_statistics_export(crocksdb_statistics_t* statistics,
+                                uint64_t* tickers, size_t num_tickers,
+                                crocksdb_histogram_summary_t* histograms,
+                                size_t num_histograms, unsigned char reset) {
+  memset(tickers, 0, sizeof(*tickers) * num_tickers);
+  memset(histograms, 0, sizeof(*histograms) * num_histograms);
+  if (!statistics->rep) {
+    return;
+  }
+  Statistics* stats = statistics->rep.get();
+  num_histograms = std::min<size_t>(num_histograms, statistics->num_histograms);
+  for (uint32_t i = 0; i < num_histograms; i++) {
+    HistogramData data;
+    stats->histogramData(i, &data);
+    crocksdb_histogram_summary_t& h = histograms[i];
+    h.count = data.count;
+    h.sum = data.sum;
+    h.min = data.min;
+    h.max = data.max;
+    h.average = data.average;
+    h.standard_deviation = data.standard_deviation;
+    h.p50 = data.median;
+    h.p95 = data.percentile95;
+    h.p99 = data.percentile99;
+    h.p999 = data.count > 0 ? ParseP999(stats->getHistogramString(i)) : 0;
+  }
+  num_tickers = std::min<size_t>(num_tickers, statistics->num_tickers);
+  if (!reset || num_histograms == 0) {
+    // Each ticker is read and reset atomically, so no tick is lost.
+    for (uint32_t i = 0; i < num_tickers; i++) {
+      tickers[i] = reset ? stats->getAndResetTickerCount(i)
+                         : stats->getTickerCount(i);
+    }
+    return;
+  }
+  // Statistics can only reset histograms together with all tickers. Tickers
+  // are read right before that single reset, so only updates recorded after
+  // their read (or after the histogram reads above) and before the reset are
+  // lost.
+  for (uint32_t i = 0; i < num_tickers; i++) {
+    tickers[i] = stats->getTickerCount(i);
+  }
+  stats->Reset();
+}
+
 void crocksdb_options_set_ratelimiter(crocksdb_options_t* opt,
                                       crocksdb_ratelimiter_t* limiter) {
   opt->rep.rate_limiter = limiter->rep;
@@ -3812,24 +4969,262 @@ crocksdb_comparator_t* crocksdb_comparator_create(
 
 void crocksdb_comparator_destroy(crocksdb_comparator_t* cmp) { delete cmp; }
 
-void crocksdb_filterpolicy_destroy(crocksdb_filterpolicy_t* filter) {
-  delete filter;
+size_t crocksdb_comparator_timestamp_size(const crocksdb_comparator_t* cmp) {
+  return cmp->timestamp_size();
 }
 
-// Make a crocksdb_filterpolicy_t, but override all of its methods so
-// they delegate to a NewBloomFilterPolicy() instead of user
-// supplied C functions.
-struct FilterPolicyWrapper : public crocksdb_filterpolicy_t {
-  const FilterPolicy* rep_;
-  ~FilterPolicyWrapper() override { delete rep_; }
-  const char* Name() const override { return rep_->Name(); }
-  const char* CompatibilityName() const override {
-    return rep_->CompatibilityName();
+// Orders keys made of a fixed-width big-endian u64 (e.g. a table or region
+// id) followed by arbitrary bytes. Big-endian makes the numeric order of the
+// prefix equal to its byte order, so comparison stays a plain memcmp; the
+// point of this comparator is that shortened index keys never cut into the
+// prefix.
+class U64PrefixBytewiseComparator : public Comparator {
+ public:
+  static constexpr size_t kPrefixSize = sizeof(uint64_t);
+
+  const char* Name() const override {
+    return "crocksdb.U64PrefixBytewiseComparator";
   }
-  // No need to override GetFilterBitsBuilder if this one is overridden
-  FilterBitsBuilder* GetBuilderWithContext(
-      const FilterBuildingContext& context) const override {
-    return rep_->GetBuilderWithContext(context);
+
+  int Compare(const Slice& a, const Slice& b) const override {
+    return a.compare(b);
+  }
+
+  bool Equal(const Slice& a, const Slice& b) const override { return a == b; }
+
+  void FindShortestSeparator(std::string* start,
+                             const Slice& limit) const override {
+    if (start->size() < kPrefixSize || limit.size() < kPrefixSize) {
+      return;
+    }
+    uint64_t start_prefix = DecodeBigEndian64(start->data());
+    uint64_t limit_prefix = DecodeBigEndian64(limit.data());
+    if (start_prefix == limit_prefix) {
+      std::string suffix = start->substr(kPrefixSize);
+      rocksdb::BytewiseComparator()->FindShortestSeparator(
+          &suffix, Slice(limit.data() + kPrefixSize,
+                         limit.size() - kPrefixSize));
+      if (suffix.size() + kPrefixSize < start->size()) {
+        start->resize(kPrefixSize);
+        start->append(suffix);
+      }
+    } else if (start_prefix < limit_prefix - 1) {
+      // A bare prefix strictly between the two is the shortest choice.
+      if (start->size() > kPrefixSize) {
+        start->resize(kPrefixSize);
+        EncodeBigEndian64(&(*start)[0], start_prefix + 1);
+      }
+    } else if (start_prefix < limit_prefix) {
+      // Adjacent prefixes: anything with start's prefix is below limit.
+      FindShortSuccessor(start);
+    }
+  }
+
+  void FindShortSuccessor(std::string* key) const override {
+    if (key->size() <= kPrefixSize) {
+      return;
+    }
+    std::string suffix = key->substr(kPrefixSize);
+    rocksdb::BytewiseComparator()->FindShortSuccessor(&suffix);
+    if (suffix.size() + kPrefixSize < key->size()) {
+      key->resize(kPrefixSize);
+      key->append(suffix);
+    }
+  }
+
+  bool IsSameLengthImmediateSuccessor(const Slice& s,
+                                      const Slice& t) const override {
+    return rocksdb::BytewiseComparator()->IsSameLengthImmediateSuccessor(s, t);
+  }
+
+  bool CanKeysWithDifferentByteContentsBeEqual() const override {
+    return false;
+  }
+
+  static uint64_t DecodeBigEndian64(const char* p) {
+    uint64_t v = 0;
+    for (size_t i = 0; i < kPrefixSize; i++) {
+      v = (v << 8) | static_cast<unsigned char>(p[i]);
+    }
+    return v;
+  }
+
+  static void EncodeBigEndian64(char* p, uint64_t v) {
+    for (size_t i = kPrefixSize; i > 0; i--) {
+      p[i - 1] = static_cast<char>(v & 0xff);
+      v >>= 8;
+    }
+  }
+};
+
+// Orders keys of the form `user_key | ts`, where `ts` is a fixed-width
+// big-endian suffix, by user key ascending and then by ts descending so that
+// the newest version of a key is met first. Keys shorter than the suffix are
+// treated as bare user keys with an empty ts.
+class BytewiseDescTsSuffixComparator : public Comparator {
+ public:
+  static constexpr size_t kTsSize = sizeof(uint64_t);
+
+  const char* Name() const override {
+    return "crocksdb.BytewiseDescTsSuffixComparator";
+  }
+
+  int Compare(const Slice& a, const Slice& b) const override {
+    int r = UserKey(a).compare(UserKey(b));
+    if (r != 0) {
+      return r;
+    }
+    return -Ts(a).compare(Ts(b));
+  }
+
+  bool Equal(const Slice& a, const Slice& b) const override { return a == b; }
+
+  void FindShortestSeparator(std::string* start,
+                             const Slice& limit) const override {
+    Slice start_user_key = UserKey(*start);
+    Slice limit_user_key = UserKey(limit);
+    std::string sep(start_user_key.data(), start_user_key.size());
+    rocksdb::BytewiseComparator()->FindShortestSeparator(&sep, limit_user_key);
+    if (sep.size() + kTsSize < start->size() &&
+        start_user_key.compare(sep) < 0) {
+      // The largest ts sorts first among versions of `sep`, so the result
+      // stays as close to `start` as possible.
+      sep.append(kTsSize, '\xff');
+      assert(Compare(*start, sep) < 0);
+      assert(Compare(sep, limit) < 0);
+      start->swap(sep);
+    }
+  }
+
+  void FindShortSuccessor(std::string* key) const override {
+    Slice user_key = UserKey(*key);
+    std::string succ(user_key.data(), user_key.size());
+    rocksdb::BytewiseComparator()->FindShortSuccessor(&succ);
+    if (succ.size() + kTsSize < key->size() && user_key.compare(succ) < 0) {
+      succ.append(kTsSize, '\xff');
+      key->swap(succ);
+    }
+  }
+
+  bool CanKeysWithDifferentByteContentsBeEqual() const override {
+    return false;
+  }
+
+ private:
+  static Slice UserKey(const Slice& key) {
+    return key.size() < kTsSize ? key
+                                : Slice(key.data(), key.size() - kTsSize);
+  }
+
+  static Slice Ts(const Slice& key) {
+    return key.size() < kTsSize
+               ? Slice()
+               : Slice(key.data() + key.size() - kTsSize, kTsSize);
+  }
+};
+
+// Make a crocksdb_comparator_t that delegates to a native comparator
+// instead of user supplied C functions. `rep_` is a process-wide singleton
+// and is not owned.
+struct ComparatorWrapper : public crocksdb_comparator_t {
+  explicit ComparatorWrapper(const Comparator* rep)
+      : crocksdb_comparator_t(rep->timestamp_size()), rep_(rep) {}
+  const Comparator* rep_;
+  const char* Name() const override { return rep_->Name(); }
+  int Compare(const Slice& a, const Slice& b) const override {
+    return rep_->Compare(a, b);
+  }
+  bool Equal(const Slice& a, const Slice& b) const override {
+    return rep_->Equal(a, b);
+  }
+  void FindShortestSeparator(std::string* start,
+                             const Slice& limit) const override {
+    rep_->FindShortestSeparator(start, limit);
+  }
+  void FindShortSuccessor(std::string* key) const override {
+    rep_->FindShortSuccessor(key);
+  }
+  bool IsSameLengthImmediateSuccessor(const Slice& s,
+                                      const Slice& t) const override {
+    return rep_->IsSameLengthImmediateSuccessor(s, t);
+  }
+  bool CanKeysWithDifferentByteContentsBeEqual() const override {
+    return rep_->CanKeysWithDifferentByteContentsBeEqual();
+  }
+  int CompareTimestamp(const Slice& ts1, const Slice& ts2) const override {
+    return rep_->CompareTimestamp(ts1, ts2);
+  }
+  int CompareWithoutTimestamp(const Slice& a, bool a_has_ts, const Slice& b,
+                              bool b_has_ts) const override {
+    return rep_->CompareWithoutTimestamp(a, a_has_ts, b, b_has_ts);
+  }
+  Slice GetMaxTimestamp() const override { return rep_->GetMaxTimestamp(); }
+  Slice GetMinTimestamp() const override { return rep_->GetMinTimestamp(); }
+  static void DoNothing(void*) {}
+};
+
+crocksdb_comparator_t* crocksdb_comparator_create_builtin(const char* name,
+                                                          char** errptr) {
+  static const U64PrefixBytewiseComparator u64_prefix_bytewise;
+  static const BytewiseDescTsSuffixComparator bytewise_desc_ts_suffix;
+  const Comparator* rep = nullptr;
+  for (const Comparator* c :
+       {rocksdb::BytewiseComparator(), rocksdb::ReverseBytewiseComparator(),
+        rocksdb::BytewiseComparatorWithU64Ts(),
+        rocksdb::ReverseBytewiseComparatorWithU64Ts(),
+        static_cast<const Comparator*>(&u64_prefix_bytewise),
+        static_cast<const Comparator*>(&bytewise_desc_ts_suffix)}) {
+    if (strcmp(c->Name(), name) == 0) {
+      rep = c;
+      break;
+    }
+  }
+  if (rep == nullptr) {
+    SaveError(errptr, Status::InvalidArgument("Unknown comparator", name));
+    return nullptr;
+  }
+  ComparatorWrapper* wrapper = new ComparatorWrapper(rep);
+  wrapper->state_ = nullptr;
+  wrapper->destructor_ = &ComparatorWrapper::DoNothing;
+  return wrapper;
+}
+
+char* crocksdb_comparator_find_shortest_separator(
+    const crocksdb_comparator_t* cmp, const char* start, size_t start_len,
+    const char* limit, size_t limit_len, size_t* result_len) {
+  std::string result(start, start_len);
+  cmp->FindShortestSeparator(&result, Slice(limit, limit_len));
+  *result_len = result.size();
+  return CopyString(result);
+}
+
+char* crocksdb_comparator_find_short_successor(const crocksdb_comparator_t* cmp,
+                                               const char* key, size_t key_len,
+                                               size_t* result_len) {
+  std::string result(key, key_len);
+  cmp->FindShortSuccessor(&result);
+  *result_len = result.size();
+  return CopyString(result);
+}
+
+void crocksdb_filterpolicy_destroy(crocksdb_filterpolicy_t* filter) {
+  delete filter;
+}
+
+// Make a crocksdb_filterpolicy_t, but override all of its methods so
+// they delegate to a NewBloomFilterPolicy() instead of user
+// supplied C functions.
+struct FilterPolicyWrapper : public crocksdb_filterpolicy_t {
+  const FilterPolicy* rep_;
+  ~FilterPolicyWrapper() override { delete rep_; }
+  const char* Name() const override { return rep_->Name(); }
+  const char* CompatibilityName() const override {
+    return rep_->CompatibilityName();
+  }
+  // No need to override GetFilterBitsBuilder if this one is overridden
+  FilterBitsBuilder* GetBuilderWithContext(
+      const FilterBuildingContext& context) const override {
+    return rep_->GetBuilderWithContext(context);
   }
   FilterBitsReader* GetFilterBitsReader(const Slice& contents) const override {
     return rep_->GetFilterBitsReader(contents);
@@ -3866,6 +5261,182 @@ crocksdb_filterpolicy_t* crocksdb_filterpolicy_create_ribbon(
   return wrapper;
 }
 
+struct crocksdb_filter_stats_t {
+  struct Counters {
+    std::atomic<uint64_t> probes{0};
+    std::atomic<uint64_t> useful{0};
+    std::atomic<uint64_t> resident_bytes{0};
+  };
+  // Indexed by crocksdb_level_filter_bloom / crocksdb_level_filter_ribbon.
+  std::shared_ptr<Counters[]> rep{new Counters[3]};
+};
+
+crocksdb_filter_stats_t* crocksdb_filter_stats_create() {
+  return new crocksdb_filter_stats_t;
+}
+
+void crocksdb_filter_stats_destroy(crocksdb_filter_stats_t* stats) {
+  delete stats;
+}
+
+uint64_t crocksdb_filter_stats_probes(const crocksdb_filter_stats_t* stats,
+                                      int kind) {
+  return stats->rep[kind].probes.load(std::memory_order_relaxed);
+}
+
+uint64_t crocksdb_filter_stats_useful(const crocksdb_filter_stats_t* stats,
+                                      int kind) {
+  return stats->rep[kind].useful.load(std::memory_order_relaxed);
+}
+
+uint64_t crocksdb_filter_stats_resident_bytes(
+    const crocksdb_filter_stats_t* stats, int kind) {
+  return stats->rep[kind].resident_bytes.load(std::memory_order_relaxed);
+}
+
+// Counts probes and negative (useful) results of a filter. A reader lives as
+// long as its parsed filter block, so it also accounts the filter's memory.
+class CountingFilterBitsReader : public FilterBitsReader {
+ public:
+  CountingFilterBitsReader(
+      FilterBitsReader* rep, size_t charge,
+      std::shared_ptr<crocksdb_filter_stats_t::Counters[]> stats, int kind)
+      : rep_(rep), charge_(charge), stats_(std::move(stats)), kind_(kind) {
+    counters().resident_bytes.fetch_add(charge_, std::memory_order_relaxed);
+  }
+
+  ~CountingFilterBitsReader() override {
+    counters().resident_bytes.fetch_sub(charge_, std::memory_order_relaxed);
+  }
+
+  bool MayMatch(const Slice& entry) override {
+    bool may_match = rep_->MayMatch(entry);
+    counters().probes.fetch_add(1, std::memory_order_relaxed);
+    if (!may_match) {
+      counters().useful.fetch_add(1, std::memory_order_relaxed);
+    }
+    return may_match;
+  }
+
+  void MayMatch(int num_keys, Slice** keys, bool* may_match) override {
+    rep_->MayMatch(num_keys, keys, may_match);
+    uint64_t useful = 0;
+    for (int i = 0; i < num_keys; i++) {
+      useful += !may_match[i];
+    }
+    counters().probes.fetch_add(num_keys, std::memory_order_relaxed);
+    counters().useful.fetch_add(useful, std::memory_order_relaxed);
+  }
+
+ private:
+  crocksdb_filter_stats_t::Counters& counters() { return stats_[kind_]; }
+
+  std::unique_ptr<FilterBitsReader> rep_;
+  const size_t charge_;
+  std::shared_ptr<crocksdb_filter_stats_t::Counters[]> stats_;
+  const int kind_;
+};
+
+// Chooses the filter type and bits-per-key from the level a file is created
+// at. Filters of any built-in type can be read by any built-in policy, so
+// reading always goes through the wrapped bloom policy.
+struct LevelFilterPolicyWrapper : public FilterPolicyWrapper {
+  // Indexed by level; nullptr means no filter.
+  std::vector<std::unique_ptr<const FilterPolicy>> level_policies_;
+  bool skip_bottommost_;
+  std::shared_ptr<crocksdb_filter_stats_t::Counters[]> stats_;
+
+  const char* Name() const override { return "crocksdb.LevelFilterPolicy"; }
+
+  FilterBitsBuilder* GetBuilderWithContext(
+      const FilterBuildingContext& context) const override {
+    // Set for compaction output to the bottommost level, never for flushed
+    // or ingested files, whatever level they end up at.
+    if (skip_bottommost_ && context.is_bottommost) {
+      return nullptr;
+    }
+    int level = context.level_at_creation;
+    // Unknown levels (-1) are mostly ingested files, which usually end up
+    // at the bottom, so they share the configuration of the last level.
+    if (level < 0 || level >= static_cast<int>(level_policies_.size())) {
+      level = static_cast<int>(level_policies_.size()) - 1;
+    }
+    const FilterPolicy* policy = level_policies_[level].get();
+    return policy == nullptr ? nullptr : policy->GetBuilderWithContext(context);
+  }
+
+  FilterBitsReader* GetFilterBitsReader(const Slice& contents) const override {
+    FilterBitsReader* reader = rep_->GetFilterBitsReader(contents);
+    if (stats_ == nullptr || reader == nullptr) {
+      return reader;
+    }
+    // Full filters end with 5 bytes of metadata whose first byte is -2 for
+    // Ribbon and -1 (or a legacy probe count) for Bloom.
+    int kind = crocksdb_level_filter_bloom;
+    if (contents.size() >= 5 &&
+        static_cast<signed char>(contents[contents.size() - 5]) == -2) {
+      kind = crocksdb_level_filter_ribbon;
+    }
+    return new CountingFilterBitsReader(reader, contents.size(), stats_, kind);
+  }
+};
+
+crocksdb_filterpolicy_t* crocksdb_filterpolicy_create_level_aware(
+    const int* types, const double* bits_per_key, size_t num_levels,
+    unsigned char skip_bottommost, crocksdb_filter_stats_t* stats) {
+  assert(num_levels > 0);
+  LevelFilterPolicyWrapper* wrapper = new LevelFilterPolicyWrapper;
+  wrapper->rep_ = NewBloomFilterPolicy(10);
+  wrapper->state_ = nullptr;
+  wrapper->destructor_ = &FilterPolicyWrapper::DoNothing;
+  for (size_t i = 0; i < num_levels; i++) {
+    const FilterPolicy* policy = nullptr;
+    switch (types[i]) {
+      case crocksdb_level_filter_bloom:
+        policy = NewBloomFilterPolicy(bits_per_key[i]);
+        break;
+      case crocksdb_level_filter_ribbon:
+        // Never fall back to bloom inside the Ribbon policy, the choice is
+        // already made per level here.
+        policy = NewRibbonFilterPolicy(bits_per_key[i], -1);
+        break;
+      default:
+        break;
+    }
+    wrapper->level_policies_.emplace_back(policy);
+  }
+  wrapper->skip_bottommost_ = skip_bottommost;
+  if (stats != nullptr) {
+    wrapper->stats_ = stats->rep;
+  }
+  return wrapper;
+}
+
+void crocksdb_get_filter_size_per_level_cf(
+    crocksdb_t* db, crocksdb_column_family_handle_t* cf, uint64_t* sizes,
+    size_t num_levels, char** errptr) {
+  std::fill(sizes, sizes + num_levels, 0);
+  TablePropertiesCollection props;
+  Status s = db->rep->GetPropertiesOfAllTables(cf->rep, &props);
+  if (!s.ok()) {
+    SaveError(errptr, s);
+    return;
+  }
+  ColumnFamilyMetaData meta;
+  db->rep->GetColumnFamilyMetaData(cf->rep, &meta);
+  for (const auto& level : meta.levels) {
+    if (level.level < 0 || static_cast<size_t>(level.level) >= num_levels) {
+      continue;
+    }
+    for (const auto& file : level.files) {
+      auto it = props.find(file.db_path + file.name);
+      if (it != props.end() && it->second != nullptr) {
+        sizes[level.level] += it->second->filter_size;
+      }
+    }
+  }
+}
+
 crocksdb_mergeoperator_t* crocksdb_mergeoperator_create(
     void* state, void (*destructor)(void*),
     char* (*full_merge)(void*, const char* key, size_t key_length,
@@ -3920,6 +5491,16 @@ void crocksdb_readoptions_set_adaptive_readahead(crocksdb_readoptions_t* opt,
   opt->rep.adaptive_readahead = v;
 }
 
+void crocksdb_readoptions_set_async_io(crocksdb_readoptions_t* opt,
+                                       unsigned char v) {
+  opt->rep.async_io = v;
+}
+
+void crocksdb_readoptions_set_optimize_multiget_for_io(
+    crocksdb_readoptions_t* opt, unsigned char v) {
+  opt->rep.optimize_multiget_for_io = v;
+}
+
 void crocksdb_readoptions_set_snapshot(crocksdb_readoptions_t* opt,
                                        const crocksdb_snapshot_t* snap) {
   opt->rep.snapshot = (snap ? snap->rep : nullptr);
@@ -3949,6 +5530,28 @@ void crocksdb_readoptions_set_iterate_upper_bound(crocksdb_readoptions_t* opt,
   }
 }
 
+void crocksdb_readoptions_set_timestamp(crocksdb_readoptions_t* opt,
+                                        const char* ts, size_t tslen) {
+  if (ts == nullptr) {
+    opt->timestamp = Slice();
+    opt->rep.timestamp = nullptr;
+  } else {
+    opt->timestamp = Slice(ts, tslen);
+    opt->rep.timestamp = &opt->timestamp;
+  }
+}
+
+void crocksdb_readoptions_set_iter_start_ts(crocksdb_readoptions_t* opt,
+                                            const char* ts, size_t tslen) {
+  if (ts == nullptr) {
+    opt->iter_start_ts = Slice();
+    opt->rep.iter_start_ts = nullptr;
+  } else {
+    opt->iter_start_ts = Slice(ts, tslen);
+    opt->rep.iter_start_ts = &opt->iter_start_ts;
+  }
+}
+
 void crocksdb_readoptions_set_read_tier(crocksdb_readoptions_t* opt, int v) {
   opt->rep.read_tier = static_cast<rocksdb::ReadTier>(v);
 }
@@ -4182,60 +5785,1070 @@ void crocksdb_lru_cache_options_set_num_shard_bits(
   opt->rep.num_shard_bits = num_shard_bits;
 }
 
-void crocksdb_lru_cache_options_set_strict_capacity_limit(
-    crocksdb_lru_cache_options_t* opt, unsigned char strict_capacity_limit) {
-  opt->rep.strict_capacity_limit = strict_capacity_limit;
+void crocksdb_lru_cache_options_set_strict_capacity_limit(
+    crocksdb_lru_cache_options_t* opt, unsigned char strict_capacity_limit) {
+  opt->rep.strict_capacity_limit = strict_capacity_limit;
+}
+
+void crocksdb_lru_cache_options_set_high_pri_pool_ratio(
+    crocksdb_lru_cache_options_t* opt, double high_pri_pool_ratio) {
+  opt->rep.high_pri_pool_ratio = high_pri_pool_ratio;
+}
+
+void crocksdb_lru_cache_options_set_low_pri_pool_ratio(
+    crocksdb_lru_cache_options_t* opt, double low_pri_pool_ratio) {
+  opt->rep.low_pri_pool_ratio = low_pri_pool_ratio;
+}
+
+void crocksdb_lru_cache_options_set_memory_allocator(
+    crocksdb_lru_cache_options_t* opt, crocksdb_memory_allocator_t* allocator) {
+  opt->rep.memory_allocator = allocator->rep;
+}
+
+void crocksdb_lru_cache_options_set_secondary_cache(
+    crocksdb_lru_cache_options_t* opt,
+    crocksdb_secondary_cache_t* secondary_cache) {
+  opt->rep.secondary_cache = secondary_cache->rep;
+}
+
+crocksdb_cache_t* crocksdb_cache_create_lru(crocksdb_lru_cache_options_t* opt) {
+  crocksdb_cache_t* c = new crocksdb_cache_t;
+  c->rep = NewLRUCache(opt->rep);
+  return c;
+}
+
+crocksdb_hyper_clock_cache_options_t* crocksdb_hyper_clock_cache_options_create(
+    size_t capacity, size_t estimated_entry_charge) {
+  return new crocksdb_hyper_clock_cache_options_t{
+      HyperClockCacheOptions(capacity, estimated_entry_charge)};
+}
+
+crocksdb_cache_t* crocksdb_hyper_clock_cache_options_make_shared_cache(
+    crocksdb_hyper_clock_cache_options_t* opts) {
+  crocksdb_cache_t* c = new crocksdb_cache_t;
+  c->rep = opts->rep.MakeSharedCache();
+  return c;
+}
+
+void crocksdb_hyper_clock_cache_options_set_secondary_cache(
+    crocksdb_hyper_clock_cache_options_t* opts,
+    crocksdb_secondary_cache_t* secondary_cache) {
+  opts->rep.secondary_cache = secondary_cache->rep;
+}
+
+// Counts what the block cache asks of its secondary tier. Entries the tier
+// evicts on its own to stay within capacity are not visible from here.
+class CountingSecondaryCache : public rocksdb::SecondaryCacheWrapper {
+ public:
+  explicit CountingSecondaryCache(std::shared_ptr<SecondaryCache> target)
+      : SecondaryCacheWrapper(std::move(target)) {}
+
+  const char* Name() const override { return "CountingSecondaryCache"; }
+
+  Status Insert(const Slice& key, Cache::ObjectPtr obj,
+                const Cache::CacheItemHelper* helper,
+                bool force_insert) override {
+    Status s = target()->Insert(key, obj, helper, force_insert);
+    (s.ok() ? inserts : rejected_inserts)
+        .fetch_add(1, std::memory_order_relaxed);
+    return s;
+  }
+
+  Status InsertSaved(const Slice& key, const Slice& saved,
+                     CompressionType type,
+                     rocksdb::CacheTier source) override {
+    Status s = target()->InsertSaved(key, saved, type, source);
+    (s.ok() ? saved_inserts : rejected_inserts)
+        .fetch_add(1, std::memory_order_relaxed);
+    return s;
+  }
+
+  std::unique_ptr<rocksdb::SecondaryCacheResultHandle> Lookup(
+      const Slice& key, const Cache::CacheItemHelper* helper,
+      Cache::CreateContext* create_context, bool wait, bool advise_erase,
+      Statistics* stats, bool& kept_in_sec_cache) override {
+    auto handle = target()->Lookup(key, helper, create_context, wait,
+                                   advise_erase, stats, kept_in_sec_cache);
+    lookups.fetch_add(1, std::memory_order_relaxed);
+    if (handle != nullptr) {
+      hits.fetch_add(1, std::memory_order_relaxed);
+    }
+    return handle;
+  }
+
+  std::atomic<uint64_t> inserts{0};
+  std::atomic<uint64_t> saved_inserts{0};
+  std::atomic<uint64_t> rejected_inserts{0};
+  std::atomic<uint64_t> lookups{0};
+  std::atomic<uint64_t> hits{0};
+};
+
+crocksdb_secondary_cache_t* crocksdb_compressed_secondary_cache_create(
+    size_t capacity, int num_shard_bits, int compression_type) {
+  CompressedSecondaryCacheOptions opts;
+  opts.capacity = capacity;
+  opts.num_shard_bits = num_shard_bits;
+  opts.compression_type = static_cast<CompressionType>(compression_type);
+  auto counting = std::make_shared<CountingSecondaryCache>(
+      rocksdb::NewCompressedSecondaryCache(opts));
+  auto c = new crocksdb_secondary_cache_t;
+  c->rep = counting;
+  c->counting = counting.get();
+  return c;
+}
+
+void crocksdb_secondary_cache_counters(crocksdb_secondary_cache_t* cache,
+                                       uint64_t* inserts,
+                                       uint64_t* saved_inserts,
+                                       uint64_t* rejected_inserts,
+                                       uint64_t* lookups, uint64_t* hits) {
+  const CountingSecondaryCache* c = cache->counting;
+  *inserts = c->inserts.load(std::memory_order_relaxed);
+  *saved_inserts = c->saved_inserts.load(std::memory_order_relaxed);
+  *rejected_inserts = c->rejected_inserts.load(std::memory_order_relaxed);
+  *lookups = c->lookups.load(std::memory_order_relaxed);
+  *hits = c->hits.load(std::memory_order_relaxed);
+}
+
+void crocksdb_secondary_cache_destroy(crocksdb_secondary_cache_t* cache) {
+  delete cache;
+}
+
+void crocksdb_secondary_cache_set_capacity(crocksdb_secondary_cache_t* cache,
+                                           size_t capacity, char** errptr) {
+  SaveError(errptr, cache->rep->SetCapacity(capacity));
+}
+
+size_t crocksdb_secondary_cache_get_capacity(crocksdb_secondary_cache_t* cache,
+                                             char** errptr) {
+  size_t capacity = 0;
+  SaveError(errptr, cache->rep->GetCapacity(capacity));
+  return capacity;
+}
+
+void crocksdb_cache_destroy(crocksdb_cache_t* cache) { delete cache; }
+
+void crocksdb_cache_set_capacity(crocksdb_cache_t* cache, size_t capacity) {
+  cache->rep->SetCapacity(capacity);
+}
+
+static_assert(crocksdb_cache_entry_role_count ==
+                  static_cast<int>(rocksdb::kNumCacheEntryRoles),
+              "crocksdb_cache_entry_role_* must mirror CacheEntryRole");
+
+// Appends the cache key prefix shared by all blocks of each live table of
+// `cf`. Tables without a stable cache key fall back to the current session,
+// as when the DB opens them.
+static Status GetTableCacheKeyPrefixes(DB* db, ColumnFamilyHandle* cf,
+                                       std::vector<uint64_t>* prefixes) {
+  std::string session_id;
+  Status s = db->GetDbSessionId(session_id);
+  if (!s.ok()) {
+    return s;
+  }
+  TablePropertiesCollection props;
+  s = db->GetPropertiesOfAllTables(cf, &props);
+  if (!s.ok()) {
+    return s;
+  }
+  for (auto& p : props) {
+    uint64_t number = 0;
+    FileType type;
+    rocksdb::ParseFileName(p.first.substr(p.first.rfind('/') + 1), &number,
+                           &type);
+    OffsetableCacheKey base;
+    BlockBasedTable::SetupBaseCacheKey(p.second.get(), session_id, number,
+                                       &base);
+    uint64_t prefix;
+    memcpy(&prefix, base.CommonPrefixSlice().data(), sizeof(prefix));
+    prefixes->push_back(prefix);
+  }
+  return Status::OK();
+}
+
+// Walks a block cache on a background thread and aggregates its entries by
+// role and by the table file they belong to. A walk locks each cache shard in
+// turn, so it is kept off the callers' threads.
+struct crocksdb_cache_usage_monitor_t {
+  struct Snapshot {
+    crocksdb_cache_usage_t usage;
+    // Keyed by the cache key prefix shared by all blocks of a table file.
+    std::unordered_map<uint64_t, crocksdb_cache_role_usage_t> by_file;
+  };
+
+  std::shared_ptr<Cache> cache;
+  uint64_t refresh_interval_micros;
+  std::mutex mu;
+  std::condition_variable cv;
+  std::shared_ptr<const Snapshot> latest;
+  bool refresh_requested = false;
+  bool stopped = false;
+  std::thread worker;
+
+  static bool IsTableBlock(CacheEntryRole role) {
+    switch (role) {
+      case CacheEntryRole::kDataBlock:
+      case CacheEntryRole::kFilterBlock:
+      case CacheEntryRole::kFilterMetaBlock:
+      case CacheEntryRole::kDeprecatedFilterBlock:
+      case CacheEntryRole::kIndexBlock:
+      case CacheEntryRole::kOtherBlock:
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  std::shared_ptr<const Snapshot> Collect() {
+    auto snapshot = std::make_shared<Snapshot>();
+    crocksdb_cache_usage_t& usage = snapshot->usage;
+    memset(&usage, 0, sizeof(usage));
+    usage.collected_at_micros = Env::Default()->NowMicros();
+    usage.capacity = cache->GetCapacity();
+    usage.usage = cache->GetUsage();
+    usage.pinned_usage = cache->GetPinnedUsage();
+    Cache::ApplyToAllEntriesOptions opts;
+    opts.average_entries_per_lock = 256;
+    cache->ApplyToAllEntries(
+        [&](const Slice& key, Cache::ObjectPtr, size_t charge,
+            const Cache::CacheItemHelper* helper) {
+          CacheEntryRole role =
+              helper != nullptr ? helper->role : CacheEntryRole::kMisc;
+          size_t i = static_cast<size_t>(role);
+          usage.roles.bytes[i] += charge;
+          usage.roles.count[i]++;
+          if (IsTableBlock(role) && key.size() >= sizeof(uint64_t)) {
+            uint64_t prefix;
+            memcpy(&prefix, key.data(), sizeof(prefix));
+            crocksdb_cache_role_usage_t& file = snapshot->by_file[prefix];
+            file.bytes[i] += charge;
+            file.count[i]++;
+          }
+        },
+        opts);
+    usage.collection_micros =
+        Env::Default()->NowMicros() - usage.collected_at_micros;
+    return snapshot;
+  }
+
+  void Run() {
+    std::unique_lock<std::mutex> lock(mu);
+    while (!stopped) {
+      lock.unlock();
+      auto snapshot = Collect();
+      lock.lock();
+      latest = std::move(snapshot);
+      refresh_requested = false;
+      cv.notify_all();
+      auto wake = [this] { return stopped || refresh_requested; };
+      if (refresh_interval_micros == 0) {
+        cv.wait(lock, wake);
+      } else {
+        cv.wait_for(lock, std::chrono::microseconds(refresh_interval_micros),
+                    wake);
+      }
+    }
+  }
+
+  // Returns the latest snapshot, waiting for a new walk if it was started
+  // more than `max_age_micros` ago.
+  std::shared_ptr<const Snapshot> Get(uint64_t max_age_micros) {
+    uint64_t now = Env::Default()->NowMicros();
+    std::unique_lock<std::mutex> lock(mu);
+    while (latest == nullptr ||
+           (now > latest->usage.collected_at_micros &&
+            now - latest->usage.collected_at_micros > max_age_micros)) {
+      refresh_requested = true;
+      cv.notify_all();
+      cv.wait(lock);
+    }
+    return latest;
+  }
+};
+
+crocksdb_cache_usage_monitor_t* crocksdb_cache_usage_monitor_create(
+    crocksdb_cache_t* cache, uint64_t refresh_interval_micros) {
+  auto monitor = new crocksdb_cache_usage_monitor_t;
+  monitor->cache = cache->rep;
+  monitor->refresh_interval_micros = refresh_interval_micros;
+  monitor->worker = std::thread([monitor] { monitor->Run(); });
+  return monitor;
+}
+
+void crocksdb_cache_usage_monitor_destroy(
+    crocksdb_cache_usage_monitor_t* monitor) {
+  {
+    std::lock_guard<std::mutex> lock(monitor->mu);
+    monitor->stopped = true;
+  }
+  monitor->cv.notify_all();
+  monitor->worker.join();
+  delete monitor;
+}
+
+void crocksdb_cache_usage_monitor_get(crocksdb_cache_usage_monitor_t* monitor,
+                                      uint64_t max_age_micros,
+                                      crocksdb_cache_usage_t* usage) {
+  *usage = monitor->Get(max_age_micros)->usage;
+}
+
+void crocksdb_cache_usage_monitor_get_cf(
+    crocksdb_cache_usage_monitor_t* monitor, crocksdb_t* db,
+    crocksdb_column_family_handle_t** column_families, size_t num_cfs,
+    uint64_t max_age_micros, crocksdb_cache_role_usage_t* usage,
+    char** errptr) {
+  memset(usage, 0, sizeof(*usage) * num_cfs);
+  auto snapshot = monitor->Get(max_age_micros);
+  for (size_t i = 0; i < num_cfs; i++) {
+    std::vector<uint64_t> prefixes;
+    if (SaveError(errptr, GetTableCacheKeyPrefixes(
+                              db->rep, column_families[i]->rep, &prefixes))) {
+      return;
+    }
+    for (uint64_t prefix : prefixes) {
+      auto it = snapshot->by_file.find(prefix);
+      if (it == snapshot->by_file.end()) {
+        continue;
+      }
+      for (int r = 0; r < crocksdb_cache_entry_role_count; r++) {
+        usage[i].bytes[r] += it->second.bytes[r];
+        usage[i].count[r] += it->second.count[r];
+      }
+    }
+  }
+}
+
+struct crocksdb_cache_dump_options_t {
+  uint64_t budget_bytes = 0;
+  uint32_t roles = ~0u;
+  std::shared_ptr<RateLimiter> rate_limiter;
+};
+
+// Decides which entries a cache dump or load keeps: those of the live tables
+// of some column families, if any are given, up to a byte budget.
+struct CacheDumpFilter {
+  std::unordered_set<uint64_t> prefixes;
+  uint64_t budget_bytes = 0;
+  uint64_t taken_bytes = 0;
+
+  Status Init(crocksdb_t* db,
+              crocksdb_column_family_handle_t** column_families,
+              size_t num_cfs, const crocksdb_cache_dump_options_t* opts) {
+    budget_bytes = opts->budget_bytes;
+    for (size_t i = 0; i < num_cfs; i++) {
+      std::vector<uint64_t> cf_prefixes;
+      Status s = GetTableCacheKeyPrefixes(db->rep, column_families[i]->rep,
+                                          &cf_prefixes);
+      if (!s.ok()) {
+        return s;
+      }
+      prefixes.insert(cf_prefixes.begin(), cf_prefixes.end());
+    }
+    return Status::OK();
+  }
+
+  bool Take(const Slice& key, size_t bytes) {
+    if (!prefixes.empty()) {
+      uint64_t prefix;
+      if (key.size() < sizeof(prefix)) {
+        return false;
+      }
+      memcpy(&prefix, key.data(), sizeof(prefix));
+      if (prefixes.count(prefix) == 0) {
+        return false;
+      }
+    }
+    if (budget_bytes != 0 && taken_bytes + bytes > budget_bytes) {
+      return false;
+    }
+    taken_bytes += bytes;
+    return true;
+  }
+};
+
+// Shows a CacheDumper only the entries of the wanted roles that pass the
+// filter. The walk is not throttled since it holds each shard's lock.
+class FilteredDumpCache : public rocksdb::CacheWrapper {
+ public:
+  FilteredDumpCache(std::shared_ptr<Cache> target, uint32_t roles,
+                    CacheDumpFilter* filter)
+      : CacheWrapper(std::move(target)), roles_(roles), filter_(filter) {}
+
+  const char* Name() const override { return "FilteredDumpCache"; }
+
+  void ApplyToAllEntries(
+      const std::function<void(const Slice& key, ObjectPtr obj, size_t charge,
+                               const CacheItemHelper* helper)>& callback,
+      const ApplyToAllEntriesOptions& opts) override {
+    target_->ApplyToAllEntries(
+        [&](const Slice& key, ObjectPtr obj, size_t charge,
+            const CacheItemHelper* helper) {
+          CacheEntryRole role =
+              helper != nullptr ? helper->role : CacheEntryRole::kMisc;
+          if ((roles_ & (1u << static_cast<int>(role))) != 0 &&
+              filter_->Take(key, charge)) {
+            callback(key, obj, charge, helper);
+          }
+        },
+        opts);
+  }
+
+ private:
+  uint32_t roles_;
+  CacheDumpFilter* filter_;
+};
+
+// Passes the blocks a CacheDumpedLoader restores through the filter and the
+// rate limiter before inserting them into the secondary cache.
+class FilteredLoadSecondaryCache : public rocksdb::SecondaryCacheWrapper {
+ public:
+  FilteredLoadSecondaryCache(std::shared_ptr<SecondaryCache> target,
+                             std::shared_ptr<RateLimiter> rate_limiter,
+                             CacheDumpFilter* filter)
+      : SecondaryCacheWrapper(target),
+        cache_(std::move(target)),
+        rate_limiter_(std::move(rate_limiter)),
+        filter_(filter) {}
+
+  const char* Name() const override { return "FilteredLoadSecondaryCache"; }
+
+  Status InsertSaved(const Slice& key, const Slice& saved,
+                     CompressionType type,
+                     rocksdb::CacheTier source) override {
+    if (!filter_->Take(key, saved.size())) {
+      return Status::OK();
+    }
+    size_t remaining = saved.size();
+    while (rate_limiter_ != nullptr && remaining > 0) {
+      size_t bytes = std::min<size_t>(
+          remaining, static_cast<size_t>(rate_limiter_->GetSingleBurstBytes()));
+      // The overload without an op type charges regardless of the limiter's
+      // mode; the default kWritesOnly mode would let reads through.
+      rate_limiter_->Request(bytes, Env::IO_LOW, nullptr);
+      remaining -= bytes;
+    }
+    return cache_->InsertSaved(key, saved, type, source);
+  }
+
+ private:
+  std::shared_ptr<SecondaryCache> cache_;
+  std::shared_ptr<RateLimiter> rate_limiter_;
+  CacheDumpFilter* filter_;
+};
+
+crocksdb_cache_dump_options_t* crocksdb_cache_dump_options_create() {
+  return new crocksdb_cache_dump_options_t;
+}
+
+void crocksdb_cache_dump_options_destroy(crocksdb_cache_dump_options_t* opts) {
+  delete opts;
+}
+
+void crocksdb_cache_dump_options_set_budget_bytes(
+    crocksdb_cache_dump_options_t* opts, uint64_t budget_bytes) {
+  opts->budget_bytes = budget_bytes;
+}
+
+void crocksdb_cache_dump_options_set_roles(crocksdb_cache_dump_options_t* opts,
+                                           uint32_t roles) {
+  opts->roles = roles;
+}
+
+void crocksdb_cache_dump_options_set_rate_limiter(
+    crocksdb_cache_dump_options_t* opts, crocksdb_ratelimiter_t* limiter) {
+  opts->rate_limiter = limiter->rep;
+}
+
+void crocksdb_cache_dump(crocksdb_cache_t* cache, crocksdb_t* db,
+                         crocksdb_column_family_handle_t** column_families,
+                         size_t num_cfs, const char* path,
+                         const crocksdb_cache_dump_options_t* opts,
+                         char** errptr) {
+  if (db == nullptr) {
+    SaveError(errptr, Status::InvalidArgument("A DB is required to dump"));
+    return;
+  }
+  CacheDumpFilter filter;
+  if (SaveError(errptr, filter.Init(db, column_families, num_cfs, opts))) {
+    return;
+  }
+  std::unique_ptr<CacheDumpWriter> writer;
+  if (SaveError(errptr,
+                rocksdb::NewToFileCacheDumpWriter(
+                    FileSystem::Default(), FileOptions(), path, &writer))) {
+    return;
+  }
+  CacheDumpOptions dump_opts;
+  dump_opts.clock = SystemClock::Default().get();
+  std::unique_ptr<CacheDumper> dumper;
+  if (SaveError(errptr, rocksdb::NewDefaultCacheDumper(
+                            dump_opts,
+                            std::make_shared<FilteredDumpCache>(
+                                cache->rep, opts->roles, &filter),
+                            std::move(writer), &dumper))) {
+    return;
+  }
+  // The dumper drops every block whose table is not in its own filter, even
+  // when the filter is empty.
+  if (SaveError(errptr, dumper->SetDumpFilter({db->rep}))) {
+    return;
+  }
+  SaveError(errptr, dumper->DumpCacheEntriesToWriter());
+}
+
+void crocksdb_cache_load(crocksdb_secondary_cache_t* secondary_cache,
+                         const crocksdb_block_based_table_options_t* options,
+                         crocksdb_t* db,
+                         crocksdb_column_family_handle_t** column_families,
+                         size_t num_cfs, const char* path,
+                         const crocksdb_cache_dump_options_t* opts,
+                         char** errptr) {
+  CacheDumpFilter filter;
+  if (SaveError(errptr, filter.Init(db, column_families, num_cfs, opts))) {
+    return;
+  }
+  std::unique_ptr<CacheDumpReader> reader;
+  if (SaveError(errptr,
+                rocksdb::NewFromFileCacheDumpReader(
+                    FileSystem::Default(), FileOptions(), path, &reader))) {
+    return;
+  }
+  CacheDumpOptions dump_opts;
+  dump_opts.clock = SystemClock::Default().get();
+  std::unique_ptr<CacheDumpedLoader> loader;
+  if (SaveError(errptr, rocksdb::NewDefaultCacheDumpedLoader(
+                            dump_opts, options->rep,
+                            std::make_shared<FilteredLoadSecondaryCache>(
+                                secondary_cache->rep, opts->rate_limiter,
+                                &filter),
+                            std::move(reader), &loader))) {
+    return;
+  }
+  SaveError(errptr, loader->RestoreCacheEntriesToSecondaryCache());
+}
+
+// Reads a key range with an iterator that fills the block cache, so that its
+// data and index blocks are cached before the first user read.
+struct crocksdb_range_prefetch_t {
+  std::string start;
+  std::string end;
+  std::atomic<uint64_t> bytes_read{0};
+  std::atomic<uint64_t> keys{0};
+  std::atomic<bool> cancelled{false};
+  std::atomic<bool> done{false};
+  // Written by the worker before it sets `done`.
+  Status status;
+  std::thread worker;
+
+  void Run(DB* db, ColumnFamilyHandle* cf, size_t readahead_size,
+           uint64_t budget_bytes) {
+    ReadOptions opts;
+    opts.fill_cache = true;
+    opts.readahead_size = readahead_size;
+    // The range spans many prefixes, so the prefix extractor of the CF must
+    // not limit the seek or skip files whose filters miss the start key.
+    opts.total_order_seek = true;
+    // Only charged if the DB's rate limiter, if any, also limits reads.
+    opts.rate_limiter_priority = Env::IO_LOW;
+    Slice upper(end);
+    if (!end.empty()) {
+      opts.iterate_upper_bound = &upper;
+    }
+    const uint64_t base = rocksdb::get_iostats_context()->bytes_read;
+    std::unique_ptr<Iterator> it(db->NewIterator(opts, cf));
+    uint64_t n = 0;
+    for (it->Seek(start); it->Valid(); it->Next()) {
+      uint64_t read = rocksdb::get_iostats_context()->bytes_read - base;
+      bytes_read.store(read, std::memory_order_relaxed);
+      keys.store(++n, std::memory_order_relaxed);
+      if (cancelled.load(std::memory_order_relaxed) ||
+          (budget_bytes != 0 && read >= budget_bytes)) {
+        break;
+      }
+    }
+    bytes_read.store(rocksdb::get_iostats_context()->bytes_read - base,
+                     std::memory_order_relaxed);
+    status = it->status();
+    done.store(true, std::memory_order_release);
+  }
+};
+
+crocksdb_range_prefetch_t* crocksdb_range_prefetch_start(
+    crocksdb_t* db, crocksdb_column_family_handle_t* column_family,
+    const char* start_key, size_t start_key_len, const char* end_key,
+    size_t end_key_len, size_t readahead_size, uint64_t budget_bytes) {
+  auto prefetch = new crocksdb_range_prefetch_t;
+  prefetch->start.assign(start_key, start_key_len);
+  prefetch->end.assign(end_key, end_key_len);
+  DB* rep = db->rep;
+  ColumnFamilyHandle* cf = column_family->rep;
+  prefetch->worker = std::thread([=] {
+    prefetch->Run(rep, cf, readahead_size, budget_bytes);
+  });
+  return prefetch;
+}
+
+void crocksdb_range_prefetch_progress(crocksdb_range_prefetch_t* prefetch,
+                                      uint64_t* bytes_read, uint64_t* keys,
+                                      unsigned char* done) {
+  *done = prefetch->done.load(std::memory_order_acquire);
+  *bytes_read = prefetch->bytes_read.load(std::memory_order_relaxed);
+  *keys = prefetch->keys.load(std::memory_order_relaxed);
+}
+
+void crocksdb_range_prefetch_cancel(crocksdb_range_prefetch_t* prefetch) {
+  prefetch->cancelled.store(true, std::memory_order_relaxed);
+}
+
+void crocksdb_range_prefetch_wait(crocksdb_range_prefetch_t* prefetch,
+                                  char** errptr) {
+  if (prefetch->worker.joinable()) {
+    prefetch->worker.join();
+  }
+  SaveError(errptr, prefetch->status);
+}
+
+void crocksdb_range_prefetch_destroy(crocksdb_range_prefetch_t* prefetch) {
+  prefetch->cancelled.store(true, std::memory_order_relaxed);
+  if (prefetch->worker.joinable()) {
+    prefetch->worker.join();
+  }
+  delete prefetch;
+}
+
+/* background jobs */
+
+struct crocksdb_background_jobs_t {
+  std::vector<ThreadStatus> rep;
+};
+
+crocksdb_background_jobs_t* crocksdb_get_background_jobs(crocksdb_t* db,
+                                                         char** errptr) {
+  std::vector<ThreadStatus> threads;
+  if (SaveError(errptr, db->rep->GetEnv()->GetThreadList(&threads))) {
+    return nullptr;
+  }
+  // The thread list is shared by all DBs using the same Env.
+  const std::string& db_name = db->rep->GetName();
+  auto* jobs = new crocksdb_background_jobs_t;
+  for (auto& t : threads) {
+    if ((t.operation_type == ThreadStatus::OP_COMPACTION ||
+         t.operation_type == ThreadStatus::OP_FLUSH) &&
+        t.db_name == db_name) {
+      jobs->rep.push_back(std::move(t));
+    }
+  }
+  return jobs;
+}
+
+size_t crocksdb_background_jobs_count(const crocksdb_background_jobs_t* jobs) {
+  return jobs->rep.size();
+}
+
+void crocksdb_background_jobs_get(const crocksdb_background_jobs_t* jobs,
+                                  size_t index,
+                                  crocksdb_background_job_t* job) {
+  const ThreadStatus& t = jobs->rep[index];
+  const uint64_t* props = t.op_properties;
+  job->thread_id = t.thread_id;
+  job->thread_type = static_cast<int>(t.thread_type);
+  job->stage = static_cast<int>(t.operation_stage);
+  job->elapsed_micros = t.op_elapsed_micros;
+  if (t.operation_type == ThreadStatus::OP_COMPACTION) {
+    job->type = crocksdb_background_job_compaction;
+    job->job_id = props[ThreadStatus::COMPACTION_JOB_ID];
+    // The start level is stored in the upper and the output level in the
+    // lower 32 bits.
+    uint64_t levels = props[ThreadStatus::COMPACTION_INPUT_OUTPUT_LEVEL];
+    job->input_level = static_cast<int>(levels >> 32);
+    job->output_level = static_cast<int>(levels & 0xffffffff);
+    job->input_bytes = props[ThreadStatus::COMPACTION_TOTAL_INPUT_BYTES];
+    job->bytes_read = props[ThreadStatus::COMPACTION_BYTES_READ];
+    job->bytes_written = props[ThreadStatus::COMPACTION_BYTES_WRITTEN];
+  } else {
+    job->type = crocksdb_background_job_flush;
+    job->job_id = props[ThreadStatus::FLUSH_JOB_ID];
+    job->input_level = -1;
+    job->output_level = 0;
+    job->input_bytes = props[ThreadStatus::FLUSH_BYTES_MEMTABLES];
+    job->bytes_read = 0;
+    job->bytes_written = props[ThreadStatus::FLUSH_BYTES_WRITTEN];
+  }
+}
+
+const char* crocksdb_background_jobs_cf_name(
+    const crocksdb_background_jobs_t* jobs, size_t index, size_t* len) {
+  const std::string& name = jobs->rep[index].cf_name;
+  *len = name.size();
+  return name.data();
+}
+
+void crocksdb_background_jobs_destroy(crocksdb_background_jobs_t* jobs) {
+  delete jobs;
+}
+
+/* tracing */
+
+struct crocksdb_trace_options_t {
+  TraceOptions rep;
+};
+
+crocksdb_trace_options_t* crocksdb_trace_options_create() {
+  return new crocksdb_trace_options_t;
+}
+
+void crocksdb_trace_options_destroy(crocksdb_trace_options_t* opts) {
+  delete opts;
+}
+
+void crocksdb_trace_options_set_max_trace_file_size(
+    crocksdb_trace_options_t* opts, uint64_t size) {
+  opts->rep.max_trace_file_size = size;
+}
+
+void crocksdb_trace_options_set_sampling_frequency(
+    crocksdb_trace_options_t* opts, uint64_t frequency) {
+  opts->rep.sampling_frequency = frequency;
+}
+
+void crocksdb_trace_options_set_filter(crocksdb_trace_options_t* opts,
+                                       uint64_t filter) {
+  opts->rep.filter = filter;
+}
+
+static Status NewTraceWriter(crocksdb_t* db, const char* path,
+                             std::unique_ptr<TraceWriter>* writer) {
+  return NewFileTraceWriter(db->rep->GetEnv(), EnvOptions(), path, writer);
+}
+
+void crocksdb_start_trace(crocksdb_t* db, const char* path,
+                          const crocksdb_trace_options_t* opts,
+                          char** errptr) {
+  std::unique_ptr<TraceWriter> writer;
+  if (SaveError(errptr, NewTraceWriter(db, path, &writer))) {
+    return;
+  }
+  SaveError(errptr, db->rep->StartTrace(opts->rep, std::move(writer)));
+}
+
+void crocksdb_end_trace(crocksdb_t* db, char** errptr) {
+  SaveError(errptr, db->rep->EndTrace());
+}
+
+void crocksdb_start_block_cache_trace(crocksdb_t* db, const char* path,
+                                      const crocksdb_trace_options_t* opts,
+                                      char** errptr) {
+  std::unique_ptr<TraceWriter> writer;
+  if (SaveError(errptr, NewTraceWriter(db, path, &writer))) {
+    return;
+  }
+  SaveError(errptr,
+            db->rep->StartBlockCacheTrace(opts->rep, std::move(writer)));
+}
+
+void crocksdb_end_block_cache_trace(crocksdb_t* db, char** errptr) {
+  SaveError(errptr, db->rep->EndBlockCacheTrace());
 }
 
-void crocksdb_lru_cache_options_set_high_pri_pool_ratio(
-    crocksdb_lru_cache_options_t* opt, double high_pri_pool_ratio) {
-  opt->rep.high_pri_pool_ratio = high_pri_pool_ratio;
+void crocksdb_start_io_trace(crocksdb_t* db, const char* path,
+                             const crocksdb_trace_options_t* opts,
+                             char** errptr) {
+  std::unique_ptr<TraceWriter> writer;
+  if (SaveError(errptr, NewTraceWriter(db, path, &writer))) {
+    return;
+  }
+  SaveError(errptr, db->rep->StartIOTrace(opts->rep, std::move(writer)));
 }
 
-void crocksdb_lru_cache_options_set_low_pri_pool_ratio(
-    crocksdb_lru_cache_options_t* opt, double low_pri_pool_ratio) {
-  opt->rep.low_pri_pool_ratio = low_pri_pool_ratio;
+void crocksdb_end_io_trace(crocksdb_t* db, char** errptr) {
+  SaveError(errptr, db->rep->EndIOTrace());
 }
 
-void crocksdb_lru_cache_options_set_memory_allocator(
-    crocksdb_lru_cache_options_t* opt, crocksdb_memory_allocator_t* allocator) {
-  opt->rep.memory_allocator = allocator->rep;
+static int TracedOpOfTraceType(TraceType type) {
+  switch (type) {
+    case rocksdb::kTraceGet:
+      return crocksdb_traced_op_get;
+    case rocksdb::kTraceMultiGet:
+      return crocksdb_traced_op_multi_get;
+    case rocksdb::kTraceWrite:
+      return crocksdb_traced_op_write;
+    case rocksdb::kTraceIteratorSeek:
+    case rocksdb::kTraceIteratorSeekForPrev:
+      return crocksdb_traced_op_iter_seek;
+    default:
+      return -1;
+  }
 }
 
-crocksdb_cache_t* crocksdb_cache_create_lru(crocksdb_lru_cache_options_t* opt) {
-  crocksdb_cache_t* c = new crocksdb_cache_t;
-  c->rep = NewLRUCache(opt->rep);
-  return c;
+void crocksdb_replay_trace(crocksdb_t* db,
+                           crocksdb_column_family_handle_t** column_families,
+                           size_t num_cfs, const char* path,
+                           uint32_t num_threads, double speedup,
+                           crocksdb_op_latency_t* latencies, uint64_t* errors,
+                           char** errptr) {
+  std::vector<ColumnFamilyHandle*> handles;
+  for (size_t i = 0; i < num_cfs; i++) {
+    handles.push_back(column_families[i]->rep);
+  }
+  std::unique_ptr<TraceReader> reader;
+  Status s =
+      NewFileTraceReader(db->rep->GetEnv(), EnvOptions(), path, &reader);
+  std::unique_ptr<Replayer> replayer;
+  if (s.ok()) {
+    s = db->rep->NewDefaultReplayer(handles, std::move(reader), &replayer);
+  }
+  if (s.ok()) {
+    s = replayer->Prepare();
+  }
+  OpLatencyHistogram hists[crocksdb_traced_op_count];
+  std::atomic<uint64_t> failed{0};
+  if (s.ok()) {
+    static const uint64_t kNoPerf[OpLatencyHistogram::kNumPerfCounters] = {};
+    s = replayer->Replay(
+        ReplayOptions(num_threads, speedup),
+        [&](Status status, std::unique_ptr<TraceRecordResult>&& result) {
+          if (!status.ok()) {
+            failed.fetch_add(1, std::memory_order_relaxed);
+            return;
+          }
+          if (result == nullptr) {
+            return;
+          }
+          int op = TracedOpOfTraceType(result->GetTraceType());
+          if (op < 0) {
+            return;
+          }
+          // Every query record executes into a TraceExecutionResult.
+          auto* r = static_cast<TraceExecutionResult*>(result.get());
+          uint64_t micros = r->GetEndTimestamp() - r->GetStartTimestamp();
+          hists[op].Add(micros * 1000, kNoPerf);
+        });
+  }
+  for (int op = 0; op < crocksdb_traced_op_count; op++) {
+    memset(&latencies[op], 0, sizeof(latencies[op]));
+    hists[op].MergeInto(&latencies[op]);
+  }
+  *errors = failed.load(std::memory_order_relaxed);
+  SaveError(errptr, s);
 }
 
-crocksdb_hyper_clock_cache_options_t* crocksdb_hyper_clock_cache_options_create(
-    size_t capacity, size_t estimated_entry_charge) {
-  return new crocksdb_hyper_clock_cache_options_t{
-      HyperClockCacheOptions(capacity, estimated_entry_charge)};
+crocksdb_env_t* crocksdb_default_env_create() {
+  crocksdb_env_t* result = new crocksdb_env_t;
+  result->rep = Env::Default();
+  result->block_cipher = nullptr;
+  result->encryption_provider = nullptr;
+  result->is_default = true;
+  return result;
 }
 
-crocksdb_cache_t* crocksdb_hyper_clock_cache_options_make_shared_cache(
-    crocksdb_hyper_clock_cache_options_t* opts) {
-  crocksdb_cache_t* c = new crocksdb_cache_t;
-  c->rep = opts->rep.MakeSharedCache();
-  return c;
+#ifdef ROCKSDB_IOURING_PRESENT
+static std::atomic<bool> io_uring_enabled{true};
+
+// The POSIX file system only serves MultiRead and ReadAsync with io_uring when
+// the application defines this weak symbol and it returns true.
+bool RocksDbIOUringEnable() {
+  return io_uring_enabled.load(std::memory_order_relaxed);
 }
+#endif
 
-void crocksdb_cache_destroy(crocksdb_cache_t* cache) { delete cache; }
+unsigned char crocksdb_io_uring_supported() {
+#ifdef ROCKSDB_IOURING_PRESENT
+  // The kernel may lack io_uring or forbid it (e.g. by seccomp), in which
+  // case the file system falls back to synchronous reads.
+  static const bool kernel_supported = [] {
+    struct io_uring ring;
+    if (io_uring_queue_init(1, &ring, 0) != 0) {
+      return false;
+    }
+    io_uring_queue_exit(&ring);
+    return true;
+  }();
+  return kernel_supported && io_uring_enabled.load(std::memory_order_relaxed);
+#else
+  return false;
+#endif
+}
 
-void crocksdb_cache_set_capacity(crocksdb_cache_t* cache, size_t capacity) {
-  cache->rep->SetCapacity(capacity);
+void crocksdb_set_io_uring_enabled(unsigned char enabled) {
+#ifdef ROCKSDB_IOURING_PRESENT
+  io_uring_enabled.store(enabled, std::memory_order_relaxed);
+#else
+  (void)enabled;
+#endif
 }
 
-crocksdb_env_t* crocksdb_default_env_create() {
+// The encrypted and inspected file systems wrap each file in a class that
+// serves MultiRead and ReadAsync with one blocking Read at a time, so batched
+// and asynchronous reads would never reach io_uring. This file system leaves
+// everything to such a `target` except opening random access files: those
+// are opened on `base`, the file system `target` wraps, and `wrap` gives them
+// the decryption or accounting of `target` in a file that forwards batched
+// and asynchronous reads.
+class ParallelReadFileSystem : public rocksdb::FileSystemWrapper {
+ public:
+  using WrapFn = std::function<IOStatus(
+      const std::string& fname, const FileOptions& opts,
+      std::unique_ptr<FSRandomAccessFile>* file)>;
+
+  ParallelReadFileSystem(const std::shared_ptr<FileSystem>& target,
+                         std::shared_ptr<FileSystem> base, WrapFn wrap)
+      : FileSystemWrapper(target),
+        base_(std::move(base)),
+        wrap_(std::move(wrap)) {}
+
+  const char* Name() const override { return "ParallelReadFileSystem"; }
+
+  IOStatus NewRandomAccessFile(const std::string& fname,
+                               const FileOptions& opts,
+                               std::unique_ptr<FSRandomAccessFile>* result,
+                               IODebugContext* dbg) override {
+    // Mapped reads issue no IO, and can't be decrypted in place.
+    if (opts.use_mmap_reads) {
+      return target()->NewRandomAccessFile(fname, opts, result, dbg);
+    }
+    std::unique_ptr<FSRandomAccessFile> file;
+    IOStatus s = base_->NewRandomAccessFile(fname, opts, &file, dbg);
+    if (s.ok()) {
+      s = wrap_(fname, opts, &file);
+    }
+    if (s.ok()) {
+      *result = std::move(file);
+    }
+    return s;
+  }
+
+ private:
+  std::shared_ptr<FileSystem> base_;
+  WrapFn wrap_;
+};
+
+// Returns an env that reads random access files through `fs`, taking
+// ownership of `wrapped`, the env whose file system `fs` wraps.
+static crocksdb_env_t* NewParallelReadEnv(
+    crocksdb_env_t* base_env, Env* wrapped,
+    ParallelReadFileSystem::WrapFn wrap) {
+  auto fs = std::make_shared<ParallelReadFileSystem>(
+      wrapped->GetFileSystem(), base_env->rep->GetFileSystem(),
+      std::move(wrap));
   crocksdb_env_t* result = new crocksdb_env_t;
-  result->rep = Env::Default();
+  result->rep = new rocksdb::CompositeEnvWrapper(base_env->rep, fs);
+  result->wrapped.reset(wrapped);
   result->block_cipher = nullptr;
   result->encryption_provider = nullptr;
-  result->is_default = true;
+  result->is_default = false;
   return result;
 }
 
+// Decrypts what the file at the end of `target` returns, like the encrypted
+// file system's own files, but forwards batched and asynchronous reads.
+class DecryptedRandomAccessFile : public FSRandomAccessFileOwnerWrapper {
+ public:
+  DecryptedRandomAccessFile(std::unique_ptr<FSRandomAccessFile>&& target,
+                            std::unique_ptr<BlockAccessCipherStream>&& stream,
+                            size_t prefix_len)
+      : FSRandomAccessFileOwnerWrapper(std::move(target)),
+        stream_(std::move(stream)),
+        prefix_len_(prefix_len) {}
+
+  // Opens the cipher stream of `*file`, reading its prefix if `provider`
+  // writes one, and wraps it.
+  static IOStatus Wrap(EncryptionProvider* provider, const std::string& fname,
+                       const FileOptions& opts,
+                       std::unique_ptr<FSRandomAccessFile>* file) {
+    size_t prefix_len = provider->GetPrefixLength();
+    rocksdb::AlignedBuffer buffer;
+    Slice prefix;
+    if (prefix_len > 0) {
+      buffer.Alignment((*file)->GetRequiredBufferAlignment());
+      buffer.AllocateNewBuffer(prefix_len);
+      IOStatus s = (*file)->Read(0, prefix_len, opts.io_options, &prefix,
+                                 buffer.BufferStart(), nullptr);
+      if (!s.ok()) {
+        return s;
+      }
+      buffer.Size(prefix_len);
+    }
+    std::unique_ptr<BlockAccessCipherStream> stream;
+    IOStatus s = rocksdb::status_to_io_status(
+        provider->CreateCipherStream(fname, opts, prefix, &stream));
+    if (s.ok()) {
+      file->reset(new DecryptedRandomAccessFile(std::move(*file),
+                                                std::move(stream), prefix_len));
+    }
+    return s;
+  }
+
+  IOStatus Read(uint64_t offset, size_t n, const IOOptions& options,
+                Slice* result, char* scratch,
+                IODebugContext* dbg) const override {
+    IOStatus s =
+        target()->Read(offset + prefix_len_, n, options, result, scratch, dbg);
+    if (s.ok()) {
+      s = Decrypt(offset, *result);
+    }
+    return s;
+  }
+
+  IOStatus MultiRead(FSReadRequest* reqs, size_t num_reqs,
+                     const IOOptions& options, IODebugContext* dbg) override {
+    for (size_t i = 0; i < num_reqs; i++) {
+      reqs[i].offset += prefix_len_;
+    }
+    IOStatus s = target()->MultiRead(reqs, num_reqs, options, dbg);
+    for (size_t i = 0; i < num_reqs; i++) {
+      reqs[i].offset -= prefix_len_;
+      if (s.ok() && reqs[i].status.ok()) {
+        reqs[i].status = Decrypt(reqs[i].offset, reqs[i].result);
+      }
+    }
+    return s;
+  }
+
+  IOStatus ReadAsync(FSReadRequest& req, const IOOptions& opts,
+                     std::function<void(const FSReadRequest&, void*)> cb,
+                     void* cb_arg, void** io_handle, IOHandleDeleter* del_fn,
+                     IODebugContext* dbg) override {
+    uint64_t offset = req.offset;
+    req.offset += prefix_len_;
+    // Decrypts on completion and reports the request at its own offset.
+    auto decrypt_cb = [this, offset, cb](const FSReadRequest& done,
+                                         void* arg) {
+      FSReadRequest decrypted;
+      decrypted.offset = offset;
+      decrypted.len = done.len;
+      decrypted.scratch = done.scratch;
+      decrypted.result = done.result;
+      decrypted.status = done.status;
+      if (decrypted.status.ok()) {
+        decrypted.status = Decrypt(offset, decrypted.result);
+      }
+      cb(decrypted, arg);
+    };
+    IOStatus s = target()->ReadAsync(req, opts, decrypt_cb, cb_arg, io_handle,
+                                     del_fn, dbg);
+    req.offset = offset;
+    return s;
+  }
+
+  IOStatus Prefetch(uint64_t offset, size_t n, const IOOptions& options,
+                    IODebugContext* dbg) override {
+    return target()->Prefetch(offset + prefix_len_, n, options, dbg);
+  }
+
+  IOStatus InvalidateCache(size_t offset, size_t length) override {
+    return target()->InvalidateCache(offset + prefix_len_, length);
+  }
+
+ private:
+  IOStatus Decrypt(uint64_t offset, const Slice& data) const {
+    return rocksdb::status_to_io_status(stream_->Decrypt(
+        offset, const_cast<char*>(data.data()), data.size()));
+  }
+
+  std::unique_ptr<BlockAccessCipherStream> stream_;
+  size_t prefix_len_;
+};
+
 crocksdb_env_t* crocksdb_mem_env_create() {
   crocksdb_env_t* result = new crocksdb_env_t;
   result->rep = rocksdb::NewMemEnv(Env::Default());
@@ -4245,6 +6858,21 @@ crocksdb_env_t* crocksdb_mem_env_create() {
   return result;
 }
 
+// XORs `src` into `dst` a word at a time, which compilers vectorize.
+static void XorBytes(char* dst, const char* src, size_t n) {
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= n; i += sizeof(uint64_t)) {
+    uint64_t a, b;
+    memcpy(&a, dst + i, sizeof(a));
+    memcpy(&b, src + i, sizeof(b));
+    a ^= b;
+    memcpy(dst + i, &a, sizeof(a));
+  }
+  for (; i < n; i++) {
+    dst[i] ^= src[i];
+  }
+}
+
 struct CTRBlockCipher : public BlockCipher {
   CTRBlockCipher(size_t block_size, const std::string& cipertext)
       : block_size_(block_size), cipertext_(cipertext) {
@@ -4256,11 +6884,7 @@ struct CTRBlockCipher : public BlockCipher {
   size_t BlockSize() override { return block_size_; }
 
   Status Encrypt(char* data) override {
-    const char* ciper_ptr = cipertext_.c_str();
-    for (size_t i = 0; i < block_size_; i++) {
-      data[i] = data[i] ^ ciper_ptr[i];
-    }
-
+    XorBytes(data, cipertext_.data(), block_size_);
     return Status::OK();
   }
 
@@ -4274,17 +6898,94 @@ struct CTRBlockCipher : public BlockCipher {
   size_t block_size_;
 };
 
+// Produces the same output as CTRCipherStream, but builds the keystream for a
+// whole range of blocks at once and XORs it into the buffer in one pass,
+// instead of calling the block cipher and XORing once per block.
+class XorCTRCipherStream : public CTRCipherStream {
+ public:
+  XorCTRCipherStream(const std::shared_ptr<CTRBlockCipher>& cipher,
+                     const char* iv, uint64_t initial_counter)
+      : CTRCipherStream(cipher, iv, initial_counter),
+        cipher_(cipher),
+        iv_(iv, cipher->BlockSize()),
+        initial_counter_(initial_counter) {}
+
+  Status Encrypt(uint64_t file_offset, char* data, size_t data_size) override {
+    const size_t block_size = iv_.size();
+    if (block_size < sizeof(uint64_t)) {
+      return CTRCipherStream::Encrypt(file_offset, data, data_size);
+    }
+    const size_t blocks_per_chunk =
+        std::max<size_t>(kKeystreamBytes / block_size, 1);
+    std::string keystream;
+    while (data_size > 0) {
+      uint64_t block = file_offset / block_size;
+      size_t skip = file_offset % block_size;
+      size_t blocks = std::min(
+          blocks_per_chunk, (skip + data_size + block_size - 1) / block_size);
+      keystream.resize(blocks * block_size);
+      for (size_t i = 0; i < blocks; i++) {
+        char* k = &keystream[i * block_size];
+        memcpy(k, iv_.data(), block_size);
+        EncodeFixed64(k, block + i + initial_counter_);
+        cipher_->Encrypt(k);
+      }
+      size_t n = std::min(data_size, keystream.size() - skip);
+      XorBytes(data, keystream.data() + skip, n);
+      file_offset += n;
+      data += n;
+      data_size -= n;
+    }
+    return Status::OK();
+  }
+
+  Status Decrypt(uint64_t file_offset, char* data, size_t data_size) override {
+    return Encrypt(file_offset, data, data_size);
+  }
+
+ private:
+  static constexpr size_t kKeystreamBytes = 16 << 10;
+
+  std::shared_ptr<CTRBlockCipher> cipher_;
+  std::string iv_;
+  uint64_t initial_counter_;
+};
+
+class XorCTREncryptionProvider : public CTREncryptionProvider {
+ public:
+  explicit XorCTREncryptionProvider(
+      const std::shared_ptr<CTRBlockCipher>& cipher)
+      : CTREncryptionProvider(cipher), cipher_(cipher) {}
+
+ protected:
+  Status CreateCipherStreamFromPrefix(
+      const std::string& /*fname*/, const EnvOptions& /*options*/,
+      uint64_t initial_counter, const Slice& iv, const Slice& /*prefix*/,
+      std::unique_ptr<BlockAccessCipherStream>* result) override {
+    result->reset(
+        new XorCTRCipherStream(cipher_, iv.data(), initial_counter));
+    return Status::OK();
+  }
+
+ private:
+  std::shared_ptr<CTRBlockCipher> cipher_;
+};
+
 crocksdb_env_t* crocksdb_ctr_encrypted_env_create(crocksdb_env_t* base_env,
                                                   const char* ciphertext,
                                                   size_t ciphertext_len) {
-  auto result = new crocksdb_env_t;
-  result->block_cipher = std::make_shared<CTRBlockCipher>(
+  auto cipher = std::make_shared<CTRBlockCipher>(
       ciphertext_len, std::string(ciphertext, ciphertext_len));
-  result->encryption_provider =
-      EncryptionProvider::NewCTRProvider(result->block_cipher);
-  result->rep = NewEncryptedEnv(base_env->rep, result->encryption_provider);
-  result->is_default = false;
-
+  auto provider = std::make_shared<XorCTREncryptionProvider>(cipher);
+  crocksdb_env_t* result = NewParallelReadEnv(
+      base_env, NewEncryptedEnv(base_env->rep, provider),
+      [provider](const std::string& fname, const FileOptions& opts,
+                 std::unique_ptr<FSRandomAccessFile>* file) {
+        return DecryptedRandomAccessFile::Wrap(provider.get(), fname, opts,
+                                               file);
+      });
+  result->block_cipher = cipher;
+  result->encryption_provider = provider;
   return result;
 }
 
@@ -4469,6 +7170,90 @@ void crocksdb_file_encryption_info_set_iv(
   file_info->rep->iv = std::string(iv, ivlen);
 }
 
+// Bounded LRU cache of the encryption info of files, split into shards by file
+// name. Every invalidation bumps the shard's version, so that a lookup that
+// raced with it doesn't insert stale info.
+class FileEncryptionInfoCache {
+ public:
+  explicit FileEncryptionInfoCache(size_t capacity)
+      : shard_capacity_(std::max<size_t>(
+            (capacity + kShards - 1) / kShards, 1)) {}
+
+  bool Lookup(const std::string& fname, FileEncryptionInfo* info) {
+    Shard& shard = GetShard(fname);
+    std::lock_guard<std::mutex> lock(shard.mu);
+    auto it = shard.map.find(fname);
+    if (it == shard.map.end()) {
+      misses.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+    *info = it->second->second;
+    hits.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  uint64_t Version(const std::string& fname) {
+    Shard& shard = GetShard(fname);
+    std::lock_guard<std::mutex> lock(shard.mu);
+    return shard.version;
+  }
+
+  // Inserts `info` unless the shard was invalidated since `version`.
+  void Insert(const std::string& fname, const FileEncryptionInfo& info,
+              uint64_t version) {
+    Shard& shard = GetShard(fname);
+    std::lock_guard<std::mutex> lock(shard.mu);
+    if (shard.version != version) {
+      return;
+    }
+    auto it = shard.map.find(fname);
+    if (it != shard.map.end()) {
+      it->second->second = info;
+      shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+      return;
+    }
+    shard.lru.emplace_front(fname, info);
+    shard.map[fname] = shard.lru.begin();
+    if (shard.map.size() > shard_capacity_) {
+      shard.map.erase(shard.lru.back().first);
+      shard.lru.pop_back();
+    }
+  }
+
+  void Erase(const std::string& fname) {
+    Shard& shard = GetShard(fname);
+    std::lock_guard<std::mutex> lock(shard.mu);
+    shard.version++;
+    auto it = shard.map.find(fname);
+    if (it != shard.map.end()) {
+      shard.lru.erase(it->second);
+      shard.map.erase(it);
+    }
+  }
+
+  std::atomic<uint64_t> hits{0};
+  std::atomic<uint64_t> misses{0};
+
+ private:
+  static constexpr size_t kShards = 16;
+
+  struct Shard {
+    using Entry = std::pair<std::string, FileEncryptionInfo>;
+    std::mutex mu;
+    std::list<Entry> lru;
+    std::unordered_map<std::string, std::list<Entry>::iterator> map;
+    uint64_t version = 0;
+  };
+
+  Shard& GetShard(const std::string& fname) {
+    return shards_[std::hash<std::string>()(fname) % kShards];
+  }
+
+  const size_t shard_capacity_;
+  Shard shards_[kShards];
+};
+
 struct crocksdb_encryption_key_manager_impl_t : public KeyManager {
   void* state;
   void (*destructor)(void*);
@@ -4476,11 +7261,20 @@ struct crocksdb_encryption_key_manager_impl_t : public KeyManager {
   crocksdb_encryption_key_manager_new_file_cb new_file;
   crocksdb_encryption_key_manager_delete_file_cb delete_file;
   crocksdb_encryption_key_manager_link_file_cb link_file;
+  // Set before the key manager is used, if at all.
+  std::unique_ptr<FileEncryptionInfoCache> cache;
 
   virtual ~crocksdb_encryption_key_manager_impl_t() { destructor(state); }
 
   Status GetFile(const std::string& fname,
                  FileEncryptionInfo* file_info) override {
+    uint64_t version = 0;
+    if (cache) {
+      if (cache->Lookup(fname, file_info)) {
+        return Status::OK();
+      }
+      version = cache->Version(fname);
+    }
     crocksdb_file_encryption_info_t info;
     info.rep = file_info;
     const char* ret = get_file(state, fname.c_str(), &info);
@@ -4488,6 +7282,8 @@ struct crocksdb_encryption_key_manager_impl_t : public KeyManager {
     if (ret != nullptr) {
       s = Status::Corruption(std::string(ret));
       delete ret;
+    } else if (cache) {
+      cache->Insert(fname, *file_info, version);
     }
     return s;
   }
@@ -4497,6 +7293,11 @@ struct crocksdb_encryption_key_manager_impl_t : public KeyManager {
     crocksdb_file_encryption_info_t info;
     info.rep = file_info;
     const char* ret = new_file(state, fname.c_str(), &info);
+    // Only after the host replaced the info, so that a concurrent GetFile
+    // can't cache the old one again.
+    if (cache) {
+      cache->Erase(fname);
+    }
     Status s;
     if (ret != nullptr) {
       s = Status::Corruption(std::string(ret));
@@ -4507,6 +7308,9 @@ struct crocksdb_encryption_key_manager_impl_t : public KeyManager {
 
   Status DeleteFile(const std::string& fname) override {
     const char* ret = delete_file(state, fname.c_str(), nullptr);
+    if (cache) {
+      cache->Erase(fname);
+    }
     Status s;
     if (ret != nullptr) {
       s = Status::Corruption(std::string(ret));
@@ -4518,6 +7322,9 @@ struct crocksdb_encryption_key_manager_impl_t : public KeyManager {
   Status LinkFile(const std::string& src_fname,
                   const std::string& dst_fname) override {
     const char* ret = link_file(state, src_fname.c_str(), dst_fname.c_str());
+    if (cache) {
+      cache->Erase(dst_fname);
+    }
     Status s;
     if (ret != nullptr) {
       s = Status::Corruption(std::string(ret));
@@ -4529,6 +7336,9 @@ struct crocksdb_encryption_key_manager_impl_t : public KeyManager {
   Status DeleteFileExt(const std::string& fname,
                        const std::string& physical_fname) override {
     const char* ret = delete_file(state, fname.c_str(), physical_fname.c_str());
+    if (cache) {
+      cache->Erase(fname);
+    }
     Status s;
     if (ret != nullptr) {
       s = Status::Corruption(std::string(ret));
@@ -4563,6 +7373,36 @@ void crocksdb_encryption_key_manager_destroy(
   delete key_manager;
 }
 
+static crocksdb_encryption_key_manager_impl_t* GetKeyManagerImpl(
+    crocksdb_encryption_key_manager_t* key_manager) {
+  // Key managers are only created by crocksdb_encryption_key_manager_create.
+  return static_cast<crocksdb_encryption_key_manager_impl_t*>(
+      key_manager->rep.get());
+}
+
+void crocksdb_encryption_key_manager_enable_cache(
+    crocksdb_encryption_key_manager_t* key_manager, size_t capacity) {
+  GetKeyManagerImpl(key_manager)
+      ->cache.reset(new FileEncryptionInfoCache(capacity));
+}
+
+void crocksdb_encryption_key_manager_invalidate_cache(
+    crocksdb_encryption_key_manager_t* key_manager, const char* fname) {
+  auto impl = GetKeyManagerImpl(key_manager);
+  if (impl->cache) {
+    impl->cache->Erase(fname);
+  }
+}
+
+void crocksdb_encryption_key_manager_cache_stats(
+    crocksdb_encryption_key_manager_t* key_manager, uint64_t* hits,
+    uint64_t* misses) {
+  auto impl = GetKeyManagerImpl(key_manager);
+  *hits = impl->cache ? impl->cache->hits.load(std::memory_order_relaxed) : 0;
+  *misses =
+      impl->cache ? impl->cache->misses.load(std::memory_order_relaxed) : 0;
+}
+
 const char* crocksdb_encryption_key_manager_get_file(
     crocksdb_encryption_key_manager_t* key_manager, const char* fname,
     crocksdb_file_encryption_info_t* file_info) {
@@ -4630,12 +7470,22 @@ crocksdb_env_t* crocksdb_key_managed_encrypted_env_create(
     crocksdb_env_t* base_env, crocksdb_encryption_key_manager_t* key_manager) {
   assert(base_env != nullptr);
   assert(key_manager != nullptr);
-  crocksdb_env_t* result = new crocksdb_env_t;
-  result->rep = NewKeyManagedEncryptedEnv(base_env->rep, key_manager->rep);
-  result->block_cipher = nullptr;
-  result->encryption_provider = nullptr;
-  result->is_default = false;
-  return result;
+  std::shared_ptr<KeyManager> manager = key_manager->rep;
+  auto provider = std::make_shared<AESEncryptionProvider>(manager.get());
+  return NewParallelReadEnv(
+      base_env, NewKeyManagedEncryptedEnv(base_env->rep, key_manager->rep),
+      [manager, provider](const std::string& fname, const FileOptions& opts,
+                          std::unique_ptr<FSRandomAccessFile>* file) {
+        // Like the key managed file system, reads plaintext files as is.
+        FileEncryptionInfo info;
+        IOStatus s =
+            rocksdb::status_to_io_status(manager->GetFile(fname, &info));
+        if (!s.ok() || info.method == EncryptionMethod::kPlaintext) {
+          return s;
+        }
+        return DecryptedRandomAccessFile::Wrap(provider.get(), fname, opts,
+                                               file);
+      });
 }
 #endif
 
@@ -4697,34 +7547,298 @@ void crocksdb_file_system_inspector_destroy(
   delete inspector;
 }
 
-size_t crocksdb_file_system_inspector_read(
-    crocksdb_file_system_inspector_t* inspector, size_t len, char** errptr) {
-  assert(inspector != nullptr && inspector->rep != nullptr);
-  size_t allowed = 0;
-  SaveError(errptr, inspector->rep->Read(len, &allowed));
-  return allowed;
+size_t crocksdb_file_system_inspector_read(
+    crocksdb_file_system_inspector_t* inspector, size_t len, char** errptr) {
+  assert(inspector != nullptr && inspector->rep != nullptr);
+  size_t allowed = 0;
+  SaveError(errptr, inspector->rep->Read(len, &allowed));
+  return allowed;
+}
+
+size_t crocksdb_file_system_inspector_write(
+    crocksdb_file_system_inspector_t* inspector, size_t len, char** errptr) {
+  assert(inspector != nullptr && inspector->rep != nullptr);
+  size_t allowed = 0;
+  SaveError(errptr, inspector->rep->Write(len, &allowed));
+  return allowed;
+}
+
+// Charges reads to the inspector, like the inspected file system's own files,
+// but charges a batch at once and forwards it as a batch.
+class InspectedRandomAccessFile : public FSRandomAccessFileOwnerWrapper {
+ public:
+  InspectedRandomAccessFile(std::unique_ptr<FSRandomAccessFile>&& target,
+                            std::shared_ptr<FileSystemInspector> inspector)
+      : FSRandomAccessFileOwnerWrapper(std::move(target)),
+        inspector_(std::move(inspector)) {}
+
+  IOStatus Read(uint64_t offset, size_t n, const IOOptions& options,
+                Slice* result, char* scratch,
+                IODebugContext* dbg) const override {
+    IOStatus s = Charge(n);
+    if (s.ok()) {
+      s = target()->Read(offset, n, options, result, scratch, dbg);
+    }
+    return s;
+  }
+
+  IOStatus MultiRead(FSReadRequest* reqs, size_t num_reqs,
+                     const IOOptions& options, IODebugContext* dbg) override {
+    size_t len = 0;
+    for (size_t i = 0; i < num_reqs; i++) {
+      len += reqs[i].len;
+    }
+    IOStatus s = Charge(len);
+    if (s.ok()) {
+      s = target()->MultiRead(reqs, num_reqs, options, dbg);
+    }
+    return s;
+  }
+
+  IOStatus ReadAsync(FSReadRequest& req, const IOOptions& opts,
+                     std::function<void(const FSReadRequest&, void*)> cb,
+                     void* cb_arg, void** io_handle, IOHandleDeleter* del_fn,
+                     IODebugContext* dbg) override {
+    IOStatus s = Charge(req.len);
+    if (s.ok()) {
+      s = target()->ReadAsync(req, opts, cb, cb_arg, io_handle, del_fn, dbg);
+    }
+    return s;
+  }
+
+ private:
+  // Blocks until the inspector has allowed all `len` bytes.
+  IOStatus Charge(size_t len) const {
+    while (len > 0) {
+      size_t allowed = 0;
+      Status s = inspector_->Read(len, &allowed);
+      if (!s.ok()) {
+        return rocksdb::status_to_io_status(std::move(s));
+      }
+      len -= std::min(allowed, len);
+    }
+    return IOStatus::OK();
+  }
+
+  std::shared_ptr<FileSystemInspector> inspector_;
+};
+
+crocksdb_env_t* crocksdb_file_system_inspected_env_create(
+    crocksdb_env_t* base_env, crocksdb_file_system_inspector_t* inspector) {
+  assert(base_env != nullptr);
+  assert(inspector != nullptr);
+  std::shared_ptr<FileSystemInspector> rep = inspector->rep;
+  return NewParallelReadEnv(
+      base_env, NewFileSystemInspectedEnv(base_env->rep, rep),
+      [rep](const std::string& /*fname*/, const FileOptions& /*opts*/,
+            std::unique_ptr<FSRandomAccessFile>* file) {
+        file->reset(new InspectedRandomAccessFile(std::move(*file), rep));
+        return IOStatus::OK();
+      });
+}
+
+static thread_local int thread_io_priority = crocksdb_io_priority_normal;
+
+// Token buckets, one per IO type and priority, that throttle the inspected
+// env without calling into the host. Tokens are spread over cache-line
+// aligned shards so that concurrent IO mostly touches different atomics.
+class TokenBucketInspector : public FileSystemInspector {
+ public:
+  static constexpr int kNumOps = crocksdb_file_io_write + 1;
+  static constexpr int kNumPriorities = crocksdb_io_priority_high + 1;
+
+  struct Counters {
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<uint64_t> requests{0};
+    std::atomic<uint64_t> wait_micros{0};
+  };
+
+  class Bucket {
+   public:
+    void SetRate(int64_t bytes_per_sec) {
+      rate_.store(bytes_per_sec, std::memory_order_relaxed);
+    }
+
+    int64_t GetRate() const { return rate_.load(std::memory_order_relaxed); }
+
+    // Blocks until at least one byte is available and returns how many of
+    // `len` bytes may be transferred.
+    size_t Acquire(size_t len) {
+      counters.requests.fetch_add(1, std::memory_order_relaxed);
+      uint64_t start = 0;
+      size_t granted = 0;
+      while (true) {
+        int64_t rate = GetRate();
+        if (rate <= 0) {
+          granted = len;
+          break;
+        }
+        uint64_t now = Env::Default()->NowMicros();
+        Refill(rate, now);
+        granted = Take(len);
+        if (granted > 0) {
+          break;
+        }
+        if (start == 0) {
+          start = now;
+        }
+        Env::Default()->SleepForMicroseconds(kRefillPeriodUs);
+      }
+      if (start != 0) {
+        counters.wait_micros.fetch_add(Env::Default()->NowMicros() - start,
+                                       std::memory_order_relaxed);
+      }
+      counters.bytes.fetch_add(granted, std::memory_order_relaxed);
+      return granted;
+    }
+
+    Counters counters;
+
+   private:
+    static constexpr uint64_t kRefillPeriodUs = 1000;
+    // Tokens accumulate for at most this long while the bucket is idle.
+    static constexpr uint64_t kBurstUs = 100 * 1000;
+    static constexpr size_t kShards = 16;
+
+    struct alignas(64) Shard {
+      std::atomic<int64_t> tokens{0};
+    };
+
+    void Refill(int64_t rate, uint64_t now) {
+      uint64_t last = last_refill_us_.load(std::memory_order_relaxed);
+      if (now < last + kRefillPeriodUs ||
+          !last_refill_us_.compare_exchange_strong(
+              last, now, std::memory_order_relaxed)) {
+        return;
+      }
+      uint64_t elapsed = std::min(now - last, kBurstUs);
+      int64_t total = static_cast<int64_t>(
+          static_cast<double>(rate) * static_cast<double>(elapsed) / 1e6);
+      int64_t cap = std::max<int64_t>(
+          static_cast<int64_t>(static_cast<double>(rate) * kBurstUs / 1e6 /
+                               kShards),
+          1);
+      for (size_t i = 0; i < kShards; i++) {
+        int64_t add = total / static_cast<int64_t>(kShards) +
+                      (i == 0 ? total % static_cast<int64_t>(kShards) : 0);
+        int64_t cur = shards_[i].tokens.load(std::memory_order_relaxed);
+        int64_t next;
+        do {
+          next = std::min(cur + add, cap);
+        } while (!shards_[i].tokens.compare_exchange_weak(
+            cur, next, std::memory_order_relaxed));
+      }
+    }
+
+    // Takes tokens from this thread's shard first, then from the others.
+    size_t Take(size_t len) {
+      static thread_local size_t home = std::hash<std::thread::id>()(
+                                            std::this_thread::get_id()) %
+                                        kShards;
+      for (size_t i = 0; i < kShards; i++) {
+        Shard& shard = shards_[(home + i) % kShards];
+        int64_t cur = shard.tokens.load(std::memory_order_relaxed);
+        while (cur > 0) {
+          int64_t take = std::min(cur, static_cast<int64_t>(len));
+          if (shard.tokens.compare_exchange_weak(cur, cur - take,
+                                                 std::memory_order_relaxed)) {
+            return static_cast<size_t>(take);
+          }
+        }
+      }
+      return 0;
+    }
+
+    std::atomic<int64_t> rate_{0};
+    std::atomic<uint64_t> last_refill_us_{0};
+    Shard shards_[kShards];
+  };
+
+  Status Read(size_t len, size_t* allowed) override {
+    *allowed = Get(crocksdb_file_io_read).Acquire(len);
+    return Status::OK();
+  }
+
+  Status Write(size_t len, size_t* allowed) override {
+    *allowed = Get(crocksdb_file_io_write).Acquire(len);
+    return Status::OK();
+  }
+
+  Bucket buckets[kNumOps][kNumPriorities];
+
+ private:
+  Bucket& Get(int op) {
+    int priority = thread_io_priority;
+    if (priority < 0 || priority >= kNumPriorities) {
+      priority = crocksdb_io_priority_normal;
+    }
+    return buckets[op][priority];
+  }
+};
+
+struct crocksdb_token_bucket_inspector_t {
+  std::shared_ptr<TokenBucketInspector> rep =
+      std::make_shared<TokenBucketInspector>();
+};
+
+static TokenBucketInspector::Bucket* GetTokenBucket(
+    const crocksdb_token_bucket_inspector_t* inspector, int op, int priority) {
+  if (op < 0 || op >= TokenBucketInspector::kNumOps || priority < 0 ||
+      priority >= TokenBucketInspector::kNumPriorities) {
+    return nullptr;
+  }
+  return &inspector->rep->buckets[op][priority];
+}
+
+crocksdb_token_bucket_inspector_t* crocksdb_token_bucket_inspector_create() {
+  return new crocksdb_token_bucket_inspector_t;
+}
+
+void crocksdb_token_bucket_inspector_destroy(
+    crocksdb_token_bucket_inspector_t* inspector) {
+  delete inspector;
+}
+
+void crocksdb_token_bucket_inspector_set_rate(
+    crocksdb_token_bucket_inspector_t* inspector, int op, int priority,
+    int64_t bytes_per_sec) {
+  auto bucket = GetTokenBucket(inspector, op, priority);
+  if (bucket != nullptr) {
+    bucket->SetRate(bytes_per_sec);
+  }
+}
+
+int64_t crocksdb_token_bucket_inspector_get_rate(
+    const crocksdb_token_bucket_inspector_t* inspector, int op, int priority) {
+  auto bucket = GetTokenBucket(inspector, op, priority);
+  return bucket == nullptr ? 0 : bucket->GetRate();
 }
 
-size_t crocksdb_file_system_inspector_write(
-    crocksdb_file_system_inspector_t* inspector, size_t len, char** errptr) {
-  assert(inspector != nullptr && inspector->rep != nullptr);
-  size_t allowed = 0;
-  SaveError(errptr, inspector->rep->Write(len, &allowed));
-  return allowed;
+void crocksdb_token_bucket_inspector_counters(
+    const crocksdb_token_bucket_inspector_t* inspector, int op, int priority,
+    uint64_t* bytes, uint64_t* requests, uint64_t* wait_micros) {
+  auto bucket = GetTokenBucket(inspector, op, priority);
+  if (bucket == nullptr) {
+    *bytes = *requests = *wait_micros = 0;
+    return;
+  }
+  *bytes = bucket->counters.bytes.load(std::memory_order_relaxed);
+  *requests = bucket->counters.requests.load(std::memory_order_relaxed);
+  *wait_micros = bucket->counters.wait_micros.load(std::memory_order_relaxed);
 }
 
-crocksdb_env_t* crocksdb_file_system_inspected_env_create(
-    crocksdb_env_t* base_env, crocksdb_file_system_inspector_t* inspector) {
-  assert(base_env != nullptr);
-  assert(inspector != nullptr);
-  crocksdb_env_t* result = new crocksdb_env_t;
-  result->rep = NewFileSystemInspectedEnv(base_env->rep, inspector->rep);
-  result->block_cipher = nullptr;
-  result->encryption_provider = nullptr;
-  result->is_default = false;
+crocksdb_file_system_inspector_t*
+crocksdb_file_system_inspector_create_token_bucket(
+    const crocksdb_token_bucket_inspector_t* inspector) {
+  auto result = new crocksdb_file_system_inspector_t;
+  result->rep = inspector->rep;
   return result;
 }
 
+void crocksdb_set_thread_io_priority(int priority) {
+  thread_io_priority = priority;
+}
+
 crocksdb_sstfilereader_t* crocksdb_sstfilereader_create(
     const crocksdb_options_t* io_options) {
   auto reader = new crocksdb_sstfilereader_t;
@@ -4927,6 +8041,7 @@ void crocksdb_ingestexternalfileoptions_destroy(
 void crocksdb_ingest_external_file(
     crocksdb_t* db, const char* const* file_list, const size_t list_len,
     const crocksdb_ingestexternalfileoptions_t* opt, char** errptr) {
+  OpTraceScope trace(crocksdb_traced_op_ingest);
   std::vector<std::string> files(list_len);
   for (size_t i = 0; i < list_len; ++i) {
     files[i] = std::string(file_list[i]);
@@ -4938,6 +8053,7 @@ void crocksdb_ingest_external_file_cf(
     crocksdb_t* db, crocksdb_column_family_handle_t* handle,
     const char* const* file_list, const size_t list_len,
     const crocksdb_ingestexternalfileoptions_t* opt, char** errptr) {
+  OpTraceScope trace(crocksdb_traced_op_ingest);
   std::vector<std::string> files(list_len);
   for (size_t i = 0; i < list_len; ++i) {
     files[i] = std::string(file_list[i]);
@@ -4949,6 +8065,7 @@ unsigned char crocksdb_ingest_external_file_optimized(
     crocksdb_t* db, crocksdb_column_family_handle_t* handle,
     const char* const* file_list, const size_t list_len,
     const crocksdb_ingestexternalfileoptions_t* opt, char** errptr) {
+  OpTraceScope trace(crocksdb_traced_op_ingest);
   std::vector<std::string> files(list_len);
   for (size_t i = 0; i < list_len; ++i) {
     files[i] = std::string(file_list[i]);
@@ -5004,47 +8121,224 @@ void crocksdb_slicetransform_destroy(crocksdb_slicetransform_t* st) {
   delete st;
 }
 
-crocksdb_slicetransform_t* crocksdb_slicetransform_create_fixed_prefix(
-    size_t prefixLen) {
-  struct Wrapper : public crocksdb_slicetransform_t {
-    const SliceTransform* rep_;
-    ~Wrapper() { delete rep_; }
-    const char* Name() const override { return rep_->Name(); }
-    Slice Transform(const Slice& src) const override {
-      return rep_->Transform(src);
-    }
-    bool InDomain(const Slice& src) const override {
-      return rep_->InDomain(src);
-    }
-    bool InRange(const Slice& src) const override { return rep_->InRange(src); }
-    static void DoNothing(void*) {}
-  };
-  Wrapper* wrapper = new Wrapper;
-  wrapper->rep_ = rocksdb::NewFixedPrefixTransform(prefixLen);
+const char* crocksdb_slicetransform_name(const crocksdb_slicetransform_t* st) {
+  return st->Name();
+}
+
+unsigned char crocksdb_slicetransform_in_domain(
+    const crocksdb_slicetransform_t* st, const char* key, size_t key_len) {
+  return st->InDomain(Slice(key, key_len));
+}
+
+const char* crocksdb_slicetransform_transform(
+    const crocksdb_slicetransform_t* st, const char* key, size_t key_len,
+    size_t* prefix_len) {
+  Slice src(key, key_len);
+  if (!st->InDomain(src)) {
+    *prefix_len = 0;
+    return nullptr;
+  }
+  Slice prefix = st->Transform(src);
+  *prefix_len = prefix.size();
+  return prefix.data();
+}
+
+// Make a crocksdb_slicetransform_t that delegates to a native SliceTransform
+// instead of user supplied C functions.
+struct SliceTransformWrapper : public crocksdb_slicetransform_t {
+  const SliceTransform* rep_;
+  ~SliceTransformWrapper() { delete rep_; }
+  const char* Name() const override { return rep_->Name(); }
+  Slice Transform(const Slice& src) const override {
+    return rep_->Transform(src);
+  }
+  bool InDomain(const Slice& src) const override {
+    return rep_->InDomain(src);
+  }
+  bool InRange(const Slice& src) const override { return rep_->InRange(src); }
+  bool SameResultWhenAppended(const Slice& prefix) const override {
+    return rep_->SameResultWhenAppended(prefix);
+  }
+  static void DoNothing(void*) {}
+};
+
+static crocksdb_slicetransform_t* NewSliceTransformWrapper(
+    const SliceTransform* rep) {
+  SliceTransformWrapper* wrapper = new SliceTransformWrapper;
+  wrapper->rep_ = rep;
   wrapper->state_ = nullptr;
-  wrapper->destructor_ = &Wrapper::DoNothing;
+  wrapper->destructor_ = &SliceTransformWrapper::DoNothing;
   return wrapper;
 }
 
+crocksdb_slicetransform_t* crocksdb_slicetransform_create_fixed_prefix(
+    size_t prefixLen) {
+  return NewSliceTransformWrapper(rocksdb::NewFixedPrefixTransform(prefixLen));
+}
+
+crocksdb_slicetransform_t* crocksdb_slicetransform_create_capped_prefix(
+    size_t cap_len) {
+  return NewSliceTransformWrapper(rocksdb::NewCappedPrefixTransform(cap_len));
+}
+
 crocksdb_slicetransform_t* crocksdb_slicetransform_create_noop() {
-  struct Wrapper : public crocksdb_slicetransform_t {
-    const SliceTransform* rep_;
-    ~Wrapper() { delete rep_; }
-    const char* Name() const override { return rep_->Name(); }
-    Slice Transform(const Slice& src) const override {
-      return rep_->Transform(src);
-    }
-    bool InDomain(const Slice& src) const override {
-      return rep_->InDomain(src);
-    }
-    bool InRange(const Slice& src) const override { return rep_->InRange(src); }
-    static void DoNothing(void*) {}
-  };
-  Wrapper* wrapper = new Wrapper;
-  wrapper->rep_ = rocksdb::NewNoopTransform();
-  wrapper->state_ = nullptr;
-  wrapper->destructor_ = &Wrapper::DoNothing;
-  return wrapper;
+  return NewSliceTransformWrapper(rocksdb::NewNoopTransform());
+}
+
+// The names below are persisted in SST properties and compared against the
+// configured prefix extractor when deciding whether prefix filters can be
+// used, so they must never change for a given configuration.
+
+// Takes a `header_len`-byte header plus up to `prefix_len` bytes after it.
+// Keys without a complete header are out of domain. The header stays in the
+// result because RocksDB requires a prefix to be a prefix of its key.
+class PrefixAfterHeaderTransform : public SliceTransform {
+ public:
+  PrefixAfterHeaderTransform(size_t header_len, size_t prefix_len)
+      : header_len_(header_len),
+        prefix_len_(prefix_len),
+        name_("crocksdb.PrefixAfterHeader." + std::to_string(header_len) +
+              "." + std::to_string(prefix_len)) {}
+
+  const char* Name() const override { return name_.c_str(); }
+
+  Slice Transform(const Slice& src) const override {
+    assert(InDomain(src));
+    return Slice(src.data(), std::min(src.size(), header_len_ + prefix_len_));
+  }
+
+  bool InDomain(const Slice& src) const override {
+    return src.size() >= header_len_;
+  }
+
+  bool SameResultWhenAppended(const Slice& prefix) const override {
+    return prefix.size() >= header_len_ + prefix_len_;
+  }
+
+ private:
+  const size_t header_len_;
+  const size_t prefix_len_;
+  const std::string name_;
+};
+
+// Takes everything up to and including the `count`-th `delimiter` byte.
+// Keys with fewer delimiters are out of domain.
+class DelimitedPrefixTransform : public SliceTransform {
+ public:
+  DelimitedPrefixTransform(char delimiter, size_t count)
+      : delimiter_(delimiter),
+        count_(count),
+        name_("crocksdb.DelimitedPrefix." +
+              std::to_string(static_cast<unsigned char>(delimiter)) + "." +
+              std::to_string(count)) {}
+
+  const char* Name() const override { return name_.c_str(); }
+
+  Slice Transform(const Slice& src) const override {
+    size_t len = PrefixLen(src);
+    assert(len != kNotInDomain);
+    return Slice(src.data(), len);
+  }
+
+  bool InDomain(const Slice& src) const override {
+    return PrefixLen(src) != kNotInDomain;
+  }
+
+  bool SameResultWhenAppended(const Slice& prefix) const override {
+    return InDomain(prefix);
+  }
+
+ private:
+  static constexpr size_t kNotInDomain = std::numeric_limits<size_t>::max();
+
+  size_t PrefixLen(const Slice& src) const {
+    if (count_ == 0) {
+      return 0;
+    }
+    size_t seen = 0;
+    const char* p = src.data();
+    const char* end = src.data() + src.size();
+    while (p < end) {
+      p = static_cast<const char*>(memchr(p, delimiter_, end - p));
+      if (p == nullptr) {
+        break;
+      }
+      p++;
+      if (++seen == count_) {
+        return p - src.data();
+      }
+    }
+    return kNotInDomain;
+  }
+
+  const char delimiter_;
+  const size_t count_;
+  const std::string name_;
+};
+
+// Takes a `header_len`-byte header followed by one memcomparable-encoded
+// bytes segment: groups of 8 data bytes each followed by a marker byte,
+// where a marker other than 0xFF closes the segment.
+class HeaderMemcomparablePrefixTransform : public SliceTransform {
+ public:
+  explicit HeaderMemcomparablePrefixTransform(size_t header_len)
+      : header_len_(header_len),
+        name_("crocksdb.HeaderMemcomparablePrefix." +
+              std::to_string(header_len)) {}
+
+  const char* Name() const override { return name_.c_str(); }
+
+  Slice Transform(const Slice& src) const override {
+    size_t len = PrefixLen(src);
+    assert(len != kNotInDomain);
+    return Slice(src.data(), len);
+  }
+
+  bool InDomain(const Slice& src) const override {
+    return PrefixLen(src) != kNotInDomain;
+  }
+
+  bool SameResultWhenAppended(const Slice& prefix) const override {
+    return InDomain(prefix);
+  }
+
+ private:
+  static constexpr size_t kGroupSize = 8;
+  static constexpr unsigned char kMarker = 0xFF;
+  static constexpr size_t kNotInDomain = std::numeric_limits<size_t>::max();
+
+  size_t PrefixLen(const Slice& src) const {
+    size_t pos = header_len_;
+    while (pos + kGroupSize < src.size()) {
+      pos += kGroupSize;
+      if (static_cast<unsigned char>(src[pos++]) != kMarker) {
+        return pos;
+      }
+    }
+    return kNotInDomain;
+  }
+
+  const size_t header_len_;
+  const std::string name_;
+};
+
+crocksdb_slicetransform_t* crocksdb_slicetransform_create_prefix_after_header(
+    size_t header_len, size_t prefix_len) {
+  return NewSliceTransformWrapper(
+      new PrefixAfterHeaderTransform(header_len, prefix_len));
+}
+
+crocksdb_slicetransform_t* crocksdb_slicetransform_create_delimited_prefix(
+    char delimiter, size_t count) {
+  return NewSliceTransformWrapper(
+      new DelimitedPrefixTransform(delimiter, count));
+}
+
+crocksdb_slicetransform_t*
+crocksdb_slicetransform_create_header_memcomparable_prefix(
+    size_t header_len) {
+  return NewSliceTransformWrapper(
+      new HeaderMemcomparablePrefixTransform(header_len));
 }
 
 crocksdb_universal_compaction_options_t*
@@ -5253,6 +8547,7 @@ void crocksdb_log_destroy(crocksdb_logger_t* logger) { delete logger; }
 crocksdb_pinnableslice_t* crocksdb_get_pinned(
     crocksdb_t* db, const crocksdb_readoptions_t* options, const char* key,
     size_t keylen, char** errptr) {
+  OpTraceScope trace(crocksdb_traced_op_get);
   crocksdb_pinnableslice_t* v = new (crocksdb_pinnableslice_t);
   Status s = db->rep->Get(options->rep, db->rep->DefaultColumnFamily(),
                           Slice(key, keylen), &v->rep);
@@ -5270,6 +8565,7 @@ crocksdb_pinnableslice_t* crocksdb_get_pinned_cf(
     crocksdb_t* db, const crocksdb_readoptions_t* options,
     crocksdb_column_family_handle_t* column_family, const char* key,
     size_t keylen, char** errptr) {
+  OpTraceScope trace(crocksdb_traced_op_get);
   crocksdb_pinnableslice_t* v = new (crocksdb_pinnableslice_t);
   Status s = db->rep->Get(options->rep, column_family->rep, Slice(key, keylen),
                           &v->rep);
@@ -5283,6 +8579,32 @@ crocksdb_pinnableslice_t* crocksdb_get_pinned_cf(
   return v;
 }
 
+// Like crocksdb_get_pinned_cf, but also returns the timestamp of the found
+// entry in a malloc()ed buffer. `options` must carry a read timestamp if the
+// column family has user-defined timestamps enabled.
+crocksdb_pinnableslice_t* crocksdb_get_pinned_cf_with_ts(
+    crocksdb_t* db, const crocksdb_readoptions_t* options,
+    crocksdb_column_family_handle_t* column_family, const char* key,
+    size_t keylen, char** ts, size_t* tslen, char** errptr) {
+  OpTraceScope trace(crocksdb_traced_op_get);
+  crocksdb_pinnableslice_t* v = new (crocksdb_pinnableslice_t);
+  std::string timestamp;
+  Status s = db->rep->Get(options->rep, column_family->rep, Slice(key, keylen),
+                          &v->rep, &timestamp);
+  if (!s.ok()) {
+    delete v;
+    *ts = nullptr;
+    *tslen = 0;
+    if (!s.IsNotFound()) {
+      SaveError(errptr, s);
+    }
+    return NULL;
+  }
+  *tslen = timestamp.size();
+  *ts = CopyString(timestamp);
+  return v;
+}
+
 void crocksdb_pinnableslice_destroy(crocksdb_pinnableslice_t* v) { delete v; }
 
 const char* crocksdb_pinnableslice_value(const crocksdb_pinnableslice_t* v,
@@ -5581,84 +8903,378 @@ struct crocksdb_table_properties_collector_t : public TablePropertiesCollector {
     return UserCollectedProperties();
   }
 
-  const char* Name() const override { return name_(state_); }
+  const char* Name() const override { return name_(state_); }
+};
+
+crocksdb_table_properties_collector_t*
+crocksdb_table_properties_collector_create(
+    void* state, const char* (*name)(void*), void (*destruct)(void*),
+    void (*add)(void*, const char* key, size_t key_len, const char* value,
+                size_t value_len, uint32_t entry_type, uint64_t seq,
+                uint64_t file_size),
+    void (*finish)(void*, crocksdb_user_collected_properties_t* props)) {
+  auto c = new crocksdb_table_properties_collector_t;
+  c->state_ = state;
+  c->name_ = name;
+  c->destruct_ = destruct;
+  c->add_ = add;
+  c->finish_ = finish;
+  return c;
+}
+
+void crocksdb_table_properties_collector_destroy(
+    crocksdb_table_properties_collector_t* c) {
+  delete c;
+}
+
+/* Table Properties Collector Factory */
+
+struct crocksdb_table_properties_collector_factory_t
+    : public TablePropertiesCollectorFactory {
+  void* state_;
+  const char* (*name_)(void*);
+  void (*destruct_)(void*);
+  crocksdb_table_properties_collector_t* (*create_table_properties_collector_)(
+      void*, uint32_t cf);
+
+  virtual ~crocksdb_table_properties_collector_factory_t() {
+    destruct_(state_);
+  }
+
+  virtual TablePropertiesCollector* CreateTablePropertiesCollector(
+      TablePropertiesCollectorFactory::Context ctx) override {
+    return create_table_properties_collector_(state_, ctx.column_family_id);
+  }
+
+  const char* Name() const override { return name_(state_); }
+};
+
+crocksdb_table_properties_collector_factory_t*
+crocksdb_table_properties_collector_factory_create(
+    void* state, const char* (*name)(void*), void (*destruct)(void*),
+    crocksdb_table_properties_collector_t* (*create_table_properties_collector)(
+        void*, uint32_t cf)) {
+  auto f = new crocksdb_table_properties_collector_factory_t;
+  f->state_ = state;
+  f->name_ = name;
+  f->destruct_ = destruct;
+  f->create_table_properties_collector_ = create_table_properties_collector;
+  return f;
+}
+
+void crocksdb_table_properties_collector_factory_destroy(
+    crocksdb_table_properties_collector_factory_t* f) {
+  delete f;
+}
+
+void crocksdb_options_add_table_properties_collector_factory(
+    crocksdb_options_t* opt, crocksdb_table_properties_collector_factory_t* f) {
+  opt->rep.table_properties_collector_factories.push_back(
+      std::shared_ptr<TablePropertiesCollectorFactory>(f));
+}
+
+void crocksdb_options_set_compact_on_deletion(crocksdb_options_t* opt,
+                                              size_t sliding_window_size,
+                                              size_t deletion_trigger) {
+  opt->rep.table_properties_collector_factories.push_back(
+      rocksdb::NewCompactOnDeletionCollectorFactory(sliding_window_size,
+                                                    deletion_trigger));
+}
+
+static const char* kMvccPropertiesName = "crocksdb.mvcc";
+static const uint32_t kMvccPropertiesVersion = 1;
+
+// Collects MVCC statistics of keys laid out as a user key followed by a
+// fixed-size timestamp.
+class MvccPropertiesCollector : public TablePropertiesCollector {
+ public:
+  MvccPropertiesCollector(size_t user_key_len, size_t ts_size, int ts_encoding)
+      : user_key_len_(user_key_len),
+        ts_size_(ts_size),
+        ts_encoding_(ts_encoding) {
+    props_.min_ts = std::numeric_limits<uint64_t>::max();
+  }
+
+  Status AddUserKey(const Slice& key, const Slice& /*value*/,
+                    EntryType entry_type, SequenceNumber /*seq*/,
+                    uint64_t /*file_size*/) override {
+    if (entry_type == rocksdb::kEntryRangeDeletion) {
+      return Status::OK();
+    }
+    props_.num_versions++;
+    switch (entry_type) {
+      case rocksdb::kEntryPut:
+      case rocksdb::kEntryBlobIndex:
+      case rocksdb::kEntryWideColumnEntity:
+        props_.num_puts++;
+        break;
+      case rocksdb::kEntryDelete:
+      case rocksdb::kEntrySingleDelete:
+      case rocksdb::kEntryDeleteWithTimestamp:
+        props_.num_deletes++;
+        break;
+      default:
+        break;
+    }
+
+    // Keys that don't match the layout are counted as rows of their own.
+    Slice row = key;
+    if (key.size() >= user_key_len_ + ts_size_) {
+      size_t row_len =
+          user_key_len_ == 0 ? key.size() - ts_size_ : user_key_len_;
+      row = Slice(key.data(), row_len);
+      uint64_t ts = DecodeTs(key.data() + row_len);
+      props_.min_ts = std::min(props_.min_ts, ts);
+      props_.max_ts = std::max(props_.max_ts, ts);
+    }
+    if (props_.num_rows == 0 || row != Slice(last_row_)) {
+      last_row_.assign(row.data(), row.size());
+      props_.num_rows++;
+      row_versions_ = 0;
+    }
+    row_versions_++;
+    props_.max_row_versions = std::max(props_.max_row_versions, row_versions_);
+    return Status::OK();
+  }
+
+  Status Finish(UserCollectedProperties* props) override {
+    if (props_.num_versions == 0) {
+      return Status::OK();
+    }
+    std::string buf;
+    PutVarint32(&buf, kMvccPropertiesVersion);
+    PutVarint64Varint64(&buf, props_.num_rows, props_.num_versions);
+    PutVarint64Varint64(&buf, props_.num_puts, props_.num_deletes);
+    PutVarint64Varint64(&buf, props_.max_row_versions, props_.min_ts);
+    PutVarint64(&buf, props_.max_ts);
+    props->emplace(kMvccPropertiesName, std::move(buf));
+    return Status::OK();
+  }
+
+  UserCollectedProperties GetReadableProperties() const override {
+    return UserCollectedProperties();
+  }
+
+  const char* Name() const override {
+    return "crocksdb.MvccPropertiesCollector";
+  }
+
+ private:
+  uint64_t DecodeTs(const char* p) const {
+    uint64_t ts = 0;
+    if (ts_encoding_ == crocksdb_ts_encoding_little_endian) {
+      for (size_t i = ts_size_; i > 0; i--) {
+        ts = (ts << 8) | static_cast<unsigned char>(p[i - 1]);
+      }
+    } else {
+      for (size_t i = 0; i < ts_size_; i++) {
+        ts = (ts << 8) | static_cast<unsigned char>(p[i]);
+      }
+      if (ts_encoding_ == crocksdb_ts_encoding_big_endian_desc) {
+        ts = ~ts;
+        if (ts_size_ < 8) {
+          ts &= (uint64_t{1} << (ts_size_ * 8)) - 1;
+        }
+      }
+    }
+    return ts;
+  }
+
+  const size_t user_key_len_;
+  const size_t ts_size_;
+  const int ts_encoding_;
+  crocksdb_mvcc_properties_t props_{};
+  std::string last_row_;
+  uint64_t row_versions_ = 0;
+};
+
+struct MvccPropertiesCollectorFactory
+    : public crocksdb_table_properties_collector_factory_t {
+  size_t user_key_len_;
+  size_t ts_size_;
+  int ts_encoding_;
+
+  TablePropertiesCollector* CreateTablePropertiesCollector(
+      TablePropertiesCollectorFactory::Context /*ctx*/) override {
+    return new MvccPropertiesCollector(user_key_len_, ts_size_, ts_encoding_);
+  }
+
+  const char* Name() const override {
+    return "crocksdb.MvccPropertiesCollectorFactory";
+  }
+
+  static void DoNothing(void*) {}
+};
+
+crocksdb_table_properties_collector_factory_t*
+crocksdb_table_properties_collector_factory_create_mvcc(size_t user_key_len,
+                                                        size_t ts_size,
+                                                        int ts_encoding) {
+  assert(ts_size <= sizeof(uint64_t));
+  auto f = new MvccPropertiesCollectorFactory;
+  f->state_ = nullptr;
+  f->destruct_ = &MvccPropertiesCollectorFactory::DoNothing;
+  f->user_key_len_ = user_key_len;
+  f->ts_size_ = ts_size;
+  f->ts_encoding_ = ts_encoding;
+  return f;
+}
+
+unsigned char crocksdb_user_collected_properties_get_mvcc(
+    const crocksdb_user_collected_properties_t* props,
+    crocksdb_mvcc_properties_t* mvcc) {
+  auto it = props->rep.find(kMvccPropertiesName);
+  if (it == props->rep.end()) {
+    return false;
+  }
+  Slice input(it->second);
+  uint32_t version = 0;
+  return GetVarint32(&input, &version) &&
+         version == kMvccPropertiesVersion &&
+         GetVarint64(&input, &mvcc->num_rows) &&
+         GetVarint64(&input, &mvcc->num_versions) &&
+         GetVarint64(&input, &mvcc->num_puts) &&
+         GetVarint64(&input, &mvcc->num_deletes) &&
+         GetVarint64(&input, &mvcc->max_row_versions) &&
+         GetVarint64(&input, &mvcc->min_ts) &&
+         GetVarint64(&input, &mvcc->max_ts);
+}
+
+/* Range Properties Collector */
+
+static const char* kRangePropertiesName = "crocksdb.range";
+
+// Records a sample of (key, bytes so far, keys so far) every `sample_bytes`
+// bytes or `sample_keys` keys, and for the last key of the file. Samples are
+// stored with the key prefix shared with the previous sample and deltas of
+// the counters.
+class RangePropertiesCollector : public TablePropertiesCollector {
+ public:
+  RangePropertiesCollector(uint64_t sample_bytes, uint64_t sample_keys)
+      : sample_bytes_(sample_bytes), sample_keys_(sample_keys) {}
+
+  Status AddUserKey(const Slice& key, const Slice& value, EntryType entry_type,
+                    SequenceNumber /*seq*/, uint64_t /*file_size*/) override {
+    // Range tombstones are not added in key order.
+    if (entry_type == rocksdb::kEntryRangeDeletion) {
+      return Status::OK();
+    }
+    size_ += key.size() + value.size();
+    keys_++;
+    if (size_ - sampled_size_ >= sample_bytes_ ||
+        keys_ - sampled_keys_ >= sample_keys_) {
+      AddSample(key);
+    } else {
+      last_key_.assign(key.data(), key.size());
+    }
+    return Status::OK();
+  }
+
+  Status Finish(UserCollectedProperties* props) override {
+    if (keys_ > sampled_keys_) {
+      AddSample(last_key_);
+    }
+    if (!buf_.empty()) {
+      props->emplace(kRangePropertiesName, std::move(buf_));
+    }
+    return Status::OK();
+  }
+
+  UserCollectedProperties GetReadableProperties() const override {
+    return UserCollectedProperties();
+  }
+
+  const char* Name() const override {
+    return "crocksdb.RangePropertiesCollector";
+  }
+
+ private:
+  void AddSample(const Slice& key) {
+    size_t shared = 0;
+    size_t limit = std::min(key.size(), sampled_key_.size());
+    while (shared < limit && key[shared] == sampled_key_[shared]) {
+      shared++;
+    }
+    PutVarint32Varint32(&buf_, static_cast<uint32_t>(shared),
+                        static_cast<uint32_t>(key.size() - shared));
+    buf_.append(key.data() + shared, key.size() - shared);
+    PutVarint64Varint64(&buf_, size_ - sampled_size_, keys_ - sampled_keys_);
+    sampled_key_.assign(key.data(), key.size());
+    sampled_size_ = size_;
+    sampled_keys_ = keys_;
+  }
+
+  const uint64_t sample_bytes_;
+  const uint64_t sample_keys_;
+  uint64_t size_ = 0;
+  uint64_t keys_ = 0;
+  std::string last_key_;
+  std::string sampled_key_;
+  uint64_t sampled_size_ = 0;
+  uint64_t sampled_keys_ = 0;
+  std::string buf_;
 };
 
-crocksdb_table_properties_collector_t*
-crocksdb_table_properties_collector_create(
-    void* state, const char* (*name)(void*), void (*destruct)(void*),
-    void (*add)(void*, const char* key, size_t key_len, const char* value,
-                size_t value_len, uint32_t entry_type, uint64_t seq,
-                uint64_t file_size),
-    void (*finish)(void*, crocksdb_user_collected_properties_t* props)) {
-  auto c = new crocksdb_table_properties_collector_t;
-  c->state_ = state;
-  c->name_ = name;
-  c->destruct_ = destruct;
-  c->add_ = add;
-  c->finish_ = finish;
-  return c;
-}
+struct RangeSample {
+  std::string key;
+  // Bytes and keys between the previous sample and this one, inclusive.
+  uint64_t size;
+  uint64_t keys;
+};
 
-void crocksdb_table_properties_collector_destroy(
-    crocksdb_table_properties_collector_t* c) {
-  delete c;
+static bool DecodeRangeSamples(const std::string& data,
+                               std::vector<RangeSample>* samples) {
+  samples->clear();
+  Slice input(data);
+  std::string key;
+  while (!input.empty()) {
+    uint32_t shared = 0, non_shared = 0;
+    RangeSample sample;
+    if (!GetVarint32(&input, &shared) || !GetVarint32(&input, &non_shared) ||
+        shared > key.size() || non_shared > input.size()) {
+      return false;
+    }
+    key.resize(shared);
+    key.append(input.data(), non_shared);
+    input.remove_prefix(non_shared);
+    if (!GetVarint64(&input, &sample.size) ||
+        !GetVarint64(&input, &sample.keys)) {
+      return false;
+    }
+    sample.key = key;
+    samples->push_back(std::move(sample));
+  }
+  return true;
 }
 
-/* Table Properties Collector Factory */
-
-struct crocksdb_table_properties_collector_factory_t
-    : public TablePropertiesCollectorFactory {
-  void* state_;
-  const char* (*name_)(void*);
-  void (*destruct_)(void*);
-  crocksdb_table_properties_collector_t* (*create_table_properties_collector_)(
-      void*, uint32_t cf);
+struct RangePropertiesCollectorFactory
+    : public crocksdb_table_properties_collector_factory_t {
+  uint64_t sample_bytes_;
+  uint64_t sample_keys_;
 
-  virtual ~crocksdb_table_properties_collector_factory_t() {
-    destruct_(state_);
+  TablePropertiesCollector* CreateTablePropertiesCollector(
+      TablePropertiesCollectorFactory::Context /*ctx*/) override {
+    return new RangePropertiesCollector(sample_bytes_, sample_keys_);
   }
 
-  virtual TablePropertiesCollector* CreateTablePropertiesCollector(
-      TablePropertiesCollectorFactory::Context ctx) override {
-    return create_table_properties_collector_(state_, ctx.column_family_id);
+  const char* Name() const override {
+    return "crocksdb.RangePropertiesCollectorFactory";
   }
 
-  const char* Name() const override { return name_(state_); }
+  static void DoNothing(void*) {}
 };
 
 crocksdb_table_properties_collector_factory_t*
-crocksdb_table_properties_collector_factory_create(
-    void* state, const char* (*name)(void*), void (*destruct)(void*),
-    crocksdb_table_properties_collector_t* (*create_table_properties_collector)(
-        void*, uint32_t cf)) {
-  auto f = new crocksdb_table_properties_collector_factory_t;
-  f->state_ = state;
-  f->name_ = name;
-  f->destruct_ = destruct;
-  f->create_table_properties_collector_ = create_table_properties_collector;
+crocksdb_table_properties_collector_factory_create_range(
+    uint64_t sample_bytes, uint64_t sample_keys) {
+  auto f = new RangePropertiesCollectorFactory;
+  f->state_ = nullptr;
+  f->destruct_ = &RangePropertiesCollectorFactory::DoNothing;
+  f->sample_bytes_ = sample_bytes;
+  f->sample_keys_ = sample_keys;
   return f;
 }
 
-void crocksdb_table_properties_collector_factory_destroy(
-    crocksdb_table_properties_collector_factory_t* f) {
-  delete f;
-}
-
-void crocksdb_options_add_table_properties_collector_factory(
-    crocksdb_options_t* opt, crocksdb_table_properties_collector_factory_t* f) {
-  opt->rep.table_properties_collector_factories.push_back(
-      std::shared_ptr<TablePropertiesCollectorFactory>(f));
-}
-
-void crocksdb_options_set_compact_on_deletion(crocksdb_options_t* opt,
-                                              size_t sliding_window_size,
-                                              size_t deletion_trigger) {
-  opt->rep.table_properties_collector_factories.push_back(
-      rocksdb::NewCompactOnDeletionCollectorFactory(sliding_window_size,
-                                                    deletion_trigger));
-}
-
 /* Get Table Properties */
 
 crocksdb_table_properties_collection_t* crocksdb_get_properties_of_all_tables(
@@ -5709,6 +9325,304 @@ crocksdb_get_properties_of_tables_in_range(
   return props.release();
 }
 
+void crocksdb_get_range_properties_cf(
+    crocksdb_t* db, crocksdb_column_family_handle_t* cf, const char* start_key,
+    size_t start_key_len, const char* limit_key, size_t limit_key_len,
+    uint64_t* size, uint64_t* num_keys, char** middle_key,
+    size_t* middle_key_len, char** errptr) {
+  *size = 0;
+  *num_keys = 0;
+  *middle_key = nullptr;
+  *middle_key_len = 0;
+  Slice start(start_key, start_key_len);
+  Slice limit(limit_key, limit_key_len);
+  Range range(start, limit);
+  TablePropertiesCollection props;
+  Status s = db->rep->GetPropertiesOfTablesInRange(cf->rep, &range, 1, &props);
+  if (!s.ok()) {
+    SaveError(errptr, s);
+    return;
+  }
+
+  // A sample accounts for the entries since the previous sample of its file,
+  // so it is counted when its own key falls into the range.
+  const Comparator* cmp = cf->rep->GetComparator();
+  std::vector<RangeSample> in_range;
+  std::vector<RangeSample> samples;
+  for (const auto& file : props) {
+    const auto& user_props = file.second->user_collected_properties;
+    auto it = user_props.find(kRangePropertiesName);
+    if (it == user_props.end() || !DecodeRangeSamples(it->second, &samples)) {
+      continue;
+    }
+    for (auto& sample : samples) {
+      if (cmp->Compare(sample.key, start) >= 0 &&
+          cmp->Compare(sample.key, limit) < 0) {
+        *size += sample.size;
+        *num_keys += sample.keys;
+        in_range.push_back(std::move(sample));
+      }
+    }
+  }
+  if (in_range.empty()) {
+    return;
+  }
+
+  std::sort(in_range.begin(), in_range.end(),
+            [cmp](const RangeSample& a, const RangeSample& b) {
+              return cmp->Compare(a.key, b.key) < 0;
+            });
+  uint64_t half = *size / 2;
+  uint64_t acc = 0;
+  for (const auto& sample : in_range) {
+    acc += sample.size;
+    if (acc >= half) {
+      *middle_key = CopyString(sample.key);
+      *middle_key_len = sample.key.size();
+      break;
+    }
+  }
+}
+
+/* Table Properties Cache */
+
+// Decoded properties of the live tables of a DB by file number. Entries are
+// added on flush, compaction and ingestion, or lazily when missed, and
+// dropped once their file is deleted.
+//
+// A lazy fill reads the file list first and inserts later, so the file may
+// be deleted in between. While any lookup is in flight, deleted file numbers
+// are remembered so that the fill does not resurrect them; the set is
+// cleared when the last lookup ends.
+struct crocksdb_table_properties_cache_t {
+  struct Rep {
+    std::mutex mutex;
+    std::unordered_map<uint64_t, std::shared_ptr<const TableProperties>> map;
+    size_t pending_lookups = 0;
+    std::unordered_set<uint64_t> deleted;
+
+    std::shared_ptr<const TableProperties> Get(uint64_t file_number) {
+      std::lock_guard<std::mutex> lock(mutex);
+      auto it = map.find(file_number);
+      return it == map.end() ? nullptr : it->second;
+    }
+
+    void Put(uint64_t file_number,
+             std::shared_ptr<const TableProperties> props) {
+      std::lock_guard<std::mutex> lock(mutex);
+      map[file_number] = std::move(props);
+    }
+
+    void PutIfLive(uint64_t file_number,
+                   std::shared_ptr<const TableProperties> props) {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (deleted.count(file_number) == 0) {
+        map[file_number] = std::move(props);
+      }
+    }
+
+    void Erase(uint64_t file_number) {
+      std::lock_guard<std::mutex> lock(mutex);
+      map.erase(file_number);
+      if (pending_lookups > 0) {
+        deleted.insert(file_number);
+      }
+    }
+  };
+
+  class LookupScope {
+   public:
+    explicit LookupScope(Rep* rep) : rep_(rep) {
+      std::lock_guard<std::mutex> lock(rep_->mutex);
+      rep_->pending_lookups++;
+    }
+
+    ~LookupScope() {
+      std::lock_guard<std::mutex> lock(rep_->mutex);
+      if (--rep_->pending_lookups == 0) {
+        rep_->deleted.clear();
+      }
+    }
+
+   private:
+    Rep* rep_;
+  };
+
+  std::shared_ptr<Rep> rep{new Rep};
+};
+
+class TablePropertiesCacheListener : public EventListener {
+ public:
+  explicit TablePropertiesCacheListener(
+      std::shared_ptr<crocksdb_table_properties_cache_t::Rep> cache)
+      : cache_(std::move(cache)) {}
+
+  const char* Name() const override {
+    return "crocksdb.TablePropertiesCacheListener";
+  }
+
+  void OnFlushCompleted(DB* /*db*/, const FlushJobInfo& info) override {
+    cache_->Put(info.file_number,
+                std::make_shared<TableProperties>(info.table_properties));
+  }
+
+  void OnCompactionCompleted(DB* /*db*/,
+                             const CompactionJobInfo& info) override {
+    if (!info.status.ok()) {
+      return;
+    }
+    for (const auto& input : info.input_file_infos) {
+      cache_->Erase(input.file_number);
+    }
+    size_t num_outputs =
+        std::min(info.output_files.size(), info.output_file_infos.size());
+    for (size_t i = 0; i < num_outputs; i++) {
+      auto it = info.table_properties.find(info.output_files[i]);
+      if (it != info.table_properties.end() && it->second != nullptr) {
+        cache_->Put(info.output_file_infos[i].file_number, it->second);
+      }
+    }
+  }
+
+  void OnExternalFileIngested(DB* /*db*/,
+                              const ExternalFileIngestionInfo& info) override {
+    cache_->Put(rocksdb::TableFileNameToNumber(info.internal_file_path),
+                std::make_shared<TableProperties>(info.table_properties));
+  }
+
+  void OnTableFileDeleted(const TableFileDeletionInfo& info) override {
+    cache_->Erase(rocksdb::TableFileNameToNumber(info.file_path));
+  }
+
+ private:
+  std::shared_ptr<crocksdb_table_properties_cache_t::Rep> cache_;
+};
+
+crocksdb_table_properties_cache_t* crocksdb_table_properties_cache_create() {
+  return new crocksdb_table_properties_cache_t;
+}
+
+void crocksdb_table_properties_cache_destroy(
+    crocksdb_table_properties_cache_t* cache) {
+  delete cache;
+}
+
+size_t crocksdb_table_properties_cache_len(
+    crocksdb_table_properties_cache_t* cache) {
+  std::lock_guard<std::mutex> lock(cache->rep->mutex);
+  return cache->rep->map.size();
+}
+
+void crocksdb_options_add_table_properties_cache(
+    crocksdb_options_t* opt, crocksdb_table_properties_cache_t* cache) {
+  opt->rep.listeners.emplace_back(
+      std::make_shared<TablePropertiesCacheListener>(cache->rep));
+}
+
+static bool DecodeNumericProperty(const std::string& value, int encoding,
+                                  uint64_t* result) {
+  *result = 0;
+  switch (encoding) {
+    case crocksdb_property_encoding_fixed_be:
+      if (value.size() > sizeof(uint64_t)) {
+        return false;
+      }
+      for (char c : value) {
+        *result = (*result << 8) | static_cast<unsigned char>(c);
+      }
+      return true;
+    case crocksdb_property_encoding_fixed_le:
+      if (value.size() > sizeof(uint64_t)) {
+        return false;
+      }
+      for (size_t i = value.size(); i > 0; i--) {
+        *result = (*result << 8) | static_cast<unsigned char>(value[i - 1]);
+      }
+      return true;
+    case crocksdb_property_encoding_varint: {
+      Slice input(value);
+      return GetVarint64(&input, result) && input.empty();
+    }
+    case crocksdb_property_encoding_decimal:
+      if (value.empty()) {
+        return false;
+      }
+      for (char c : value) {
+        if (c < '0' || c > '9') {
+          return false;
+        }
+        *result = *result * 10 + (c - '0');
+      }
+      return true;
+    default:
+      return false;
+  }
+}
+
+void crocksdb_table_properties_cache_aggregate(
+    crocksdb_table_properties_cache_t* cache, crocksdb_t* db,
+    crocksdb_column_family_handle_t* cf, const char* start_key,
+    size_t start_key_len, const char* limit_key, size_t limit_key_len,
+    const char* const* names, const size_t* name_lens, const int* encodings,
+    size_t num_names, uint64_t* sums, char** errptr) {
+  std::fill(sums, sums + num_names, 0);
+  Slice start(start_key, start_key_len);
+  Slice limit(limit_key, limit_key_len);
+  const Comparator* cmp = cf->rep->GetComparator();
+
+  // Must start before the file list is read, see the struct comment.
+  auto* rep = cache->rep.get();
+  crocksdb_table_properties_cache_t::LookupScope lookup(rep);
+  ColumnFamilyMetaData meta;
+  db->rep->GetColumnFamilyMetaData(cf->rep, &meta);
+  std::vector<std::shared_ptr<const TableProperties>> tables;
+  std::vector<const SstFileMetaData*> missed;
+  for (const auto& level : meta.levels) {
+    for (const auto& file : level.files) {
+      if (cmp->Compare(file.largestkey, start) < 0 ||
+          cmp->Compare(file.smallestkey, limit) >= 0) {
+        continue;
+      }
+      auto props = rep->Get(file.file_number);
+      if (props != nullptr) {
+        tables.push_back(std::move(props));
+      } else {
+        missed.push_back(&file);
+      }
+    }
+  }
+  if (!missed.empty()) {
+    Range range(start, limit);
+    TablePropertiesCollection collection;
+    Status s =
+        db->rep->GetPropertiesOfTablesInRange(cf->rep, &range, 1, &collection);
+    if (!s.ok()) {
+      SaveError(errptr, s);
+      return;
+    }
+    for (const auto* file : missed) {
+      auto it = collection.find(file->db_path + file->name);
+      // Files compacted away in the meantime are skipped.
+      if (it != collection.end() && it->second != nullptr) {
+        rep->PutIfLive(file->file_number, it->second);
+        tables.push_back(it->second);
+      }
+    }
+  }
+
+  for (const auto& props : tables) {
+    const auto& user_props = props->user_collected_properties;
+    for (size_t i = 0; i < num_names; i++) {
+      auto it = user_props.find(std::string(names[i], name_lens[i]));
+      uint64_t value = 0;
+      if (it != user_props.end() &&
+          DecodeNumericProperty(it->second, encodings[i], &value)) {
+        sums[i] += value;
+      }
+    }
+  }
+}
+
 void crocksdb_set_bottommost_compression(crocksdb_options_t* opt, uint32_t c) {
   opt->rep.bottommost_compression = static_cast<CompressionType>(c);
 }
@@ -5865,6 +9779,132 @@ uint64_t crocksdb_set_external_sst_file_global_seq_no(
   return pre_seq_no;
 }
 
+// !!! this function is dangerous because it uses rocksdb's non-public API !!!
+// Opens a table reader of a live file and collects the anchors of its index,
+// i.e. keys along with the size of the data blocks before them.
+static Status GetTableKeyAnchors(DB* db, ColumnFamilyHandle* handle,
+                                 const SstFileMetaData& file,
+                                 std::vector<TableReader::Anchor>* anchors) {
+  auto env = db->GetEnv();
+  EnvOptions env_options(db->GetDBOptions());
+  std::string path = file.db_path + file.name;
+  std::unique_ptr<FSRandomAccessFile> sst_file;
+  auto status = env->GetFileSystem()->NewRandomAccessFile(
+      path, FileOptions(env_options), &sst_file, nullptr /*dbg*/);
+  if (!status.ok()) {
+    return status;
+  }
+  std::unique_ptr<RandomAccessFileReader> sst_file_reader(
+      new RandomAccessFileReader(std::move(sst_file), path));
+
+  ColumnFamilyDescriptor desc;
+  handle->GetDescriptor(&desc);
+  auto cfd = reinterpret_cast<ColumnFamilyHandleImpl*>(handle)->cfd();
+  const auto& ioptions = *cfd->ioptions();
+  auto table_opt = TableReaderOptions(ioptions, desc.options.prefix_extractor,
+                                      env_options, cfd->internal_comparator(),
+                                      0, true /*skip_filters*/);
+  table_opt.largest_seqno = file.largest_seqno;
+  std::unique_ptr<TableReader> table_reader;
+  status = ioptions.table_factory->NewTableReader(
+      table_opt, std::move(sst_file_reader), file.size, &table_reader);
+  if (!status.ok()) {
+    return status;
+  }
+  return table_reader->ApproximateKeyAnchors(ReadOptions(), *anchors);
+}
+
+crocksdb_split_keys_t* crocksdb_get_split_keys_cf(
+    crocksdb_t* db, crocksdb_column_family_handle_t* cf, const char* start_key,
+    size_t start_key_len, const char* limit_key, size_t limit_key_len,
+    size_t num_keys, char** errptr) {
+  Slice start(start_key, start_key_len);
+  Slice limit(limit_key, limit_key_len);
+  const Comparator* cmp = cf->rep->GetComparator();
+  std::unique_ptr<crocksdb_split_keys_t> result(new crocksdb_split_keys_t);
+
+  ColumnFamilyMetaData meta;
+  db->rep->GetColumnFamilyMetaData(cf->rep, &meta);
+  // Each anchor weighs the data between the previous anchor and itself.
+  std::vector<TableReader::Anchor> in_range;
+  std::vector<TableReader::Anchor> anchors;
+  for (const auto& level : meta.levels) {
+    for (const auto& file : level.files) {
+      if (cmp->Compare(file.largestkey, start) < 0 ||
+          cmp->Compare(file.smallestkey, limit) >= 0) {
+        continue;
+      }
+      anchors.clear();
+      Status s = GetTableKeyAnchors(db->rep, cf->rep, file, &anchors);
+      if (s.IsPathNotFound()) {
+        // Compacted away in the meantime, the result stays approximate.
+        continue;
+      }
+      if (!s.ok()) {
+        SaveError(errptr, s);
+        return nullptr;
+      }
+      for (auto& anchor : anchors) {
+        if (cmp->Compare(anchor.user_key, start) >= 0 &&
+            cmp->Compare(anchor.user_key, limit) < 0) {
+          result->sst_size += anchor.range_size;
+          in_range.push_back(std::move(anchor));
+        }
+      }
+    }
+  }
+  uint64_t memtable_count = 0;
+  Range range(start, limit);
+  db->rep->GetApproximateMemTableStats(cf->rep, range, &memtable_count,
+                                       &result->memtable_size);
+
+  std::sort(in_range.begin(), in_range.end(),
+            [cmp](const TableReader::Anchor& a, const TableReader::Anchor& b) {
+              return cmp->Compare(a.user_key, b.user_key) < 0;
+            });
+  uint64_t acc = 0;
+  size_t next = 1;
+  for (const auto& anchor : in_range) {
+    if (next > num_keys) {
+      break;
+    }
+    acc += anchor.range_size;
+    if (acc * (num_keys + 1) < result->sst_size * next) {
+      continue;
+    }
+    if (result->keys.empty() ||
+        cmp->Compare(result->keys.back(), anchor.user_key) != 0) {
+      result->keys.push_back(anchor.user_key);
+    }
+    // Skip the targets this anchor also crosses.
+    while (next <= num_keys &&
+           acc * (num_keys + 1) >= result->sst_size * next) {
+      next++;
+    }
+  }
+  return result.release();
+}
+
+void crocksdb_split_keys_destroy(crocksdb_split_keys_t* keys) { delete keys; }
+
+size_t crocksdb_split_keys_count(const crocksdb_split_keys_t* keys) {
+  return keys->keys.size();
+}
+
+const char* crocksdb_split_keys_key(const crocksdb_split_keys_t* keys,
+                                    size_t index, size_t* klen) {
+  *klen = keys->keys[index].size();
+  return keys->keys[index].data();
+}
+
+uint64_t crocksdb_split_keys_sst_size(const crocksdb_split_keys_t* keys) {
+  return keys->sst_size;
+}
+
+uint64_t crocksdb_split_keys_memtable_size(const crocksdb_split_keys_t* keys) {
+  return keys->memtable_size;
+}
+
 void crocksdb_get_column_family_meta_data(
     crocksdb_t* db, crocksdb_column_family_handle_t* cf,
     crocksdb_column_family_meta_data_t* meta) {
@@ -6002,6 +10042,181 @@ void crocksdb_perf_context_reset(crocksdb_perf_context_t* ctx) {
   ctx->rep.Reset();
 }
 
+unsigned char crocksdb_perf_context_snapshot(
+    crocksdb_perf_context_t* ctx, crocksdb_perf_context_snapshot_t* snapshot) {
+  if (snapshot->version != crocksdb_perf_context_snapshot_version) {
+    return false;
+  }
+  const PerfContext& pc = ctx->rep;
+  snapshot->user_key_comparison_count = pc.user_key_comparison_count;
+  snapshot->block_cache_hit_count = pc.block_cache_hit_count;
+  snapshot->block_read_count = pc.block_read_count;
+  snapshot->block_read_byte = pc.block_read_byte;
+  snapshot->block_read_time = pc.block_read_time;
+  snapshot->block_read_cpu_time = pc.block_read_cpu_time;
+  snapshot->block_cache_index_hit_count = pc.block_cache_index_hit_count;
+  snapshot->block_cache_standalone_handle_count =
+      pc.block_cache_standalone_handle_count;
+  snapshot->block_cache_real_handle_count = pc.block_cache_real_handle_count;
+  snapshot->index_block_read_count = pc.index_block_read_count;
+  snapshot->block_cache_filter_hit_count = pc.block_cache_filter_hit_count;
+  snapshot->filter_block_read_count = pc.filter_block_read_count;
+  snapshot->compression_dict_block_read_count =
+      pc.compression_dict_block_read_count;
+  snapshot->secondary_cache_hit_count = pc.secondary_cache_hit_count;
+  snapshot->compressed_sec_cache_insert_real_count =
+      pc.compressed_sec_cache_insert_real_count;
+  snapshot->compressed_sec_cache_insert_dummy_count =
+      pc.compressed_sec_cache_insert_dummy_count;
+  snapshot->compressed_sec_cache_uncompressed_bytes =
+      pc.compressed_sec_cache_uncompressed_bytes;
+  snapshot->compressed_sec_cache_compressed_bytes =
+      pc.compressed_sec_cache_compressed_bytes;
+  snapshot->block_checksum_time = pc.block_checksum_time;
+  snapshot->block_decompress_time = pc.block_decompress_time;
+  snapshot->get_read_bytes = pc.get_read_bytes;
+  snapshot->multiget_read_bytes = pc.multiget_read_bytes;
+  snapshot->iter_read_bytes = pc.iter_read_bytes;
+  snapshot->blob_cache_hit_count = pc.blob_cache_hit_count;
+  snapshot->blob_read_count = pc.blob_read_count;
+  snapshot->blob_read_byte = pc.blob_read_byte;
+  snapshot->blob_read_time = pc.blob_read_time;
+  snapshot->blob_checksum_time = pc.blob_checksum_time;
+  snapshot->blob_decompress_time = pc.blob_decompress_time;
+  snapshot->internal_key_skipped_count = pc.internal_key_skipped_count;
+  snapshot->internal_delete_skipped_count = pc.internal_delete_skipped_count;
+  snapshot->internal_recent_skipped_count = pc.internal_recent_skipped_count;
+  snapshot->internal_merge_count = pc.internal_merge_count;
+  snapshot->internal_merge_point_lookup_count =
+      pc.internal_merge_point_lookup_count;
+  snapshot->internal_range_del_reseek_count =
+      pc.internal_range_del_reseek_count;
+  snapshot->get_snapshot_time = pc.get_snapshot_time;
+  snapshot->get_from_memtable_time = pc.get_from_memtable_time;
+  snapshot->get_from_memtable_count = pc.get_from_memtable_count;
+  snapshot->get_post_process_time = pc.get_post_process_time;
+  snapshot->get_from_output_files_time = pc.get_from_output_files_time;
+  snapshot->seek_on_memtable_time = pc.seek_on_memtable_time;
+  snapshot->seek_on_memtable_count = pc.seek_on_memtable_count;
+  snapshot->next_on_memtable_count = pc.next_on_memtable_count;
+  snapshot->prev_on_memtable_count = pc.prev_on_memtable_count;
+  snapshot->seek_child_seek_time = pc.seek_child_seek_time;
+  snapshot->seek_child_seek_count = pc.seek_child_seek_count;
+  snapshot->seek_min_heap_time = pc.seek_min_heap_time;
+  snapshot->seek_max_heap_time = pc.seek_max_heap_time;
+  snapshot->seek_internal_seek_time = pc.seek_internal_seek_time;
+  snapshot->find_next_user_entry_time = pc.find_next_user_entry_time;
+  snapshot->write_wal_time = pc.write_wal_time;
+  snapshot->write_memtable_time = pc.write_memtable_time;
+  snapshot->write_delay_time = pc.write_delay_time;
+  snapshot->write_scheduling_flushes_compactions_time =
+      pc.write_scheduling_flushes_compactions_time;
+  snapshot->write_pre_and_post_process_time =
+      pc.write_pre_and_post_process_time;
+  snapshot->write_thread_wait_nanos = pc.write_thread_wait_nanos;
+  snapshot->db_mutex_lock_nanos = pc.db_mutex_lock_nanos;
+  snapshot->db_condition_wait_nanos = pc.db_condition_wait_nanos;
+  snapshot->merge_operator_time_nanos = pc.merge_operator_time_nanos;
+  snapshot->read_index_block_nanos = pc.read_index_block_nanos;
+  snapshot->read_filter_block_nanos = pc.read_filter_block_nanos;
+  snapshot->new_table_block_iter_nanos = pc.new_table_block_iter_nanos;
+  snapshot->new_table_iterator_nanos = pc.new_table_iterator_nanos;
+  snapshot->block_seek_nanos = pc.block_seek_nanos;
+  snapshot->find_table_nanos = pc.find_table_nanos;
+  snapshot->bloom_memtable_hit_count = pc.bloom_memtable_hit_count;
+  snapshot->bloom_memtable_miss_count = pc.bloom_memtable_miss_count;
+  snapshot->bloom_sst_hit_count = pc.bloom_sst_hit_count;
+  snapshot->bloom_sst_miss_count = pc.bloom_sst_miss_count;
+  snapshot->key_lock_wait_time = pc.key_lock_wait_time;
+  snapshot->key_lock_wait_count = pc.key_lock_wait_count;
+  snapshot->env_new_sequential_file_nanos = pc.env_new_sequential_file_nanos;
+  snapshot->env_new_random_access_file_nanos =
+      pc.env_new_random_access_file_nanos;
+  snapshot->env_new_writable_file_nanos = pc.env_new_writable_file_nanos;
+  snapshot->env_reuse_writable_file_nanos = pc.env_reuse_writable_file_nanos;
+  snapshot->env_new_random_rw_file_nanos = pc.env_new_random_rw_file_nanos;
+  snapshot->env_new_directory_nanos = pc.env_new_directory_nanos;
+  snapshot->env_file_exists_nanos = pc.env_file_exists_nanos;
+  snapshot->env_get_children_nanos = pc.env_get_children_nanos;
+  snapshot->env_get_children_file_attributes_nanos =
+      pc.env_get_children_file_attributes_nanos;
+  snapshot->env_delete_file_nanos = pc.env_delete_file_nanos;
+  snapshot->env_create_dir_nanos = pc.env_create_dir_nanos;
+  snapshot->env_create_dir_if_missing_nanos =
+      pc.env_create_dir_if_missing_nanos;
+  snapshot->env_delete_dir_nanos = pc.env_delete_dir_nanos;
+  snapshot->env_get_file_size_nanos = pc.env_get_file_size_nanos;
+  snapshot->env_get_file_modification_time_nanos =
+      pc.env_get_file_modification_time_nanos;
+  snapshot->env_rename_file_nanos = pc.env_rename_file_nanos;
+  snapshot->env_link_file_nanos = pc.env_link_file_nanos;
+  snapshot->env_lock_file_nanos = pc.env_lock_file_nanos;
+  snapshot->env_unlock_file_nanos = pc.env_unlock_file_nanos;
+  snapshot->env_new_logger_nanos = pc.env_new_logger_nanos;
+  snapshot->get_cpu_nanos = pc.get_cpu_nanos;
+  snapshot->iter_next_cpu_nanos = pc.iter_next_cpu_nanos;
+  snapshot->iter_prev_cpu_nanos = pc.iter_prev_cpu_nanos;
+  snapshot->iter_seek_cpu_nanos = pc.iter_seek_cpu_nanos;
+  snapshot->iter_next_count = pc.iter_next_count;
+  snapshot->iter_prev_count = pc.iter_prev_count;
+  snapshot->iter_seek_count = pc.iter_seek_count;
+  snapshot->encrypt_data_nanos = pc.encrypt_data_nanos;
+  snapshot->decrypt_data_nanos = pc.decrypt_data_nanos;
+  snapshot->number_async_seek = pc.number_async_seek;
+  memset(snapshot->levels, 0, sizeof(snapshot->levels));
+  snapshot->num_levels = 0;
+  if (pc.level_to_perf_context != nullptr) {
+    for (auto& l : *pc.level_to_perf_context) {
+      if (l.first >=
+          static_cast<uint32_t>(crocksdb_perf_context_snapshot_max_levels)) {
+        continue;
+      }
+      crocksdb_perf_context_level_t& level = snapshot->levels[l.first];
+      level.bloom_filter_useful = l.second.bloom_filter_useful;
+      level.bloom_filter_full_positive = l.second.bloom_filter_full_positive;
+      level.bloom_filter_full_true_positive =
+          l.second.bloom_filter_full_true_positive;
+      level.user_key_return_count = l.second.user_key_return_count;
+      level.get_from_table_nanos = l.second.get_from_table_nanos;
+      level.block_cache_hit_count = l.second.block_cache_hit_count;
+      level.block_cache_miss_count = l.second.block_cache_miss_count;
+      snapshot->num_levels =
+          std::max(snapshot->num_levels, static_cast<uint32_t>(l.first + 1));
+    }
+  }
+  return true;
+}
+
+void crocksdb_perf_context_snapshot_diff(
+    const crocksdb_perf_context_snapshot_t* before,
+    const crocksdb_perf_context_snapshot_t* after,
+    crocksdb_perf_context_snapshot_t* diff) {
+  // Every field after the header is a uint64_t counter.
+  constexpr size_t kBegin =
+      offsetof(crocksdb_perf_context_snapshot_t, user_key_comparison_count);
+  static_assert(
+      (sizeof(crocksdb_perf_context_snapshot_t) - kBegin) % sizeof(uint64_t) ==
+          0,
+      "crocksdb_perf_context_snapshot_t must only hold uint64_t counters");
+  *diff = *after;
+  for (size_t off = kBegin; off < sizeof(*diff); off += sizeof(uint64_t)) {
+    uint64_t b, a;
+    memcpy(&b, reinterpret_cast<const char*>(before) + off, sizeof(b));
+    memcpy(&a, reinterpret_cast<const char*>(after) + off, sizeof(a));
+    a -= b;
+    memcpy(reinterpret_cast<char*>(diff) + off, &a, sizeof(a));
+  }
+}
+
+void crocksdb_perf_context_set_per_level_enabled(crocksdb_perf_context_t* ctx,
+                                                 unsigned char enabled) {
+  if (enabled) {
+    ctx->rep.EnablePerLevelPerfContext();
+  } else {
+    ctx->rep.DisablePerLevelPerfContext();
+  }
+}
+
 uint64_t crocksdb_perf_context_user_key_comparison_count(
     crocksdb_perf_context_t* ctx) {
   return ctx->rep.user_key_comparison_count;
@@ -6441,6 +10656,23 @@ uint64_t crocksdb_iostats_context_logger_nanos(
   return ctx->rep.logger_nanos;
 }
 
+void crocksdb_iostats_context_snapshot(crocksdb_iostats_context_t* ctx,
+                                       crocksdb_iostats_snapshot_t* snapshot) {
+  const IOStatsContext& io = ctx->rep;
+  snapshot->bytes_written = io.bytes_written;
+  snapshot->bytes_read = io.bytes_read;
+  snapshot->open_nanos = io.open_nanos;
+  snapshot->allocate_nanos = io.allocate_nanos;
+  snapshot->write_nanos = io.write_nanos;
+  snapshot->read_nanos = io.read_nanos;
+  snapshot->range_sync_nanos = io.range_sync_nanos;
+  snapshot->fsync_nanos = io.fsync_nanos;
+  snapshot->prepare_write_nanos = io.prepare_write_nanos;
+  snapshot->logger_nanos = io.logger_nanos;
+  snapshot->cpu_write_nanos = io.cpu_write_nanos;
+  snapshot->cpu_read_nanos = io.cpu_read_nanos;
+}
+
 crocksdb_sst_partitioner_request_t* crocksdb_sst_partitioner_request_create() {
   auto* req = new crocksdb_sst_partitioner_request_t;
   req->rep =
@@ -6717,6 +10949,139 @@ crocksdb_sst_partitioner_t* crocksdb_sst_partitioner_factory_create_partitioner(
   return partitioner;
 }
 
+// Sorted, deduplicated region boundaries, compared bytewise. Published as
+// a whole so that a compaction sees one consistent set.
+struct crocksdb_sst_partitioner_boundaries_t {
+  struct Set {
+    std::vector<std::string> keys;
+
+    // Number of boundaries not greater than `key`.
+    size_t Rank(const Slice& key) const {
+      size_t len = keys.size();
+      if (len == 0) {
+        return 0;
+      }
+      const std::string* first = keys.data();
+      while (len > 1) {
+        size_t half = len / 2;
+        // Compiles to a conditional move instead of a branch.
+        first += (key.compare(first[half - 1]) >= 0) ? half : 0;
+        len -= half;
+      }
+      return static_cast<size_t>(first - keys.data()) +
+             (key.compare(*first) >= 0);
+    }
+  };
+
+  // Shared with the partitioner factories, which may outlive the handle.
+  struct Rep {
+    std::shared_ptr<const Set> Load() const { return std::atomic_load(&set); }
+    void Store(std::shared_ptr<const Set> s) { std::atomic_store(&set, s); }
+
+    std::shared_ptr<const Set> set = std::make_shared<Set>();
+  };
+  std::shared_ptr<Rep> rep = std::make_shared<Rep>();
+};
+
+class BoundarySstPartitioner : public SstPartitioner {
+ public:
+  BoundarySstPartitioner(
+      std::shared_ptr<const crocksdb_sst_partitioner_boundaries_t::Set>
+          boundaries,
+      uint64_t min_output_file_size)
+      : boundaries_(std::move(boundaries)),
+        min_output_file_size_(min_output_file_size) {}
+
+  const char* Name() const override {
+    return "crocksdb.BoundarySstPartitioner";
+  }
+
+  PartitionerResult ShouldPartition(
+      const PartitionerRequest& request) override {
+    if (request.current_output_file_size < min_output_file_size_) {
+      return rocksdb::kNotRequired;
+    }
+    return boundaries_->Rank(*request.prev_user_key) !=
+                   boundaries_->Rank(*request.current_user_key)
+               ? rocksdb::kRequired
+               : rocksdb::kNotRequired;
+  }
+
+  bool CanDoTrivialMove(const Slice& smallest_user_key,
+                        const Slice& largest_user_key) override {
+    return boundaries_->Rank(smallest_user_key) ==
+           boundaries_->Rank(largest_user_key);
+  }
+
+ private:
+  std::shared_ptr<const crocksdb_sst_partitioner_boundaries_t::Set>
+      boundaries_;
+  const uint64_t min_output_file_size_;
+};
+
+class BoundarySstPartitionerFactory : public SstPartitionerFactory {
+ public:
+  BoundarySstPartitionerFactory(
+      std::shared_ptr<crocksdb_sst_partitioner_boundaries_t::Rep> boundaries,
+      uint64_t min_output_file_size)
+      : boundaries_(std::move(boundaries)),
+        min_output_file_size_(min_output_file_size) {}
+
+  const char* Name() const override {
+    return "crocksdb.BoundarySstPartitionerFactory";
+  }
+
+  std::unique_ptr<SstPartitioner> CreatePartitioner(
+      const SstPartitioner::Context& /*context*/) const override {
+    return std::unique_ptr<SstPartitioner>(
+        new BoundarySstPartitioner(boundaries_->Load(), min_output_file_size_));
+  }
+
+ private:
+  std::shared_ptr<crocksdb_sst_partitioner_boundaries_t::Rep> boundaries_;
+  const uint64_t min_output_file_size_;
+};
+
+crocksdb_sst_partitioner_boundaries_t*
+crocksdb_sst_partitioner_boundaries_create() {
+  return new crocksdb_sst_partitioner_boundaries_t;
+}
+
+void crocksdb_sst_partitioner_boundaries_destroy(
+    crocksdb_sst_partitioner_boundaries_t* boundaries) {
+  delete boundaries;
+}
+
+void crocksdb_sst_partitioner_boundaries_set(
+    crocksdb_sst_partitioner_boundaries_t* boundaries, const char* const* keys,
+    const size_t* key_lens, size_t num_keys) {
+  auto set = std::make_shared<crocksdb_sst_partitioner_boundaries_t::Set>();
+  set->keys.reserve(num_keys);
+  for (size_t i = 0; i < num_keys; i++) {
+    set->keys.emplace_back(keys[i], key_lens[i]);
+  }
+  std::sort(set->keys.begin(), set->keys.end());
+  set->keys.erase(std::unique(set->keys.begin(), set->keys.end()),
+                  set->keys.end());
+  boundaries->rep->Store(std::move(set));
+}
+
+size_t crocksdb_sst_partitioner_boundaries_len(
+    const crocksdb_sst_partitioner_boundaries_t* boundaries) {
+  return boundaries->rep->Load()->keys.size();
+}
+
+crocksdb_sst_partitioner_factory_t*
+crocksdb_sst_partitioner_factory_create_boundary(
+    const crocksdb_sst_partitioner_boundaries_t* boundaries,
+    uint64_t min_output_file_size) {
+  crocksdb_sst_partitioner_factory_t* factory =
+      new crocksdb_sst_partitioner_factory_t;
+  factory->rep = std::make_shared<BoundarySstPartitionerFactory>(
+      boundaries->rep, min_output_file_size);
+  return factory;
+}
+
 /* Tools */
 
 void crocksdb_run_ldb_tool(int argc, char** argv,
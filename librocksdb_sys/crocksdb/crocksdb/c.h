@@ -12,7 +12,8 @@
 
   Does not support:
   . getters for the option types
-  . custom comparators that implement key shortening
+  . custom comparators that implement key shortening (use the built-in
+    comparators from crocksdb_comparator_create_builtin instead)
   . capturing post-write-snapshot
   . custom iter, db, env, cache implementations using just the C bindings
 
@@ -80,6 +81,7 @@ typedef struct crocksdb_lru_cache_options_t crocksdb_lru_cache_options_t;
 typedef struct crocksdb_hyper_clock_cache_options_t
     crocksdb_hyper_clock_cache_options_t;
 typedef struct crocksdb_cache_t crocksdb_cache_t;
+typedef struct crocksdb_secondary_cache_t crocksdb_secondary_cache_t;
 typedef struct crocksdb_memory_allocator_t crocksdb_memory_allocator_t;
 typedef struct crocksdb_compactionfilter_t crocksdb_compactionfilter_t;
 typedef struct crocksdb_checkpoint_t crocksdb_checkpoint_t;
@@ -93,6 +95,7 @@ typedef struct crocksdb_fifo_compaction_options_t
     crocksdb_fifo_compaction_options_t;
 typedef struct crocksdb_filelock_t crocksdb_filelock_t;
 typedef struct crocksdb_filterpolicy_t crocksdb_filterpolicy_t;
+typedef struct crocksdb_filter_stats_t crocksdb_filter_stats_t;
 typedef struct crocksdb_flushoptions_t crocksdb_flushoptions_t;
 typedef struct crocksdb_iterator_t crocksdb_iterator_t;
 typedef struct crocksdb_logger_t crocksdb_logger_t;
@@ -151,6 +154,9 @@ typedef struct crocksdb_externalfileingestioninfo_t
 typedef struct crocksdb_eventlistener_t crocksdb_eventlistener_t;
 typedef struct crocksdb_post_write_callback_t crocksdb_post_write_callback_t;
 typedef struct crocksdb_keyversions_t crocksdb_keyversions_t;
+typedef struct crocksdb_split_keys_t crocksdb_split_keys_t;
+typedef struct crocksdb_table_properties_cache_t
+    crocksdb_table_properties_cache_t;
 typedef struct crocksdb_column_family_meta_data_t
     crocksdb_column_family_meta_data_t;
 typedef struct crocksdb_level_meta_data_t crocksdb_level_meta_data_t;
@@ -172,6 +178,8 @@ typedef struct crocksdb_sst_partitioner_context_t
     crocksdb_sst_partitioner_context_t;
 typedef struct crocksdb_sst_partitioner_factory_t
     crocksdb_sst_partitioner_factory_t;
+typedef struct crocksdb_sst_partitioner_boundaries_t
+    crocksdb_sst_partitioner_boundaries_t;
 
 typedef enum crocksdb_table_u64_property_t {
   kDataSize = 1,
@@ -391,6 +399,36 @@ extern C_ROCKSDB_LIBRARY_API void crocksdb_delete_range_cf(
     crocksdb_column_family_handle_t* column_family, const char* begin_key,
     size_t begin_keylen, const char* end_key, size_t end_keylen, char** errptr);
 
+/* User-defined timestamp. The column family must use a comparator whose
+ * timestamp size equals tslen. */
+
+extern C_ROCKSDB_LIBRARY_API void crocksdb_put_cf_with_ts(
+    crocksdb_t* db, const crocksdb_writeoptions_t* options,
+    crocksdb_column_family_handle_t* column_family, const char* key,
+    size_t keylen, const char* ts, size_t tslen, const char* val,
+    size_t vallen, char** errptr);
+extern C_ROCKSDB_LIBRARY_API void crocksdb_delete_cf_with_ts(
+    crocksdb_t* db, const crocksdb_writeoptions_t* options,
+    crocksdb_column_family_handle_t* column_family, const char* key,
+    size_t keylen, const char* ts, size_t tslen, char** errptr);
+extern C_ROCKSDB_LIBRARY_API void crocksdb_single_delete_cf_with_ts(
+    crocksdb_t* db, const crocksdb_writeoptions_t* options,
+    crocksdb_column_family_handle_t* column_family, const char* key,
+    size_t keylen, const char* ts, size_t tslen, char** errptr);
+extern C_ROCKSDB_LIBRARY_API void crocksdb_delete_range_cf_with_ts(
+    crocksdb_t* db, const crocksdb_writeoptions_t* options,
+    crocksdb_column_family_handle_t* column_family, const char* begin_key,
+    size_t begin_keylen, const char* end_key, size_t end_keylen,
+    const char* ts, size_t tslen, char** errptr);
+/* Versions older than full_history_ts_low may be garbage collected by
+ * compaction. The value can only increase. */
+extern C_ROCKSDB_LIBRARY_API void crocksdb_increase_full_history_ts_low(
+    crocksdb_t* db, crocksdb_column_family_handle_t* column_family,
+    const char* ts_low, size_t ts_lowlen, char** errptr);
+extern C_ROCKSDB_LIBRARY_API char* crocksdb_get_full_history_ts_low(
+    crocksdb_t* db, crocksdb_column_family_handle_t* column_family,
+    size_t* ts_lowlen, char** errptr);
+
 extern C_ROCKSDB_LIBRARY_API void crocksdb_merge(
     crocksdb_t* db, const crocksdb_writeoptions_t* options, const char* key,
     size_t keylen, const char* val, size_t vallen, char** errptr);
@@ -440,6 +478,8 @@ extern C_ROCKSDB_LIBRARY_API char* crocksdb_get_cf(
 // each non-NULL errs entry is a malloc()ed, null terminated string.
 // each non-NULL values_list entry is a malloc()ed array, with
 // the length for each stored in values_list_sizes[i].
+// keys are looked up as one batch, so the blocks they need from a file are
+// read with one MultiRead.
 extern C_ROCKSDB_LIBRARY_API void crocksdb_multi_get(
     crocksdb_t* db, const crocksdb_readoptions_t* options, size_t num_keys,
     const char* const* keys_list, const size_t* keys_list_sizes,
@@ -627,6 +667,8 @@ extern C_ROCKSDB_LIBRARY_API const char* crocksdb_iter_value(
     const crocksdb_iterator_t*, size_t* vlen);
 extern C_ROCKSDB_LIBRARY_API void crocksdb_iter_get_error(
     const crocksdb_iterator_t*, char** errptr);
+extern C_ROCKSDB_LIBRARY_API const char* crocksdb_iter_timestamp(
+    const crocksdb_iterator_t*, size_t* tslen);
 
 /* Write batch */
 
@@ -677,6 +719,18 @@ extern C_ROCKSDB_LIBRARY_API void crocksdb_writebatch_delete(
 extern C_ROCKSDB_LIBRARY_API void crocksdb_writebatch_delete_cf(
     crocksdb_writebatch_t*, crocksdb_column_family_handle_t* column_family,
     const char* key, size_t klen);
+extern C_ROCKSDB_LIBRARY_API void crocksdb_writebatch_put_cf_with_ts(
+    crocksdb_writebatch_t*, crocksdb_column_family_handle_t* column_family,
+    const char* key, size_t klen, const char* ts, size_t tslen,
+    const char* val, size_t vlen, char** errptr);
+extern C_ROCKSDB_LIBRARY_API void crocksdb_writebatch_delete_cf_with_ts(
+    crocksdb_writebatch_t*, crocksdb_column_family_handle_t* column_family,
+    const char* key, size_t klen, const char* ts, size_t tslen,
+    char** errptr);
+extern C_ROCKSDB_LIBRARY_API void crocksdb_writebatch_single_delete_cf_with_ts(
+    crocksdb_writebatch_t*, crocksdb_column_family_handle_t* column_family,
+    const char* key, size_t klen, const char* ts, size_t tslen,
+    char** errptr);
 extern C_ROCKSDB_LIBRARY_API void crocksdb_writebatch_single_delete(
     crocksdb_writebatch_t*, const char* key, size_t klen);
 extern C_ROCKSDB_LIBRARY_API void crocksdb_writebatch_single_delete_cf(
@@ -998,6 +1052,117 @@ extern C_ROCKSDB_LIBRARY_API void crocksdb_eventlistener_destroy(
 extern C_ROCKSDB_LIBRARY_API void crocksdb_options_add_eventlistener(
     crocksdb_options_t*, crocksdb_eventlistener_t*);
 
+/* Event ring */
+
+enum {
+  crocksdb_event_flush_completed = 0,
+  crocksdb_event_compaction_completed = 1,
+  crocksdb_event_external_file_ingested = 2,
+  crocksdb_event_stall_conditions_changed = 3,
+  crocksdb_event_background_error = 4,
+};
+
+// Fixed-size summary of a background event. Fields that don't apply to an
+// event type are zero, and levels are -1. `reason` is the flush, compaction
+// or background error reason, or the current write stall condition.
+// `elapsed_micros` is the duration of a flush or compaction.
+struct crocksdb_event_record_t {
+  uint64_t job_id;
+  uint64_t file_number;
+  uint64_t input_bytes;
+  uint64_t output_bytes;
+  uint64_t num_input_files;
+  uint64_t num_output_files;
+  uint64_t elapsed_micros;
+  int32_t type;
+  int32_t reason;
+  int32_t prev_reason;
+  int32_t status_code;
+  int32_t input_level;
+  int32_t output_level;
+  uint32_t cf_name_len;
+  uint32_t path_len;
+  // Truncated to the first bytes of the name.
+  char cf_name[64];
+  // Truncated to the last bytes of the path.
+  char path[192];
+};
+typedef struct crocksdb_event_record_t crocksdb_event_record_t;
+typedef struct crocksdb_event_ring_t crocksdb_event_ring_t;
+
+// Creates a bounded queue holding at least `capacity` records. Events are
+// recorded without calling back into the host, and are dropped when the
+// queue is full.
+extern C_ROCKSDB_LIBRARY_API crocksdb_event_ring_t* crocksdb_event_ring_create(
+    size_t capacity);
+extern C_ROCKSDB_LIBRARY_API void crocksdb_event_ring_destroy(
+    crocksdb_event_ring_t*);
+extern C_ROCKSDB_LIBRARY_API void crocksdb_options_add_event_ring(
+    crocksdb_options_t*, crocksdb_event_ring_t*);
+// Moves up to `max_records` of the oldest records into `records` and returns
+// how many were moved.
+extern C_ROCKSDB_LIBRARY_API size_t crocksdb_event_ring_drain(
+    crocksdb_event_ring_t*, crocksdb_event_record_t* records,
+    size_t max_records);
+extern C_ROCKSDB_LIBRARY_API uint64_t
+crocksdb_event_ring_dropped(const crocksdb_event_ring_t*);
+
+/* File IO stats */
+
+enum {
+  crocksdb_file_io_read = 0,
+  crocksdb_file_io_write = 1,
+  // Includes range syncs.
+  crocksdb_file_io_sync = 2,
+};
+
+enum {
+  crocksdb_io_file_type_table = 0,
+  crocksdb_io_file_type_wal = 1,
+  crocksdb_io_file_type_manifest = 2,
+  crocksdb_io_file_type_blob = 3,
+  crocksdb_io_file_type_other = 4,
+};
+
+struct crocksdb_io_histogram_t {
+  uint64_t count;
+  uint64_t bytes;
+  // Operations that returned an error.
+  uint64_t errors;
+  uint64_t total_nanos;
+  uint64_t max_nanos;
+  // buckets[0] counts operations faster than 1us, buckets[i] those taking
+  // [2^(i-1), 2^i) us. The last bucket also holds everything slower.
+  uint64_t buckets[32];
+};
+typedef struct crocksdb_io_histogram_t crocksdb_io_histogram_t;
+typedef struct crocksdb_file_io_stats_t crocksdb_file_io_stats_t;
+
+// Latency histograms of file reads, writes and syncs, aggregated natively by
+// file type and, for table files, by LSM level. The level of a flushed or
+// compacted file is known when its creation starts, and that of an ingested
+// file once it is ingested. Files that existed before are attributed from
+// the first flush or compaction on.
+extern C_ROCKSDB_LIBRARY_API crocksdb_file_io_stats_t*
+crocksdb_file_io_stats_create();
+extern C_ROCKSDB_LIBRARY_API void crocksdb_file_io_stats_destroy(
+    crocksdb_file_io_stats_t*);
+extern C_ROCKSDB_LIBRARY_API void crocksdb_options_add_file_io_stats(
+    crocksdb_options_t*, crocksdb_file_io_stats_t*);
+// `op` is one of crocksdb_file_io_* and `file_type` one of
+// crocksdb_io_file_type_*. Levels range from 0 to 7.
+extern C_ROCKSDB_LIBRARY_API void crocksdb_file_io_stats_by_file_type(
+    const crocksdb_file_io_stats_t*, int op, int file_type,
+    crocksdb_io_histogram_t* hist);
+extern C_ROCKSDB_LIBRARY_API void crocksdb_file_io_stats_by_level(
+    const crocksdb_file_io_stats_t*, int op, int level,
+    crocksdb_io_histogram_t* hist);
+extern C_ROCKSDB_LIBRARY_API void crocksdb_file_io_stats_table_files(
+    const crocksdb_file_io_stats_t*, uint64_t* created,
+    uint64_t* created_bytes, uint64_t* deleted);
+extern C_ROCKSDB_LIBRARY_API void crocksdb_file_io_stats_reset(
+    crocksdb_file_io_stats_t*);
+
 typedef void (*on_post_write_callback_cb)(void*, uint64_t);
 extern C_ROCKSDB_LIBRARY_API crocksdb_post_write_callback_t*
 crocksdb_post_write_callback_init(
@@ -1057,6 +1222,9 @@ extern C_ROCKSDB_LIBRARY_API void crocksdb_options_compaction_readahead_size(
     crocksdb_options_t*, size_t);
 extern C_ROCKSDB_LIBRARY_API void crocksdb_options_set_comparator(
     crocksdb_options_t*, crocksdb_comparator_t*);
+extern C_ROCKSDB_LIBRARY_API void
+crocksdb_options_set_persist_user_defined_timestamps(crocksdb_options_t*,
+                                                     unsigned char);
 extern C_ROCKSDB_LIBRARY_API void crocksdb_options_set_merge_operator(
     crocksdb_options_t*, crocksdb_mergeoperator_t*);
 extern C_ROCKSDB_LIBRARY_API void crocksdb_options_set_compression_per_level(
@@ -1203,6 +1371,39 @@ extern C_ROCKSDB_LIBRARY_API unsigned char crocksdb_statistics_get_histogram(
     double* percentile95, double* percentile99, double* average,
     double* standard_deviation, double* max);
 
+struct crocksdb_histogram_summary_t {
+  uint64_t count;
+  uint64_t sum;
+  double min;
+  double max;
+  double average;
+  double standard_deviation;
+  double p50;
+  double p95;
+  double p99;
+  double p999;
+};
+typedef struct crocksdb_histogram_summary_t crocksdb_histogram_summary_t;
+
+// Number of tickers and histograms of `statistics`, including Titan's for
+// statistics created by crocksdb_titan_statistics_create. 0 when empty.
+extern C_ROCKSDB_LIBRARY_API uint32_t
+crocksdb_statistics_num_tickers(crocksdb_statistics_t* statistics);
+extern C_ROCKSDB_LIBRARY_API uint32_t
+crocksdb_statistics_num_histograms(crocksdb_statistics_t* statistics);
+// Fills `tickers[i]` and `histograms[i]` with ticker and histogram `i` in one
+// call. Entries beyond those the statistics know are zeroed. p999 is parsed
+// from crocksdb_statistics_get_histogram_string, as RocksDB's HistogramData
+// has no such field, and is 0 if it can't be found there.
+// With `reset` and num_histograms == 0, each ticker is read and reset
+// atomically. With histograms, everything is reset at once after being read,
+// as histograms can't be reset alone: updates recorded between their read and
+// that reset are lost.
+extern C_ROCKSDB_LIBRARY_API void crocksdb_statistics_export(
+    crocksdb_statistics_t* statistics, uint64_t* tickers, size_t num_tickers,
+    crocksdb_histogram_summary_t* histograms, size_t num_histograms,
+    unsigned char reset);
+
 extern C_ROCKSDB_LIBRARY_API void crocksdb_options_set_max_write_buffer_number(
     crocksdb_options_t*, int);
 extern C_ROCKSDB_LIBRARY_API int crocksdb_options_get_max_write_buffer_number(
@@ -1296,6 +1497,9 @@ extern C_ROCKSDB_LIBRARY_API void crocksdb_options_set_bytes_per_sync(
     crocksdb_options_t*, uint64_t);
 extern C_ROCKSDB_LIBRARY_API void crocksdb_options_set_enable_pipelined_write(
     crocksdb_options_t*, unsigned char);
+// Required by crocksdb_get_background_jobs.
+extern C_ROCKSDB_LIBRARY_API void crocksdb_options_set_enable_thread_tracking(
+    crocksdb_options_t*, unsigned char);
 extern C_ROCKSDB_LIBRARY_API void crocksdb_options_set_enable_multi_batch_write(
     crocksdb_options_t* opt, unsigned char v);
 extern C_ROCKSDB_LIBRARY_API unsigned char
@@ -1570,6 +1774,27 @@ extern C_ROCKSDB_LIBRARY_API crocksdb_comparator_t* crocksdb_comparator_create(
     const char* (*name)(void*));
 extern C_ROCKSDB_LIBRARY_API void crocksdb_comparator_destroy(
     crocksdb_comparator_t*);
+/* Returns a native comparator by its Name(), or NULL if unknown. Supported:
+ *   "leveldb.BytewiseComparator"
+ *   "rocksdb.ReverseBytewiseComparator"
+ *   "leveldb.BytewiseComparator.u64ts": with a user-defined u64 timestamp
+ *   "rocksdb.ReverseBytewiseComparator.u64ts": likewise
+ *   "crocksdb.U64PrefixBytewiseComparator": 8-byte big-endian prefix + bytes
+ *   "crocksdb.BytewiseDescTsSuffixComparator": bytes + 8-byte big-endian ts,
+ *       newer ts first
+ */
+extern C_ROCKSDB_LIBRARY_API crocksdb_comparator_t*
+crocksdb_comparator_create_builtin(const char* name, char** errptr);
+extern C_ROCKSDB_LIBRARY_API size_t
+crocksdb_comparator_timestamp_size(const crocksdb_comparator_t*);
+/* Run the comparator's key shortening on a copy of the key. The result is
+ * malloc()ed and must be freed by the caller. */
+extern C_ROCKSDB_LIBRARY_API char* crocksdb_comparator_find_shortest_separator(
+    const crocksdb_comparator_t*, const char* start, size_t start_len,
+    const char* limit, size_t limit_len, size_t* result_len);
+extern C_ROCKSDB_LIBRARY_API char* crocksdb_comparator_find_short_successor(
+    const crocksdb_comparator_t*, const char* key, size_t key_len,
+    size_t* result_len);
 
 /* Filter policy */
 
@@ -1584,6 +1809,41 @@ extern C_ROCKSDB_LIBRARY_API crocksdb_filterpolicy_t*
 crocksdb_filterpolicy_create_ribbon(double bits_per_key,
                                     int bloom_before_level);
 
+enum {
+  crocksdb_level_filter_none = 0,
+  crocksdb_level_filter_bloom = 1,
+  crocksdb_level_filter_ribbon = 2,
+};
+
+// Filter policy whose type (one of crocksdb_level_filter_*) and bits-per-key
+// are chosen by the level a file is written to. `types` and `bits_per_key`
+// hold `num_levels` entries; deeper levels, and files of unknown level, use
+// the last one. If `skip_bottommost` is set, filters are skipped for files
+// RocksDB writes as bottommost (FilterBuildingContext::is_bottommost), which
+// excludes ingested files. If `stats` is not NULL, probes are counted into
+// it per filter type; the counters are shared, so either side can be
+// destroyed first.
+extern C_ROCKSDB_LIBRARY_API crocksdb_filterpolicy_t*
+crocksdb_filterpolicy_create_level_aware(const int* types,
+                                         const double* bits_per_key,
+                                         size_t num_levels,
+                                         unsigned char skip_bottommost,
+                                         crocksdb_filter_stats_t* stats);
+
+extern C_ROCKSDB_LIBRARY_API crocksdb_filter_stats_t*
+crocksdb_filter_stats_create();
+extern C_ROCKSDB_LIBRARY_API void crocksdb_filter_stats_destroy(
+    crocksdb_filter_stats_t*);
+// Number of filter probes, for a filter type.
+extern C_ROCKSDB_LIBRARY_API uint64_t
+crocksdb_filter_stats_probes(const crocksdb_filter_stats_t*, int type);
+// Number of probes that ruled a key out, for a filter type.
+extern C_ROCKSDB_LIBRARY_API uint64_t
+crocksdb_filter_stats_useful(const crocksdb_filter_stats_t*, int type);
+// Total size of the filters currently loaded, for a filter type.
+extern C_ROCKSDB_LIBRARY_API uint64_t
+crocksdb_filter_stats_resident_bytes(const crocksdb_filter_stats_t*, int type);
+
 /* Merge Operator */
 
 extern C_ROCKSDB_LIBRARY_API crocksdb_mergeoperator_t*
@@ -1618,12 +1878,24 @@ extern C_ROCKSDB_LIBRARY_API void crocksdb_readoptions_set_auto_prefix_mode(
     crocksdb_readoptions_t*, unsigned char);
 extern C_ROCKSDB_LIBRARY_API void crocksdb_readoptions_set_adaptive_readahead(
     crocksdb_readoptions_t*, unsigned char);
+// Lets iterators prefetch with asynchronous reads, and MultiGet read files
+// of different levels in parallel. Reads are only issued concurrently when
+// the file system supports it, see crocksdb_io_uring_supported.
+extern C_ROCKSDB_LIBRARY_API void crocksdb_readoptions_set_async_io(
+    crocksdb_readoptions_t*, unsigned char);
+extern C_ROCKSDB_LIBRARY_API void
+crocksdb_readoptions_set_optimize_multiget_for_io(crocksdb_readoptions_t*,
+                                                  unsigned char);
 extern C_ROCKSDB_LIBRARY_API void crocksdb_readoptions_set_snapshot(
     crocksdb_readoptions_t*, const crocksdb_snapshot_t*);
 extern C_ROCKSDB_LIBRARY_API void crocksdb_readoptions_set_iterate_lower_bound(
     crocksdb_readoptions_t*, const char* key, size_t keylen);
 extern C_ROCKSDB_LIBRARY_API void crocksdb_readoptions_set_iterate_upper_bound(
     crocksdb_readoptions_t*, const char* key, size_t keylen);
+extern C_ROCKSDB_LIBRARY_API void crocksdb_readoptions_set_timestamp(
+    crocksdb_readoptions_t*, const char* ts, size_t tslen);
+extern C_ROCKSDB_LIBRARY_API void crocksdb_readoptions_set_iter_start_ts(
+    crocksdb_readoptions_t*, const char* ts, size_t tslen);
 extern C_ROCKSDB_LIBRARY_API void crocksdb_readoptions_set_read_tier(
     crocksdb_readoptions_t*, int);
 extern C_ROCKSDB_LIBRARY_API void crocksdb_readoptions_set_tailing(
@@ -1743,6 +2015,12 @@ crocksdb_lru_cache_options_set_low_pri_pool_ratio(crocksdb_lru_cache_options_t*,
 extern C_ROCKSDB_LIBRARY_API void
 crocksdb_lru_cache_options_set_memory_allocator(crocksdb_lru_cache_options_t*,
                                                 crocksdb_memory_allocator_t*);
+// Blocks evicted from the cache are kept in `secondary_cache`, which is
+// looked up on a miss before reading the file. Hits are counted by the
+// SECONDARY_CACHE_* and COMPRESSED_SECONDARY_CACHE_* statistics tickers.
+extern C_ROCKSDB_LIBRARY_API void
+crocksdb_lru_cache_options_set_secondary_cache(crocksdb_lru_cache_options_t*,
+                                               crocksdb_secondary_cache_t*);
 extern C_ROCKSDB_LIBRARY_API crocksdb_cache_t* crocksdb_cache_create_lru(
     crocksdb_lru_cache_options_t*);
 extern C_ROCKSDB_LIBRARY_API crocksdb_hyper_clock_cache_options_t*
@@ -1751,15 +2029,239 @@ crocksdb_hyper_clock_cache_options_create(size_t capacity,
 extern C_ROCKSDB_LIBRARY_API crocksdb_cache_t*
 crocksdb_hyper_clock_cache_options_make_shared_cache(
     crocksdb_hyper_clock_cache_options_t*);
+extern C_ROCKSDB_LIBRARY_API void
+crocksdb_hyper_clock_cache_options_set_secondary_cache(
+    crocksdb_hyper_clock_cache_options_t*, crocksdb_secondary_cache_t*);
+// A secondary cache that keeps blocks compressed with `compression_type`, so
+// that a given amount of memory holds more of them.
+extern C_ROCKSDB_LIBRARY_API crocksdb_secondary_cache_t*
+crocksdb_compressed_secondary_cache_create(size_t capacity, int num_shard_bits,
+                                           int compression_type);
+extern C_ROCKSDB_LIBRARY_API void crocksdb_secondary_cache_destroy(
+    crocksdb_secondary_cache_t*);
+extern C_ROCKSDB_LIBRARY_API void crocksdb_secondary_cache_set_capacity(
+    crocksdb_secondary_cache_t*, size_t capacity, char** errptr);
+extern C_ROCKSDB_LIBRARY_API size_t crocksdb_secondary_cache_get_capacity(
+    crocksdb_secondary_cache_t*, char** errptr);
+// Requests made to the tier since it was created: blocks inserted on
+// eviction from a block cache, blocks inserted by crocksdb_cache_load,
+// inserts it refused, and lookups with how many of them hit. Blocks it
+// evicts by itself are not counted.
+extern C_ROCKSDB_LIBRARY_API void crocksdb_secondary_cache_counters(
+    crocksdb_secondary_cache_t*, uint64_t* inserts, uint64_t* saved_inserts,
+    uint64_t* rejected_inserts, uint64_t* lookups, uint64_t* hits);
 extern C_ROCKSDB_LIBRARY_API void crocksdb_cache_destroy(
     crocksdb_cache_t* cache);
 extern C_ROCKSDB_LIBRARY_API void crocksdb_cache_set_capacity(
     crocksdb_cache_t* cache, size_t capacity);
 
+// Mirrors rocksdb::CacheEntryRole.
+enum {
+  crocksdb_cache_entry_role_data_block = 0,
+  crocksdb_cache_entry_role_filter_block = 1,
+  crocksdb_cache_entry_role_filter_meta_block = 2,
+  crocksdb_cache_entry_role_deprecated_filter_block = 3,
+  crocksdb_cache_entry_role_index_block = 4,
+  crocksdb_cache_entry_role_other_block = 5,
+  crocksdb_cache_entry_role_write_buffer = 6,
+  crocksdb_cache_entry_role_compression_dictionary_building_buffer = 7,
+  crocksdb_cache_entry_role_filter_construction = 8,
+  crocksdb_cache_entry_role_block_based_table_reader = 9,
+  crocksdb_cache_entry_role_file_metadata = 10,
+  crocksdb_cache_entry_role_blob_value = 11,
+  crocksdb_cache_entry_role_blob_cache = 12,
+  crocksdb_cache_entry_role_misc = 13,
+  crocksdb_cache_entry_role_count = 14,
+};
+
+// Charge and number of cache entries, indexed by crocksdb_cache_entry_role_*.
+struct crocksdb_cache_role_usage_t {
+  uint64_t bytes[crocksdb_cache_entry_role_count];
+  uint64_t count[crocksdb_cache_entry_role_count];
+};
+typedef struct crocksdb_cache_role_usage_t crocksdb_cache_role_usage_t;
+
+struct crocksdb_cache_usage_t {
+  // When the walk that produced the snapshot started, and how long it took.
+  uint64_t collected_at_micros;
+  uint64_t collection_micros;
+  uint64_t capacity;
+  uint64_t usage;
+  uint64_t pinned_usage;
+  crocksdb_cache_role_usage_t roles;
+};
+typedef struct crocksdb_cache_usage_t crocksdb_cache_usage_t;
+typedef struct crocksdb_cache_usage_monitor_t crocksdb_cache_usage_monitor_t;
+
+// Walks `cache` on a background thread every `refresh_interval_micros`, or
+// only on demand when it is 0, and keeps the latest breakdown of its usage.
+extern C_ROCKSDB_LIBRARY_API crocksdb_cache_usage_monitor_t*
+crocksdb_cache_usage_monitor_create(crocksdb_cache_t* cache,
+                                    uint64_t refresh_interval_micros);
+extern C_ROCKSDB_LIBRARY_API void crocksdb_cache_usage_monitor_destroy(
+    crocksdb_cache_usage_monitor_t*);
+// Both getters wait for a new walk if the latest one started more than
+// `max_age_micros` ago.
+extern C_ROCKSDB_LIBRARY_API void crocksdb_cache_usage_monitor_get(
+    crocksdb_cache_usage_monitor_t*, uint64_t max_age_micros,
+    crocksdb_cache_usage_t* usage);
+// Fills `usage[i]` with the table blocks of the live files of
+// `column_families[i]`. Blocks of obsolete files, of other DBs sharing the
+// cache, and entries not backed by a table file are not attributed.
+extern C_ROCKSDB_LIBRARY_API void crocksdb_cache_usage_monitor_get_cf(
+    crocksdb_cache_usage_monitor_t*, crocksdb_t* db,
+    crocksdb_column_family_handle_t** column_families, size_t num_cfs,
+    uint64_t max_age_micros, crocksdb_cache_role_usage_t* usage,
+    char** errptr);
+
+typedef struct crocksdb_cache_dump_options_t crocksdb_cache_dump_options_t;
+
+extern C_ROCKSDB_LIBRARY_API crocksdb_cache_dump_options_t*
+crocksdb_cache_dump_options_create();
+extern C_ROCKSDB_LIBRARY_API void crocksdb_cache_dump_options_destroy(
+    crocksdb_cache_dump_options_t*);
+// Stops after the given amount of block bytes. 0, the default, means no
+// limit.
+extern C_ROCKSDB_LIBRARY_API void crocksdb_cache_dump_options_set_budget_bytes(
+    crocksdb_cache_dump_options_t*, uint64_t budget_bytes);
+// Bit mask of `1 << crocksdb_cache_entry_role_*` to dump. All roles by
+// default, though only data, index and filter blocks can be dumped.
+// Ignored when loading.
+extern C_ROCKSDB_LIBRARY_API void crocksdb_cache_dump_options_set_roles(
+    crocksdb_cache_dump_options_t*, uint32_t roles);
+// Throttles loading, charging every loaded block whatever the mode of the
+// limiter. Dumping is not throttled, since it walks the cache under its shard
+// locks.
+extern C_ROCKSDB_LIBRARY_API void crocksdb_cache_dump_options_set_rate_limiter(
+    crocksdb_cache_dump_options_t*, crocksdb_ratelimiter_t*);
+
+// Writes the blocks of the tables of `db` held by `cache` to the file at
+// `path`. When `column_families` of `db` are given, only blocks of their live
+// tables are written. Dump a cache shared by several DBs once per DB.
+extern C_ROCKSDB_LIBRARY_API void crocksdb_cache_dump(
+    crocksdb_cache_t* cache, crocksdb_t* db,
+    crocksdb_column_family_handle_t** column_families, size_t num_cfs,
+    const char* path, const crocksdb_cache_dump_options_t* opts,
+    char** errptr);
+// Reads blocks written by crocksdb_cache_dump into `secondary_cache`, which
+// block caches look up on a miss. Blocks keep their keys across restarts, so
+// a DB can be warmed before or after it is reopened. `column_families` of
+// `db` filter the blocks as when dumping.
+extern C_ROCKSDB_LIBRARY_API void crocksdb_cache_load(
+    crocksdb_secondary_cache_t* secondary_cache,
+    const crocksdb_block_based_table_options_t* options, crocksdb_t* db,
+    crocksdb_column_family_handle_t** column_families, size_t num_cfs,
+    const char* path, const crocksdb_cache_dump_options_t* opts,
+    char** errptr);
+
+typedef struct crocksdb_range_prefetch_t crocksdb_range_prefetch_t;
+
+// Reads [start_key, end_key) of `column_family` on a background thread,
+// filling the block cache with its data and index blocks. An empty
+// `end_key` means no upper bound. The range is read in total order, ignoring
+// the prefix extractor of the column family. Reads use `readahead_size` and
+// are charged to the DB's rate limiter at low priority when its mode covers
+// reads; the default kWritesOnly mode does not. They stop once `budget_bytes`
+// have been read from files, unless it is 0. Filter blocks are not
+// prefetched.
+// The prefetch must be destroyed before the DB is closed.
+extern C_ROCKSDB_LIBRARY_API crocksdb_range_prefetch_t*
+crocksdb_range_prefetch_start(crocksdb_t* db,
+                              crocksdb_column_family_handle_t* column_family,
+                              const char* start_key, size_t start_key_len,
+                              const char* end_key, size_t end_key_len,
+                              size_t readahead_size, uint64_t budget_bytes);
+extern C_ROCKSDB_LIBRARY_API void crocksdb_range_prefetch_progress(
+    crocksdb_range_prefetch_t*, uint64_t* bytes_read, uint64_t* keys,
+    unsigned char* done);
+extern C_ROCKSDB_LIBRARY_API void crocksdb_range_prefetch_cancel(
+    crocksdb_range_prefetch_t*);
+// Waits for the prefetch to finish and returns its error, if any.
+extern C_ROCKSDB_LIBRARY_API void crocksdb_range_prefetch_wait(
+    crocksdb_range_prefetch_t*, char** errptr);
+// Cancels the prefetch and waits for it to stop.
+extern C_ROCKSDB_LIBRARY_API void crocksdb_range_prefetch_destroy(
+    crocksdb_range_prefetch_t*);
+
+/* Background jobs */
+
+enum {
+  crocksdb_background_job_flush = 0,
+  crocksdb_background_job_compaction = 1,
+};
+
+// Same values as rocksdb::ThreadStatus::ThreadType.
+enum {
+  crocksdb_thread_type_high_priority = 0,
+  crocksdb_thread_type_low_priority = 1,
+  crocksdb_thread_type_user = 2,
+  crocksdb_thread_type_bottom_priority = 3,
+};
+
+// Same values as rocksdb::ThreadStatus::OperationStage.
+enum {
+  crocksdb_job_stage_unknown = 0,
+  crocksdb_job_stage_flush_run = 1,
+  crocksdb_job_stage_flush_write_l0 = 2,
+  crocksdb_job_stage_compaction_prepare = 3,
+  crocksdb_job_stage_compaction_run = 4,
+  crocksdb_job_stage_compaction_process_kv = 5,
+  crocksdb_job_stage_compaction_install = 6,
+  crocksdb_job_stage_compaction_sync_file = 7,
+  crocksdb_job_stage_pick_memtables_to_flush = 8,
+  crocksdb_job_stage_memtable_rollback = 9,
+  crocksdb_job_stage_memtable_install_flush_results = 10,
+};
+
+struct crocksdb_background_job_t {
+  uint64_t thread_id;
+  int thread_type;
+  int type;
+  int stage;
+  uint64_t elapsed_micros;
+  uint64_t job_id;
+  // -1 for flushes.
+  int input_level;
+  int output_level;
+  // Total size of the input files of a compaction, or of the memtables
+  // being flushed.
+  uint64_t input_bytes;
+  // Bytes processed so far. Compactions update them every few thousand
+  // keys. Flushes don't report bytes read.
+  uint64_t bytes_read;
+  uint64_t bytes_written;
+};
+typedef struct crocksdb_background_job_t crocksdb_background_job_t;
+typedef struct crocksdb_background_jobs_t crocksdb_background_jobs_t;
+
+// Returns the flushes and compactions of `db` running at the time of the
+// call. They are only tracked if the DB was opened with
+// crocksdb_options_set_enable_thread_tracking.
+extern C_ROCKSDB_LIBRARY_API crocksdb_background_jobs_t*
+crocksdb_get_background_jobs(crocksdb_t* db, char** errptr);
+extern C_ROCKSDB_LIBRARY_API size_t
+crocksdb_background_jobs_count(const crocksdb_background_jobs_t*);
+extern C_ROCKSDB_LIBRARY_API void crocksdb_background_jobs_get(
+    const crocksdb_background_jobs_t*, size_t index,
+    crocksdb_background_job_t* job);
+extern C_ROCKSDB_LIBRARY_API const char* crocksdb_background_jobs_cf_name(
+    const crocksdb_background_jobs_t*, size_t index, size_t* len);
+extern C_ROCKSDB_LIBRARY_API void crocksdb_background_jobs_destroy(
+    crocksdb_background_jobs_t*);
+
 /* Env */
 
 extern C_ROCKSDB_LIBRARY_API crocksdb_env_t* crocksdb_default_env_create();
 extern C_ROCKSDB_LIBRARY_API crocksdb_env_t* crocksdb_mem_env_create();
+// Whether the POSIX file system currently serves MultiRead and ReadAsync with
+// io_uring: RocksDB was built with liburing, the running kernel accepts
+// io_uring_setup, and it has not been disabled.
+extern C_ROCKSDB_LIBRARY_API unsigned char crocksdb_io_uring_supported();
+// Enables or disables io_uring for the whole process. Enabled by default when
+// available. The encrypted and inspected envs forward MultiRead and
+// ReadAsync of their random access files, so they benefit as well.
+extern C_ROCKSDB_LIBRARY_API void crocksdb_set_io_uring_enabled(
+    unsigned char enabled);
 extern C_ROCKSDB_LIBRARY_API crocksdb_env_t* crocksdb_ctr_encrypted_env_create(
     crocksdb_env_t* base_env, const char* ciphertext, size_t ciphertext_len);
 extern C_ROCKSDB_LIBRARY_API void crocksdb_env_set_background_threads(
@@ -1844,6 +2346,19 @@ crocksdb_encryption_key_manager_create(
     crocksdb_encryption_key_manager_link_file_cb link_file);
 extern C_ROCKSDB_LIBRARY_API void crocksdb_encryption_key_manager_destroy(
     crocksdb_encryption_key_manager_t*);
+// Caches the encryption info returned by get_file, for up to `capacity`
+// files, so that reopening a file doesn't call into the host. Entries are
+// dropped when the file is created, deleted or linked over through the key
+// manager. Must be called before the key manager is used.
+extern C_ROCKSDB_LIBRARY_API void crocksdb_encryption_key_manager_enable_cache(
+    crocksdb_encryption_key_manager_t*, size_t capacity);
+// Drops the cached info of a file changed without going through the key
+// manager.
+extern C_ROCKSDB_LIBRARY_API void
+crocksdb_encryption_key_manager_invalidate_cache(
+    crocksdb_encryption_key_manager_t*, const char* fname);
+extern C_ROCKSDB_LIBRARY_API void crocksdb_encryption_key_manager_cache_stats(
+    crocksdb_encryption_key_manager_t*, uint64_t* hits, uint64_t* misses);
 extern C_ROCKSDB_LIBRARY_API const char*
 crocksdb_encryption_key_manager_get_file(
     crocksdb_encryption_key_manager_t* key_manager, const char* fname,
@@ -1894,6 +2409,44 @@ extern C_ROCKSDB_LIBRARY_API crocksdb_env_t*
 crocksdb_file_system_inspected_env_create(crocksdb_env_t*,
                                           crocksdb_file_system_inspector_t*);
 
+/* Token bucket inspector */
+
+enum {
+  crocksdb_io_priority_low = 0,
+  crocksdb_io_priority_normal = 1,
+  crocksdb_io_priority_high = 2,
+};
+
+typedef struct crocksdb_token_bucket_inspector_t
+    crocksdb_token_bucket_inspector_t;
+
+// A file system inspector that throttles reads and writes natively, with a
+// token bucket per IO type (crocksdb_file_io_read or crocksdb_file_io_write)
+// and priority. The priority of an IO is the one set on the calling thread
+// with crocksdb_set_thread_io_priority, normal by default. All buckets are
+// unlimited until a rate is set.
+extern C_ROCKSDB_LIBRARY_API crocksdb_token_bucket_inspector_t*
+crocksdb_token_bucket_inspector_create();
+extern C_ROCKSDB_LIBRARY_API void crocksdb_token_bucket_inspector_destroy(
+    crocksdb_token_bucket_inspector_t*);
+// Takes effect immediately. A rate of 0 or less disables throttling.
+extern C_ROCKSDB_LIBRARY_API void crocksdb_token_bucket_inspector_set_rate(
+    crocksdb_token_bucket_inspector_t*, int op, int priority,
+    int64_t bytes_per_sec);
+extern C_ROCKSDB_LIBRARY_API int64_t crocksdb_token_bucket_inspector_get_rate(
+    const crocksdb_token_bucket_inspector_t*, int op, int priority);
+// Bytes allowed, calls, and time spent waiting for tokens.
+extern C_ROCKSDB_LIBRARY_API void crocksdb_token_bucket_inspector_counters(
+    const crocksdb_token_bucket_inspector_t*, int op, int priority,
+    uint64_t* bytes, uint64_t* requests, uint64_t* wait_micros);
+// Returns an inspector sharing the buckets, to be passed to
+// crocksdb_file_system_inspected_env_create.
+extern C_ROCKSDB_LIBRARY_API crocksdb_file_system_inspector_t*
+crocksdb_file_system_inspector_create_token_bucket(
+    const crocksdb_token_bucket_inspector_t*);
+extern C_ROCKSDB_LIBRARY_API void crocksdb_set_thread_io_priority(
+    int priority);
+
 /* SstFile */
 
 extern C_ROCKSDB_LIBRARY_API crocksdb_sstfilereader_t*
@@ -2026,8 +2579,29 @@ extern C_ROCKSDB_LIBRARY_API crocksdb_slicetransform_t*
 crocksdb_slicetransform_create_fixed_prefix(size_t);
 extern C_ROCKSDB_LIBRARY_API crocksdb_slicetransform_t*
 crocksdb_slicetransform_create_noop();
+extern C_ROCKSDB_LIBRARY_API crocksdb_slicetransform_t*
+crocksdb_slicetransform_create_capped_prefix(size_t cap_len);
+/* A header_len-byte header followed by up to prefix_len bytes. */
+extern C_ROCKSDB_LIBRARY_API crocksdb_slicetransform_t*
+crocksdb_slicetransform_create_prefix_after_header(size_t header_len,
+                                                   size_t prefix_len);
+/* Everything up to and including the count-th delimiter. */
+extern C_ROCKSDB_LIBRARY_API crocksdb_slicetransform_t*
+crocksdb_slicetransform_create_delimited_prefix(char delimiter, size_t count);
+/* A header_len-byte header followed by one memcomparable-encoded segment. */
+extern C_ROCKSDB_LIBRARY_API crocksdb_slicetransform_t*
+crocksdb_slicetransform_create_header_memcomparable_prefix(size_t header_len);
 extern C_ROCKSDB_LIBRARY_API void crocksdb_slicetransform_destroy(
     crocksdb_slicetransform_t*);
+extern C_ROCKSDB_LIBRARY_API const char* crocksdb_slicetransform_name(
+    const crocksdb_slicetransform_t*);
+extern C_ROCKSDB_LIBRARY_API unsigned char crocksdb_slicetransform_in_domain(
+    const crocksdb_slicetransform_t*, const char* key, size_t key_len);
+/* Returns NULL if key is out of domain. Built-in transforms return a pointer
+   into key; see crocksdb_slicetransform_create for others. */
+extern C_ROCKSDB_LIBRARY_API const char* crocksdb_slicetransform_transform(
+    const crocksdb_slicetransform_t*, const char* key, size_t key_len,
+    size_t* prefix_len);
 
 /* Universal Compaction options */
 
@@ -2126,6 +2700,12 @@ extern C_ROCKSDB_LIBRARY_API crocksdb_pinnableslice_t* crocksdb_get_pinned_cf(
     crocksdb_t* db, const crocksdb_readoptions_t* options,
     crocksdb_column_family_handle_t* column_family, const char* key,
     size_t keylen, char** errptr);
+extern C_ROCKSDB_LIBRARY_API crocksdb_pinnableslice_t*
+crocksdb_get_pinned_cf_with_ts(crocksdb_t* db,
+                               const crocksdb_readoptions_t* options,
+                               crocksdb_column_family_handle_t* column_family,
+                               const char* key, size_t keylen, char** ts,
+                               size_t* tslen, char** errptr);
 extern C_ROCKSDB_LIBRARY_API void crocksdb_pinnableslice_destroy(
     crocksdb_pinnableslice_t* v);
 extern C_ROCKSDB_LIBRARY_API const char* crocksdb_pinnableslice_value(
@@ -2247,6 +2827,54 @@ extern C_ROCKSDB_LIBRARY_API void crocksdb_options_set_compact_on_deletion(
     crocksdb_options_t* opt, size_t sliding_window_size,
     size_t deletion_trigger);
 
+/* MVCC Properties Collector */
+
+enum {
+  crocksdb_ts_encoding_big_endian = 0,
+  // Big-endian with all bits flipped, so newer versions sort first.
+  crocksdb_ts_encoding_big_endian_desc = 1,
+  crocksdb_ts_encoding_little_endian = 2,
+};
+
+struct crocksdb_mvcc_properties_t {
+  // Number of distinct user keys.
+  uint64_t num_rows;
+  // Number of point entries, including deletions.
+  uint64_t num_versions;
+  uint64_t num_puts;
+  uint64_t num_deletes;
+  // Largest number of versions of a single user key.
+  uint64_t max_row_versions;
+  uint64_t min_ts;
+  uint64_t max_ts;
+};
+typedef struct crocksdb_mvcc_properties_t crocksdb_mvcc_properties_t;
+
+// Collects crocksdb_mvcc_properties_t natively for keys made of a user key
+// and a `ts_size`-byte timestamp (one of crocksdb_ts_encoding_*). The user
+// key has `user_key_len` bytes, or spans up to the timestamp if it is 0.
+// Bytes after the timestamp are ignored.
+extern C_ROCKSDB_LIBRARY_API crocksdb_table_properties_collector_factory_t*
+crocksdb_table_properties_collector_factory_create_mvcc(size_t user_key_len,
+                                                        size_t ts_size,
+                                                        int ts_encoding);
+
+// Decodes the properties written by the MVCC collector. Returns false if the
+// table has none.
+extern C_ROCKSDB_LIBRARY_API unsigned char
+crocksdb_user_collected_properties_get_mvcc(
+    const crocksdb_user_collected_properties_t* props,
+    crocksdb_mvcc_properties_t* mvcc);
+
+/* Range Properties Collector */
+
+// Collects samples of the cumulative size and number of keys every
+// `sample_bytes` bytes or `sample_keys` keys of each table, for
+// crocksdb_get_range_properties_cf.
+extern C_ROCKSDB_LIBRARY_API crocksdb_table_properties_collector_factory_t*
+crocksdb_table_properties_collector_factory_create_range(uint64_t sample_bytes,
+                                                         uint64_t sample_keys);
+
 /* Get Table Properties */
 extern C_ROCKSDB_LIBRARY_API crocksdb_table_properties_collection_t*
 crocksdb_get_properties_of_all_tables(crocksdb_t* db, char** errptr);
@@ -2263,6 +2891,52 @@ crocksdb_get_properties_of_tables_in_range(
     const char* const* limit_keys, const size_t* limit_keys_lens,
     char** errptr);
 
+// Merges the samples of the range properties collector across the tables
+// overlapping [start_key, limit_key) into the approximate size and number of
+// keys of the range, and a key splitting it in two halves by size. The middle
+// key is malloc'ed and left NULL if there is no sample in the range.
+extern C_ROCKSDB_LIBRARY_API void crocksdb_get_range_properties_cf(
+    crocksdb_t* db, crocksdb_column_family_handle_t* cf, const char* start_key,
+    size_t start_key_len, const char* limit_key, size_t limit_key_len,
+    uint64_t* size, uint64_t* num_keys, char** middle_key,
+    size_t* middle_key_len, char** errptr);
+
+/* Table Properties Cache */
+
+enum {
+  crocksdb_property_encoding_fixed_be = 0,
+  crocksdb_property_encoding_fixed_le = 1,
+  crocksdb_property_encoding_varint = 2,
+  crocksdb_property_encoding_decimal = 3,
+};
+
+// Caches the decoded properties of the live tables of one DB by file number.
+// It is kept up to date by a listener added to the DB options.
+extern C_ROCKSDB_LIBRARY_API crocksdb_table_properties_cache_t*
+crocksdb_table_properties_cache_create();
+extern C_ROCKSDB_LIBRARY_API void crocksdb_table_properties_cache_destroy(
+    crocksdb_table_properties_cache_t*);
+extern C_ROCKSDB_LIBRARY_API size_t
+crocksdb_table_properties_cache_len(crocksdb_table_properties_cache_t*);
+extern C_ROCKSDB_LIBRARY_API void crocksdb_options_add_table_properties_cache(
+    crocksdb_options_t* opt, crocksdb_table_properties_cache_t* cache);
+
+// Sums up the numeric user properties `names` (each one decoded as one of
+// crocksdb_property_encoding_*) over the tables overlapping
+// [start_key, limit_key) into `sums`. Tables missing from the cache are
+// loaded into it. Values that fail to decode are skipped.
+extern C_ROCKSDB_LIBRARY_API void crocksdb_table_properties_cache_aggregate(
+    crocksdb_table_properties_cache_t* cache, crocksdb_t* db,
+    crocksdb_column_family_handle_t* cf, const char* start_key,
+    size_t start_key_len, const char* limit_key, size_t limit_key_len,
+    const char* const* names, const size_t* name_lens, const int* encodings,
+    size_t num_names, uint64_t* sums, char** errptr);
+
+// Fills `sizes[i]` with the total filter size of the live files at level i.
+extern C_ROCKSDB_LIBRARY_API void crocksdb_get_filter_size_per_level_cf(
+    crocksdb_t* db, crocksdb_column_family_handle_t* cf, uint64_t* sizes,
+    size_t num_levels, char** errptr);
+
 /* Get All Key Versions */
 
 extern C_ROCKSDB_LIBRARY_API void crocksdb_keyversions_destroy(
@@ -2294,6 +2968,26 @@ crocksdb_set_external_sst_file_global_seq_no(
     crocksdb_t* db, crocksdb_column_family_handle_t* column_family,
     const char* file, uint64_t seq_no, char** errptr);
 
+// Finds up to `num_keys` keys splitting [start_key, limit_key) into parts of
+// even size. Only the index blocks of the overlapping live files are read.
+// Data still in the memtables can't be placed and is reported separately.
+extern C_ROCKSDB_LIBRARY_API crocksdb_split_keys_t* crocksdb_get_split_keys_cf(
+    crocksdb_t* db, crocksdb_column_family_handle_t* cf, const char* start_key,
+    size_t start_key_len, const char* limit_key, size_t limit_key_len,
+    size_t num_keys, char** errptr);
+extern C_ROCKSDB_LIBRARY_API void crocksdb_split_keys_destroy(
+    crocksdb_split_keys_t*);
+extern C_ROCKSDB_LIBRARY_API size_t
+crocksdb_split_keys_count(const crocksdb_split_keys_t*);
+extern C_ROCKSDB_LIBRARY_API const char* crocksdb_split_keys_key(
+    const crocksdb_split_keys_t*, size_t index, size_t* klen);
+// Approximate size of the range in SST files.
+extern C_ROCKSDB_LIBRARY_API uint64_t
+crocksdb_split_keys_sst_size(const crocksdb_split_keys_t*);
+// Approximate size of the range in the memtables.
+extern C_ROCKSDB_LIBRARY_API uint64_t
+crocksdb_split_keys_memtable_size(const crocksdb_split_keys_t*);
+
 /* ColumnFamilyMetaData */
 extern C_ROCKSDB_LIBRARY_API void crocksdb_get_column_family_meta_data(
     crocksdb_t* db, crocksdb_column_family_handle_t* cf,
@@ -2356,6 +3050,151 @@ extern C_ROCKSDB_LIBRARY_API crocksdb_perf_context_t* crocksdb_get_perf_context(
     void);
 extern C_ROCKSDB_LIBRARY_API void crocksdb_perf_context_reset(
     crocksdb_perf_context_t*);
+
+enum {
+  crocksdb_perf_context_snapshot_version = 1,
+  crocksdb_perf_context_snapshot_max_levels = 8,
+};
+
+// Per-level counters, only kept while per-level perf context is enabled.
+struct crocksdb_perf_context_level_t {
+  uint64_t bloom_filter_useful;
+  uint64_t bloom_filter_full_positive;
+  uint64_t bloom_filter_full_true_positive;
+  uint64_t user_key_return_count;
+  uint64_t get_from_table_nanos;
+  uint64_t block_cache_hit_count;
+  uint64_t block_cache_miss_count;
+};
+typedef struct crocksdb_perf_context_level_t crocksdb_perf_context_level_t;
+
+// A copy of every counter of a PerfContext. All fields after the header are
+// uint64_t counters, named after the PerfContext fields.
+struct crocksdb_perf_context_snapshot_t {
+  uint32_t version;
+  // Number of valid entries in `levels`. Levels beyond the last one are not
+  // copied.
+  uint32_t num_levels;
+  uint64_t user_key_comparison_count;
+  uint64_t block_cache_hit_count;
+  uint64_t block_read_count;
+  uint64_t block_read_byte;
+  uint64_t block_read_time;
+  uint64_t block_read_cpu_time;
+  uint64_t block_cache_index_hit_count;
+  uint64_t block_cache_standalone_handle_count;
+  uint64_t block_cache_real_handle_count;
+  uint64_t index_block_read_count;
+  uint64_t block_cache_filter_hit_count;
+  uint64_t filter_block_read_count;
+  uint64_t compression_dict_block_read_count;
+  uint64_t secondary_cache_hit_count;
+  uint64_t compressed_sec_cache_insert_real_count;
+  uint64_t compressed_sec_cache_insert_dummy_count;
+  uint64_t compressed_sec_cache_uncompressed_bytes;
+  uint64_t compressed_sec_cache_compressed_bytes;
+  uint64_t block_checksum_time;
+  uint64_t block_decompress_time;
+  uint64_t get_read_bytes;
+  uint64_t multiget_read_bytes;
+  uint64_t iter_read_bytes;
+  uint64_t blob_cache_hit_count;
+  uint64_t blob_read_count;
+  uint64_t blob_read_byte;
+  uint64_t blob_read_time;
+  uint64_t blob_checksum_time;
+  uint64_t blob_decompress_time;
+  uint64_t internal_key_skipped_count;
+  uint64_t internal_delete_skipped_count;
+  uint64_t internal_recent_skipped_count;
+  uint64_t internal_merge_count;
+  uint64_t internal_merge_point_lookup_count;
+  uint64_t internal_range_del_reseek_count;
+  uint64_t get_snapshot_time;
+  uint64_t get_from_memtable_time;
+  uint64_t get_from_memtable_count;
+  uint64_t get_post_process_time;
+  uint64_t get_from_output_files_time;
+  uint64_t seek_on_memtable_time;
+  uint64_t seek_on_memtable_count;
+  uint64_t next_on_memtable_count;
+  uint64_t prev_on_memtable_count;
+  uint64_t seek_child_seek_time;
+  uint64_t seek_child_seek_count;
+  uint64_t seek_min_heap_time;
+  uint64_t seek_max_heap_time;
+  uint64_t seek_internal_seek_time;
+  uint64_t find_next_user_entry_time;
+  uint64_t write_wal_time;
+  uint64_t write_memtable_time;
+  uint64_t write_delay_time;
+  uint64_t write_scheduling_flushes_compactions_time;
+  uint64_t write_pre_and_post_process_time;
+  uint64_t write_thread_wait_nanos;
+  uint64_t db_mutex_lock_nanos;
+  uint64_t db_condition_wait_nanos;
+  uint64_t merge_operator_time_nanos;
+  uint64_t read_index_block_nanos;
+  uint64_t read_filter_block_nanos;
+  uint64_t new_table_block_iter_nanos;
+  uint64_t new_table_iterator_nanos;
+  uint64_t block_seek_nanos;
+  uint64_t find_table_nanos;
+  uint64_t bloom_memtable_hit_count;
+  uint64_t bloom_memtable_miss_count;
+  uint64_t bloom_sst_hit_count;
+  uint64_t bloom_sst_miss_count;
+  uint64_t key_lock_wait_time;
+  uint64_t key_lock_wait_count;
+  uint64_t env_new_sequential_file_nanos;
+  uint64_t env_new_random_access_file_nanos;
+  uint64_t env_new_writable_file_nanos;
+  uint64_t env_reuse_writable_file_nanos;
+  uint64_t env_new_random_rw_file_nanos;
+  uint64_t env_new_directory_nanos;
+  uint64_t env_file_exists_nanos;
+  uint64_t env_get_children_nanos;
+  uint64_t env_get_children_file_attributes_nanos;
+  uint64_t env_delete_file_nanos;
+  uint64_t env_create_dir_nanos;
+  uint64_t env_create_dir_if_missing_nanos;
+  uint64_t env_delete_dir_nanos;
+  uint64_t env_get_file_size_nanos;
+  uint64_t env_get_file_modification_time_nanos;
+  uint64_t env_rename_file_nanos;
+  uint64_t env_link_file_nanos;
+  uint64_t env_lock_file_nanos;
+  uint64_t env_unlock_file_nanos;
+  uint64_t env_new_logger_nanos;
+  uint64_t get_cpu_nanos;
+  uint64_t iter_next_cpu_nanos;
+  uint64_t iter_prev_cpu_nanos;
+  uint64_t iter_seek_cpu_nanos;
+  uint64_t iter_next_count;
+  uint64_t iter_prev_count;
+  uint64_t iter_seek_count;
+  uint64_t encrypt_data_nanos;
+  uint64_t decrypt_data_nanos;
+  uint64_t number_async_seek;
+  crocksdb_perf_context_level_t
+      levels[crocksdb_perf_context_snapshot_max_levels];
+};
+typedef struct crocksdb_perf_context_snapshot_t
+    crocksdb_perf_context_snapshot_t;
+
+// Copies all counters of `ctx` into `snapshot` in one call. The caller sets
+// `snapshot->version` to crocksdb_perf_context_snapshot_version; returns
+// false, leaving `snapshot` untouched, if the library does not support it.
+extern C_ROCKSDB_LIBRARY_API unsigned char crocksdb_perf_context_snapshot(
+    crocksdb_perf_context_t* ctx, crocksdb_perf_context_snapshot_t* snapshot);
+// Sets `diff` to the counters accumulated between `before` and `after`.
+extern C_ROCKSDB_LIBRARY_API void crocksdb_perf_context_snapshot_diff(
+    const crocksdb_perf_context_snapshot_t* before,
+    const crocksdb_perf_context_snapshot_t* after,
+    crocksdb_perf_context_snapshot_t* diff);
+// Enables or disables the per-level counters of `ctx`.
+extern C_ROCKSDB_LIBRARY_API void crocksdb_perf_context_set_per_level_enabled(
+    crocksdb_perf_context_t* ctx, unsigned char enabled);
 extern C_ROCKSDB_LIBRARY_API uint64_t
 crocksdb_perf_context_user_key_comparison_count(crocksdb_perf_context_t*);
 extern C_ROCKSDB_LIBRARY_API uint64_t
@@ -2543,6 +3382,146 @@ crocksdb_iostats_context_prepare_write_nanos(crocksdb_iostats_context_t*);
 extern C_ROCKSDB_LIBRARY_API uint64_t
 crocksdb_iostats_context_logger_nanos(crocksdb_iostats_context_t*);
 
+struct crocksdb_iostats_snapshot_t {
+  uint64_t bytes_written;
+  uint64_t bytes_read;
+  uint64_t open_nanos;
+  uint64_t allocate_nanos;
+  uint64_t write_nanos;
+  uint64_t read_nanos;
+  uint64_t range_sync_nanos;
+  uint64_t fsync_nanos;
+  uint64_t prepare_write_nanos;
+  uint64_t logger_nanos;
+  uint64_t cpu_write_nanos;
+  uint64_t cpu_read_nanos;
+};
+typedef struct crocksdb_iostats_snapshot_t crocksdb_iostats_snapshot_t;
+
+// Copies all counters of `ctx` into `snapshot` in one call.
+extern C_ROCKSDB_LIBRARY_API void crocksdb_iostats_context_snapshot(
+    crocksdb_iostats_context_t* ctx, crocksdb_iostats_snapshot_t* snapshot);
+
+/* Operation latency tracing */
+
+enum {
+  crocksdb_traced_op_get = 0,
+  crocksdb_traced_op_multi_get = 1,
+  crocksdb_traced_op_write = 2,
+  // Includes seeks to the first and last keys.
+  crocksdb_traced_op_iter_seek = 3,
+  // Includes steps backwards.
+  crocksdb_traced_op_iter_next = 4,
+  crocksdb_traced_op_ingest = 5,
+  crocksdb_traced_op_count = 6,
+};
+
+enum {
+  // Every power of two is split into 2^3 linear sub-buckets, so a bucket
+  // spans at most 12.5% of its lower bound.
+  crocksdb_op_latency_sub_bucket_bits = 3,
+  crocksdb_op_latency_buckets = 320,
+};
+
+struct crocksdb_op_latency_t {
+  uint64_t count;
+  uint64_t total_nanos;
+  uint64_t max_nanos;
+  // PerfContext counters accumulated by the sampled operations.
+  uint64_t block_cache_hit_count;
+  uint64_t block_read_count;
+  uint64_t block_read_byte;
+  uint64_t internal_key_skipped_count;
+  uint64_t internal_delete_skipped_count;
+  // Bucket i counts latencies of at least
+  // crocksdb_op_latency_bucket_lower_nanos(i) nanoseconds. The last bucket
+  // also holds everything slower.
+  uint64_t buckets[crocksdb_op_latency_buckets];
+};
+typedef struct crocksdb_op_latency_t crocksdb_op_latency_t;
+
+// Samples one in every `every` calls to crocksdb_get*, crocksdb_multi_get*,
+// crocksdb_write*, the iterator seek and step functions and
+// crocksdb_ingest_external_file* on each thread, recording their latency
+// and PerfContext deltas into per-thread histograms. The perf level is
+// raised to count level for the duration of a sampled call. Zero, the
+// default, disables sampling.
+extern C_ROCKSDB_LIBRARY_API void crocksdb_op_tracing_set_sample_every(
+    uint32_t every);
+extern C_ROCKSDB_LIBRARY_API uint32_t crocksdb_op_tracing_sample_every();
+// Merges the histograms of all threads for `op`, one of crocksdb_traced_op_*.
+extern C_ROCKSDB_LIBRARY_API void crocksdb_op_tracing_get(
+    int op, crocksdb_op_latency_t* latency);
+extern C_ROCKSDB_LIBRARY_API void crocksdb_op_tracing_reset();
+extern C_ROCKSDB_LIBRARY_API void crocksdb_op_latency_merge(
+    crocksdb_op_latency_t* dst, const crocksdb_op_latency_t* src);
+extern C_ROCKSDB_LIBRARY_API uint64_t
+crocksdb_op_latency_bucket_lower_nanos(size_t bucket);
+// Upper bound of the latency of the `p`th percentile (0.0 to 100.0)
+// operation, capped at the maximum recorded latency.
+extern C_ROCKSDB_LIBRARY_API uint64_t crocksdb_op_latency_percentile_nanos(
+    const crocksdb_op_latency_t* latency, double p);
+
+/* Tracing */
+
+// Same values as rocksdb::TraceFilterType.
+enum {
+  crocksdb_trace_filter_get = 1,
+  crocksdb_trace_filter_write = 2,
+  crocksdb_trace_filter_iter_seek = 4,
+  crocksdb_trace_filter_iter_seek_for_prev = 8,
+  crocksdb_trace_filter_multi_get = 16,
+};
+
+typedef struct crocksdb_trace_options_t crocksdb_trace_options_t;
+
+extern C_ROCKSDB_LIBRARY_API crocksdb_trace_options_t*
+crocksdb_trace_options_create();
+extern C_ROCKSDB_LIBRARY_API void crocksdb_trace_options_destroy(
+    crocksdb_trace_options_t*);
+// Tracing stops once the trace file reaches `size`, 64GB by default.
+extern C_ROCKSDB_LIBRARY_API void
+crocksdb_trace_options_set_max_trace_file_size(crocksdb_trace_options_t*,
+                                               uint64_t size);
+// Traces one in every `frequency` requests, 1 by default.
+extern C_ROCKSDB_LIBRARY_API void
+crocksdb_trace_options_set_sampling_frequency(crocksdb_trace_options_t*,
+                                              uint64_t frequency);
+// `filter` is a mask of crocksdb_trace_filter_* of queries to leave out of
+// query traces.
+extern C_ROCKSDB_LIBRARY_API void crocksdb_trace_options_set_filter(
+    crocksdb_trace_options_t*, uint64_t filter);
+
+// Writes the queries, block cache accesses or file IOs of `db` to the file
+// at `path` until the matching crocksdb_end_* call. Only one trace of each
+// kind can run at a time.
+extern C_ROCKSDB_LIBRARY_API void crocksdb_start_trace(
+    crocksdb_t* db, const char* path, const crocksdb_trace_options_t* opts,
+    char** errptr);
+extern C_ROCKSDB_LIBRARY_API void crocksdb_end_trace(crocksdb_t* db,
+                                                     char** errptr);
+extern C_ROCKSDB_LIBRARY_API void crocksdb_start_block_cache_trace(
+    crocksdb_t* db, const char* path, const crocksdb_trace_options_t* opts,
+    char** errptr);
+extern C_ROCKSDB_LIBRARY_API void crocksdb_end_block_cache_trace(
+    crocksdb_t* db, char** errptr);
+extern C_ROCKSDB_LIBRARY_API void crocksdb_start_io_trace(
+    crocksdb_t* db, const char* path, const crocksdb_trace_options_t* opts,
+    char** errptr);
+extern C_ROCKSDB_LIBRARY_API void crocksdb_end_io_trace(crocksdb_t* db,
+                                                        char** errptr);
+
+// Re-runs the query trace at `path` against `db` on `num_threads` threads,
+// `speedup` times faster than it was recorded. `column_families` must cover
+// every column family in the trace. `latencies` must hold
+// crocksdb_traced_op_count histograms, indexed by crocksdb_traced_op_*;
+// iterator seeks forwards and backwards are both counted as seeks. `errors`
+// receives the number of queries that failed.
+extern C_ROCKSDB_LIBRARY_API void crocksdb_replay_trace(
+    crocksdb_t* db, crocksdb_column_family_handle_t** column_families,
+    size_t num_cfs, const char* path, uint32_t num_threads, double speedup,
+    crocksdb_op_latency_t* latencies, uint64_t* errors, char** errptr);
+
 /* SstPartitioner */
 
 extern C_ROCKSDB_LIBRARY_API crocksdb_sst_partitioner_request_t*
@@ -2664,6 +3643,25 @@ crocksdb_sst_partitioner_factory_create_partitioner(
     crocksdb_sst_partitioner_factory_t* factory,
     crocksdb_sst_partitioner_context_t* context);
 
+// A set of region boundaries, compared bytewise, that can be replaced while
+// DBs use it. Compactions already running keep the set they started with.
+extern C_ROCKSDB_LIBRARY_API crocksdb_sst_partitioner_boundaries_t*
+crocksdb_sst_partitioner_boundaries_create();
+extern C_ROCKSDB_LIBRARY_API void crocksdb_sst_partitioner_boundaries_destroy(
+    crocksdb_sst_partitioner_boundaries_t* boundaries);
+// Replaces the boundaries. Keys need not be sorted or unique.
+extern C_ROCKSDB_LIBRARY_API void crocksdb_sst_partitioner_boundaries_set(
+    crocksdb_sst_partitioner_boundaries_t* boundaries, const char* const* keys,
+    const size_t* key_lens, size_t num_keys);
+extern C_ROCKSDB_LIBRARY_API size_t crocksdb_sst_partitioner_boundaries_len(
+    const crocksdb_sst_partitioner_boundaries_t* boundaries);
+// Partitions compaction outputs where keys cross a boundary, once the output
+// file has at least `min_output_file_size` bytes.
+extern C_ROCKSDB_LIBRARY_API crocksdb_sst_partitioner_factory_t*
+crocksdb_sst_partitioner_factory_create_boundary(
+    const crocksdb_sst_partitioner_boundaries_t* boundaries,
+    uint64_t min_output_file_size);
+
 extern C_ROCKSDB_LIBRARY_API void crocksdb_run_ldb_tool(
     int argc, char** argv, const crocksdb_options_t* opts);
 extern C_ROCKSDB_LIBRARY_API void crocksdb_run_sst_dump_tool(
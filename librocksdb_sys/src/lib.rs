@@ -68,8 +68,22 @@ pub struct DBHyperClockCacheOptions(c_void);
 #[repr(C)]
 pub struct DBCache(c_void);
 #[repr(C)]
+pub struct DBSecondaryCache(c_void);
+#[repr(C)]
+pub struct DBCacheUsageMonitor(c_void);
+#[repr(C)]
+pub struct DBCacheDumpOptions(c_void);
+#[repr(C)]
+pub struct DBRangePrefetch(c_void);
+#[repr(C)]
+pub struct DBBackgroundJobs(c_void);
+#[repr(C)]
+pub struct DBTraceOptions(c_void);
+#[repr(C)]
 pub struct DBFilterPolicy(c_void);
 #[repr(C)]
+pub struct DBFilterStats(c_void);
+#[repr(C)]
 pub struct DBSnapshot(c_void);
 #[repr(C)]
 pub struct DBIterator(c_void);
@@ -148,8 +162,18 @@ pub struct DBIngestionInfo(c_void);
 #[repr(C)]
 pub struct DBEventListener(c_void);
 #[repr(C)]
+pub struct DBEventRing(c_void);
+#[repr(C)]
+pub struct DBFileIoStats(c_void);
+#[repr(C)]
+pub struct DBTokenBucketInspector(c_void);
+#[repr(C)]
 pub struct DBKeyVersions(c_void);
 #[repr(C)]
+pub struct DBSplitKeys(c_void);
+#[repr(C)]
+pub struct DBTablePropertiesCache(c_void);
+#[repr(C)]
 pub struct DBEnv(c_void);
 #[repr(C)]
 pub struct DBSequentialFile(c_void);
@@ -192,6 +216,8 @@ pub struct DBSstPartitionerContext(c_void);
 #[repr(C)]
 pub struct DBSstPartitionerFactory(c_void);
 #[repr(C)]
+pub struct DBSstPartitionerBoundaries(c_void);
+#[repr(C)]
 pub struct DBWriteBatchIterator(c_void);
 #[repr(C)]
 pub struct DBFileSystemInspectorInstance(c_void);
@@ -247,6 +273,576 @@ pub enum DBEntryType {
     Other = 7,
 }
 
+#[derive(Copy, Clone, Debug, Eq, PartialEq)]
+#[repr(C)]
+pub enum DBTimestampEncoding {
+    BigEndian = 0,
+    /// Big-endian with all bits flipped, so newer versions sort first.
+    BigEndianDesc = 1,
+    LittleEndian = 2,
+}
+
+#[derive(Clone, Copy, Debug, Default, PartialEq)]
+#[repr(C)]
+pub struct DBMvccProperties {
+    pub num_rows: u64,
+    pub num_versions: u64,
+    pub num_puts: u64,
+    pub num_deletes: u64,
+    pub max_row_versions: u64,
+    pub min_ts: u64,
+    pub max_ts: u64,
+}
+
+#[derive(Copy, Clone, Debug, Eq, PartialEq)]
+#[repr(C)]
+pub enum DBEventType {
+    FlushCompleted = 0,
+    CompactionCompleted = 1,
+    ExternalFileIngested = 2,
+    StallConditionsChanged = 3,
+    BackgroundError = 4,
+}
+
+impl DBEventType {
+    pub fn from_i32(v: i32) -> Option<DBEventType> {
+        match v {
+            0 => Some(DBEventType::FlushCompleted),
+            1 => Some(DBEventType::CompactionCompleted),
+            2 => Some(DBEventType::ExternalFileIngested),
+            3 => Some(DBEventType::StallConditionsChanged),
+            4 => Some(DBEventType::BackgroundError),
+            _ => None,
+        }
+    }
+}
+
+/// Fixed-size summary of a background event, see `crocksdb_event_record_t`.
+#[derive(Clone, Copy)]
+#[repr(C)]
+pub struct DBEventRecord {
+    pub job_id: u64,
+    pub file_number: u64,
+    pub input_bytes: u64,
+    pub output_bytes: u64,
+    pub num_input_files: u64,
+    pub num_output_files: u64,
+    /// Duration of the flush or compaction.
+    pub elapsed_micros: u64,
+    /// A `DBEventType`, see `event_type()`.
+    pub event_type: i32,
+    pub reason: i32,
+    pub prev_reason: i32,
+    pub status_code: i32,
+    pub input_level: i32,
+    pub output_level: i32,
+    pub cf_name_len: u32,
+    pub path_len: u32,
+    pub cf_name: [u8; 64],
+    pub path: [u8; 192],
+}
+
+impl DBEventRecord {
+    /// `None` if the record comes from a newer library with more event types.
+    pub fn event_type(&self) -> Option<DBEventType> {
+        DBEventType::from_i32(self.event_type)
+    }
+
+    pub fn cf_name(&self) -> &[u8] {
+        &self.cf_name[..self.cf_name_len as usize]
+    }
+
+    /// The output file of the event. Long paths are truncated at the front.
+    pub fn path(&self) -> &[u8] {
+        &self.path[..self.path_len as usize]
+    }
+}
+
+#[derive(Copy, Clone, Debug, Eq, PartialEq)]
+#[repr(C)]
+pub enum DBFileIoOp {
+    Read = 0,
+    Write = 1,
+    /// Includes range syncs.
+    Sync = 2,
+}
+
+#[derive(Copy, Clone, Debug, Eq, PartialEq)]
+#[repr(C)]
+pub enum DBIoPriority {
+    Low = 0,
+    Normal = 1,
+    High = 2,
+}
+
+#[derive(Copy, Clone, Debug, Eq, PartialEq)]
+#[repr(C)]
+pub enum DBIoFileType {
+    Table = 0,
+    Wal = 1,
+    Manifest = 2,
+    Blob = 3,
+    Other = 4,
+}
+
+/// Latency histogram of file operations, see `crocksdb_io_histogram_t`.
+#[derive(Clone, Copy, Debug, Default, PartialEq)]
+#[repr(C)]
+pub struct DBIoHistogram {
+    pub count: u64,
+    pub bytes: u64,
+    pub errors: u64,
+    pub total_nanos: u64,
+    pub max_nanos: u64,
+    /// `buckets[0]` counts operations faster than 1us, `buckets[i]` those
+    /// taking [2^(i-1), 2^i) us.
+    pub buckets: [u64; 32],
+}
+
+impl DBIoHistogram {
+    /// Upper bound, in microseconds, of the latency of the `p`th percentile
+    /// (0.0 to 100.0) operation.
+    pub fn percentile_micros(&self, p: f64) -> u64 {
+        let target = (self.count as f64 * p / 100.0).ceil() as u64;
+        let mut seen = 0;
+        for (i, n) in self.buckets.iter().enumerate() {
+            seen += n;
+            if seen >= target.max(1) {
+                return 1 << i;
+            }
+        }
+        1 << (self.buckets.len() - 1)
+    }
+}
+
+#[derive(Copy, Clone, Debug, Eq, PartialEq)]
+#[repr(C)]
+pub enum DBCacheEntryRole {
+    DataBlock = 0,
+    FilterBlock = 1,
+    FilterMetaBlock = 2,
+    DeprecatedFilterBlock = 3,
+    IndexBlock = 4,
+    OtherBlock = 5,
+    WriteBuffer = 6,
+    CompressionDictionaryBuildingBuffer = 7,
+    FilterConstruction = 8,
+    BlockBasedTableReader = 9,
+    FileMetadata = 10,
+    BlobValue = 11,
+    BlobCache = 12,
+    Misc = 13,
+}
+
+pub const CACHE_ENTRY_ROLE_COUNT: usize = 14;
+
+/// Charge and number of cache entries by role, see
+/// `crocksdb_cache_role_usage_t`.
+#[derive(Clone, Copy, Debug, Default, PartialEq)]
+#[repr(C)]
+pub struct DBCacheRoleUsage {
+    pub bytes: [u64; CACHE_ENTRY_ROLE_COUNT],
+    pub count: [u64; CACHE_ENTRY_ROLE_COUNT],
+}
+
+impl DBCacheRoleUsage {
+    pub fn bytes(&self, role: DBCacheEntryRole) -> u64 {
+        self.bytes[role as usize]
+    }
+
+    pub fn count(&self, role: DBCacheEntryRole) -> u64 {
+        self.count[role as usize]
+    }
+}
+
+#[derive(Clone, Copy, Debug, Default, PartialEq)]
+#[repr(C)]
+pub struct DBCacheUsage {
+    /// When the walk that produced the snapshot started, and how long it
+    /// took.
+    pub collected_at_micros: u64,
+    pub collection_micros: u64,
+    pub capacity: u64,
+    pub usage: u64,
+    pub pinned_usage: u64,
+    pub roles: DBCacheRoleUsage,
+}
+
+/// Per-level counters of a PerfContext, see `crocksdb_perf_context_level_t`.
+#[derive(Clone, Copy, Debug, Default, PartialEq)]
+#[repr(C)]
+pub struct DBPerfContextLevel {
+    pub bloom_filter_useful: u64,
+    pub bloom_filter_full_positive: u64,
+    pub bloom_filter_full_true_positive: u64,
+    pub user_key_return_count: u64,
+    pub get_from_table_nanos: u64,
+    pub block_cache_hit_count: u64,
+    pub block_cache_miss_count: u64,
+}
+
+pub const PERF_CONTEXT_SNAPSHOT_VERSION: u32 = 1;
+pub const PERF_CONTEXT_SNAPSHOT_MAX_LEVELS: usize = 8;
+
+/// A copy of every counter of a PerfContext, see
+/// `crocksdb_perf_context_snapshot_t`.
+#[derive(Clone, Copy, Debug, PartialEq)]
+#[repr(C)]
+pub struct DBPerfContextSnapshot {
+    pub version: u32,
+    /// Number of valid entries in `levels`.
+    pub num_levels: u32,
+    pub user_key_comparison_count: u64,
+    pub block_cache_hit_count: u64,
+    pub block_read_count: u64,
+    pub block_read_byte: u64,
+    pub block_read_time: u64,
+    pub block_read_cpu_time: u64,
+    pub block_cache_index_hit_count: u64,
+    pub block_cache_standalone_handle_count: u64,
+    pub block_cache_real_handle_count: u64,
+    pub index_block_read_count: u64,
+    pub block_cache_filter_hit_count: u64,
+    pub filter_block_read_count: u64,
+    pub compression_dict_block_read_count: u64,
+    pub secondary_cache_hit_count: u64,
+    pub compressed_sec_cache_insert_real_count: u64,
+    pub compressed_sec_cache_insert_dummy_count: u64,
+    pub compressed_sec_cache_uncompressed_bytes: u64,
+    pub compressed_sec_cache_compressed_bytes: u64,
+    pub block_checksum_time: u64,
+    pub block_decompress_time: u64,
+    pub get_read_bytes: u64,
+    pub multiget_read_bytes: u64,
+    pub iter_read_bytes: u64,
+    pub blob_cache_hit_count: u64,
+    pub blob_read_count: u64,
+    pub blob_read_byte: u64,
+    pub blob_read_time: u64,
+    pub blob_checksum_time: u64,
+    pub blob_decompress_time: u64,
+    pub internal_key_skipped_count: u64,
+    pub internal_delete_skipped_count: u64,
+    pub internal_recent_skipped_count: u64,
+    pub internal_merge_count: u64,
+    pub internal_merge_point_lookup_count: u64,
+    pub internal_range_del_reseek_count: u64,
+    pub get_snapshot_time: u64,
+    pub get_from_memtable_time: u64,
+    pub get_from_memtable_count: u64,
+    pub get_post_process_time: u64,
+    pub get_from_output_files_time: u64,
+    pub seek_on_memtable_time: u64,
+    pub seek_on_memtable_count: u64,
+    pub next_on_memtable_count: u64,
+    pub prev_on_memtable_count: u64,
+    pub seek_child_seek_time: u64,
+    pub seek_child_seek_count: u64,
+    pub seek_min_heap_time: u64,
+    pub seek_max_heap_time: u64,
+    pub seek_internal_seek_time: u64,
+    pub find_next_user_entry_time: u64,
+    pub write_wal_time: u64,
+    pub write_memtable_time: u64,
+    pub write_delay_time: u64,
+    pub write_scheduling_flushes_compactions_time: u64,
+    pub write_pre_and_post_process_time: u64,
+    pub write_thread_wait_nanos: u64,
+    pub db_mutex_lock_nanos: u64,
+    pub db_condition_wait_nanos: u64,
+    pub merge_operator_time_nanos: u64,
+    pub read_index_block_nanos: u64,
+    pub read_filter_block_nanos: u64,
+    pub new_table_block_iter_nanos: u64,
+    pub new_table_iterator_nanos: u64,
+    pub block_seek_nanos: u64,
+    pub find_table_nanos: u64,
+    pub bloom_memtable_hit_count: u64,
+    pub bloom_memtable_miss_count: u64,
+    pub bloom_sst_hit_count: u64,
+    pub bloom_sst_miss_count: u64,
+    pub key_lock_wait_time: u64,
+    pub key_lock_wait_count: u64,
+    pub env_new_sequential_file_nanos: u64,
+    pub env_new_random_access_file_nanos: u64,
+    pub env_new_writable_file_nanos: u64,
+    pub env_reuse_writable_file_nanos: u64,
+    pub env_new_random_rw_file_nanos: u64,
+    pub env_new_directory_nanos: u64,
+    pub env_file_exists_nanos: u64,
+    pub env_get_children_nanos: u64,
+    pub env_get_children_file_attributes_nanos: u64,
+    pub env_delete_file_nanos: u64,
+    pub env_create_dir_nanos: u64,
+    pub env_create_dir_if_missing_nanos: u64,
+    pub env_delete_dir_nanos: u64,
+    pub env_get_file_size_nanos: u64,
+    pub env_get_file_modification_time_nanos: u64,
+    pub env_rename_file_nanos: u64,
+    pub env_link_file_nanos: u64,
+    pub env_lock_file_nanos: u64,
+    pub env_unlock_file_nanos: u64,
+    pub env_new_logger_nanos: u64,
+    pub get_cpu_nanos: u64,
+    pub iter_next_cpu_nanos: u64,
+    pub iter_prev_cpu_nanos: u64,
+    pub iter_seek_cpu_nanos: u64,
+    pub iter_next_count: u64,
+    pub iter_prev_count: u64,
+    pub iter_seek_count: u64,
+    pub encrypt_data_nanos: u64,
+    pub decrypt_data_nanos: u64,
+    pub number_async_seek: u64,
+    pub levels: [DBPerfContextLevel; PERF_CONTEXT_SNAPSHOT_MAX_LEVELS],
+}
+
+impl Default for DBPerfContextSnapshot {
+    fn default() -> Self {
+        // All fields are integers, for which zero is a valid value.
+        let mut snapshot: Self = unsafe { std::mem::zeroed() };
+        snapshot.version = PERF_CONTEXT_SNAPSHOT_VERSION;
+        snapshot
+    }
+}
+
+impl DBPerfContextSnapshot {
+    /// Counters accumulated between `before` and `self`.
+    pub fn diff(&self, before: &DBPerfContextSnapshot) -> DBPerfContextSnapshot {
+        let mut diff = DBPerfContextSnapshot::default();
+        unsafe {
+            crocksdb_perf_context_snapshot_diff(before, self, &mut diff);
+        }
+        diff
+    }
+}
+
+/// Summary of a statistics histogram, see `crocksdb_histogram_summary_t`.
+#[derive(Clone, Copy, Debug, Default, PartialEq)]
+#[repr(C)]
+pub struct DBHistogramSummary {
+    pub count: u64,
+    pub sum: u64,
+    pub min: f64,
+    pub max: f64,
+    pub average: f64,
+    pub standard_deviation: f64,
+    pub p50: f64,
+    pub p95: f64,
+    pub p99: f64,
+    pub p999: f64,
+}
+
+/// All counters of an IOStatsContext, see `crocksdb_iostats_snapshot_t`.
+#[derive(Clone, Copy, Debug, Default, PartialEq)]
+#[repr(C)]
+pub struct DBIOStatsSnapshot {
+    pub bytes_written: u64,
+    pub bytes_read: u64,
+    pub open_nanos: u64,
+    pub allocate_nanos: u64,
+    pub write_nanos: u64,
+    pub read_nanos: u64,
+    pub range_sync_nanos: u64,
+    pub fsync_nanos: u64,
+    pub prepare_write_nanos: u64,
+    pub logger_nanos: u64,
+    pub cpu_write_nanos: u64,
+    pub cpu_read_nanos: u64,
+}
+
+#[derive(Copy, Clone, Debug, Eq, PartialEq)]
+#[repr(C)]
+pub enum DBBackgroundJobType {
+    Flush = 0,
+    Compaction = 1,
+}
+
+impl DBBackgroundJobType {
+    pub fn from_i32(v: i32) -> Option<DBBackgroundJobType> {
+        match v {
+            0 => Some(DBBackgroundJobType::Flush),
+            1 => Some(DBBackgroundJobType::Compaction),
+            _ => None,
+        }
+    }
+}
+
+#[derive(Copy, Clone, Debug, Eq, PartialEq)]
+#[repr(C)]
+pub enum DBThreadType {
+    HighPriority = 0,
+    LowPriority = 1,
+    User = 2,
+    BottomPriority = 3,
+}
+
+impl DBThreadType {
+    pub fn from_i32(v: i32) -> Option<DBThreadType> {
+        match v {
+            0 => Some(DBThreadType::HighPriority),
+            1 => Some(DBThreadType::LowPriority),
+            2 => Some(DBThreadType::User),
+            3 => Some(DBThreadType::BottomPriority),
+            _ => None,
+        }
+    }
+}
+
+#[derive(Copy, Clone, Debug, Eq, PartialEq)]
+#[repr(C)]
+pub enum DBBackgroundJobStage {
+    Unknown = 0,
+    FlushRun = 1,
+    FlushWriteL0 = 2,
+    CompactionPrepare = 3,
+    CompactionRun = 4,
+    CompactionProcessKV = 5,
+    CompactionInstall = 6,
+    CompactionSyncFile = 7,
+    PickMemtablesToFlush = 8,
+    MemtableRollback = 9,
+    MemtableInstallFlushResults = 10,
+}
+
+impl DBBackgroundJobStage {
+    pub fn from_i32(v: i32) -> Option<DBBackgroundJobStage> {
+        match v {
+            0 => Some(DBBackgroundJobStage::Unknown),
+            1 => Some(DBBackgroundJobStage::FlushRun),
+            2 => Some(DBBackgroundJobStage::FlushWriteL0),
+            3 => Some(DBBackgroundJobStage::CompactionPrepare),
+            4 => Some(DBBackgroundJobStage::CompactionRun),
+            5 => Some(DBBackgroundJobStage::CompactionProcessKV),
+            6 => Some(DBBackgroundJobStage::CompactionInstall),
+            7 => Some(DBBackgroundJobStage::CompactionSyncFile),
+            8 => Some(DBBackgroundJobStage::PickMemtablesToFlush),
+            9 => Some(DBBackgroundJobStage::MemtableRollback),
+            10 => Some(DBBackgroundJobStage::MemtableInstallFlushResults),
+            _ => None,
+        }
+    }
+}
+
+/// Progress of a running flush or compaction, see
+/// `crocksdb_background_job_t`. The enum fields are kept as integers since
+/// RocksDB may report values this crate does not know; use the accessors.
+#[derive(Clone, Copy, Debug, PartialEq)]
+#[repr(C)]
+pub struct DBBackgroundJob {
+    pub thread_id: u64,
+    pub thread_type: c_int,
+    pub job_type: c_int,
+    pub stage: c_int,
+    pub elapsed_micros: u64,
+    pub job_id: u64,
+    /// -1 for flushes.
+    pub input_level: c_int,
+    pub output_level: c_int,
+    pub input_bytes: u64,
+    pub bytes_read: u64,
+    pub bytes_written: u64,
+}
+
+impl DBBackgroundJob {
+    pub fn thread_type(&self) -> Option<DBThreadType> {
+        DBThreadType::from_i32(self.thread_type)
+    }
+
+    pub fn job_type(&self) -> Option<DBBackgroundJobType> {
+        DBBackgroundJobType::from_i32(self.job_type)
+    }
+
+    /// `None` for stages added by newer RocksDB versions.
+    pub fn stage(&self) -> Option<DBBackgroundJobStage> {
+        DBBackgroundJobStage::from_i32(self.stage)
+    }
+}
+
+#[derive(Copy, Clone, Debug, Eq, PartialEq)]
+#[repr(C)]
+pub enum DBTracedOp {
+    Get = 0,
+    MultiGet = 1,
+    Write = 2,
+    /// Includes seeks to the first and last keys.
+    IterSeek = 3,
+    /// Includes steps backwards.
+    IterNext = 4,
+    Ingest = 5,
+}
+
+pub const TRACED_OP_COUNT: usize = 6;
+
+pub const OP_LATENCY_BUCKETS: usize = 320;
+
+/// Queries that can be left out of a query trace.
+#[derive(Copy, Clone, Debug, Eq, PartialEq)]
+#[repr(C)]
+pub enum DBTraceFilter {
+    Get = 1,
+    Write = 2,
+    IterSeek = 4,
+    IterSeekForPrev = 8,
+    MultiGet = 16,
+}
+
+/// Latency histogram of sampled operations, see `crocksdb_op_latency_t`.
+#[derive(Clone, Copy, Debug, PartialEq)]
+#[repr(C)]
+pub struct DBOpLatency {
+    pub count: u64,
+    pub total_nanos: u64,
+    pub max_nanos: u64,
+    pub block_cache_hit_count: u64,
+    pub block_read_count: u64,
+    pub block_read_byte: u64,
+    pub internal_key_skipped_count: u64,
+    pub internal_delete_skipped_count: u64,
+    pub buckets: [u64; OP_LATENCY_BUCKETS],
+}
+
+impl Default for DBOpLatency {
+    fn default() -> Self {
+        // All fields are integers, for which zero is a valid value.
+        unsafe { std::mem::zeroed() }
+    }
+}
+
+impl DBOpLatency {
+    /// Adds the operations recorded in `other`.
+    pub fn merge(&mut self, other: &DBOpLatency) {
+        unsafe { crocksdb_op_latency_merge(self, other) }
+    }
+
+    /// Upper bound, in nanoseconds, of the latency of the `p`th percentile
+    /// (0.0 to 100.0) operation.
+    pub fn percentile_nanos(&self, p: f64) -> u64 {
+        unsafe { crocksdb_op_latency_percentile_nanos(self, p) }
+    }
+
+    /// Smallest latency, in nanoseconds, counted by `buckets[bucket]`.
+    pub fn bucket_lower_nanos(bucket: usize) -> u64 {
+        unsafe { crocksdb_op_latency_bucket_lower_nanos(bucket) }
+    }
+}
+
+#[derive(Copy, Clone, Debug, Eq, PartialEq)]
+#[repr(C)]
+pub enum DBPropertyEncoding {
+    FixedBigEndian = 0,
+    FixedLittleEndian = 1,
+    Varint = 2,
+    Decimal = 3,
+}
+
+#[derive(Copy, Clone, Debug, Eq, PartialEq)]
+#[repr(C)]
+pub enum DBLevelFilterType {
+    None = 0,
+    Bloom = 1,
+    Ribbon = 2,
+}
+
 #[derive(Copy, Clone, Debug, Eq, PartialEq)]
 #[repr(u32)]
 pub enum DBCompressionType {
@@ -659,6 +1255,10 @@ extern "C" {
         opt: *mut DBLRUCacheOptions,
         allocator: *mut DBMemoryAllocator,
     );
+    pub fn crocksdb_lru_cache_options_set_secondary_cache(
+        opt: *mut DBLRUCacheOptions,
+        secondary_cache: *mut DBSecondaryCache,
+    );
     pub fn crocksdb_cache_create_lru(opt: *mut DBLRUCacheOptions) -> *mut DBCache;
     pub fn crocksdb_hyper_clock_cache_options_create(
         capacity: size_t,
@@ -667,7 +1267,157 @@ extern "C" {
     pub fn crocksdb_hyper_clock_cache_options_make_shared_cache(
         opts: *mut DBHyperClockCacheOptions,
     ) -> *mut DBCache;
+    pub fn crocksdb_hyper_clock_cache_options_set_secondary_cache(
+        opts: *mut DBHyperClockCacheOptions,
+        secondary_cache: *mut DBSecondaryCache,
+    );
+    pub fn crocksdb_compressed_secondary_cache_create(
+        capacity: size_t,
+        num_shard_bits: c_int,
+        compression_type: DBCompressionType,
+    ) -> *mut DBSecondaryCache;
+    pub fn crocksdb_secondary_cache_destroy(cache: *mut DBSecondaryCache);
+    pub fn crocksdb_secondary_cache_set_capacity(
+        cache: *mut DBSecondaryCache,
+        capacity: size_t,
+        errptr: *mut *mut c_char,
+    );
+    pub fn crocksdb_secondary_cache_get_capacity(
+        cache: *mut DBSecondaryCache,
+        errptr: *mut *mut c_char,
+    ) -> size_t;
+    pub fn crocksdb_secondary_cache_counters(
+        cache: *mut DBSecondaryCache,
+        inserts: *mut u64,
+        saved_inserts: *mut u64,
+        rejected_inserts: *mut u64,
+        lookups: *mut u64,
+        hits: *mut u64,
+    );
     pub fn crocksdb_cache_destroy(cache: *mut DBCache);
+    pub fn crocksdb_cache_usage_monitor_create(
+        cache: *mut DBCache,
+        refresh_interval_micros: u64,
+    ) -> *mut DBCacheUsageMonitor;
+    pub fn crocksdb_cache_usage_monitor_destroy(monitor: *mut DBCacheUsageMonitor);
+    pub fn crocksdb_cache_usage_monitor_get(
+        monitor: *mut DBCacheUsageMonitor,
+        max_age_micros: u64,
+        usage: *mut DBCacheUsage,
+    );
+    pub fn crocksdb_cache_usage_monitor_get_cf(
+        monitor: *mut DBCacheUsageMonitor,
+        db: *mut DBInstance,
+        column_families: *const *mut DBCFHandle,
+        num_cfs: size_t,
+        max_age_micros: u64,
+        usage: *mut DBCacheRoleUsage,
+        errptr: *mut *mut c_char,
+    );
+    pub fn crocksdb_cache_dump_options_create() -> *mut DBCacheDumpOptions;
+    pub fn crocksdb_cache_dump_options_destroy(opts: *mut DBCacheDumpOptions);
+    pub fn crocksdb_cache_dump_options_set_budget_bytes(
+        opts: *mut DBCacheDumpOptions,
+        budget_bytes: u64,
+    );
+    pub fn crocksdb_cache_dump_options_set_roles(opts: *mut DBCacheDumpOptions, roles: u32);
+    pub fn crocksdb_cache_dump_options_set_rate_limiter(
+        opts: *mut DBCacheDumpOptions,
+        limiter: *mut DBRateLimiter,
+    );
+    pub fn crocksdb_cache_dump(
+        cache: *mut DBCache,
+        db: *mut DBInstance,
+        column_families: *const *mut DBCFHandle,
+        num_cfs: size_t,
+        path: *const c_char,
+        opts: *const DBCacheDumpOptions,
+        errptr: *mut *mut c_char,
+    );
+    pub fn crocksdb_cache_load(
+        secondary_cache: *mut DBSecondaryCache,
+        options: *const DBBlockBasedTableOptions,
+        db: *mut DBInstance,
+        column_families: *const *mut DBCFHandle,
+        num_cfs: size_t,
+        path: *const c_char,
+        opts: *const DBCacheDumpOptions,
+        errptr: *mut *mut c_char,
+    );
+    pub fn crocksdb_range_prefetch_start(
+        db: *mut DBInstance,
+        column_family: *mut DBCFHandle,
+        start_key: *const u8,
+        start_key_len: size_t,
+        end_key: *const u8,
+        end_key_len: size_t,
+        readahead_size: size_t,
+        budget_bytes: u64,
+    ) -> *mut DBRangePrefetch;
+    pub fn crocksdb_range_prefetch_progress(
+        prefetch: *mut DBRangePrefetch,
+        bytes_read: *mut u64,
+        keys: *mut u64,
+        done: *mut u8,
+    );
+    pub fn crocksdb_range_prefetch_cancel(prefetch: *mut DBRangePrefetch);
+    pub fn crocksdb_range_prefetch_wait(prefetch: *mut DBRangePrefetch, errptr: *mut *mut c_char);
+    pub fn crocksdb_range_prefetch_destroy(prefetch: *mut DBRangePrefetch);
+
+    pub fn crocksdb_get_background_jobs(
+        db: *mut DBInstance,
+        err: *mut *mut c_char,
+    ) -> *mut DBBackgroundJobs;
+    pub fn crocksdb_background_jobs_count(jobs: *const DBBackgroundJobs) -> size_t;
+    pub fn crocksdb_background_jobs_get(
+        jobs: *const DBBackgroundJobs,
+        index: size_t,
+        job: *mut DBBackgroundJob,
+    );
+    pub fn crocksdb_background_jobs_cf_name(
+        jobs: *const DBBackgroundJobs,
+        index: size_t,
+        len: *mut size_t,
+    ) -> *const c_char;
+    pub fn crocksdb_background_jobs_destroy(jobs: *mut DBBackgroundJobs);
+
+    pub fn crocksdb_trace_options_create() -> *mut DBTraceOptions;
+    pub fn crocksdb_trace_options_destroy(opts: *mut DBTraceOptions);
+    pub fn crocksdb_trace_options_set_max_trace_file_size(opts: *mut DBTraceOptions, size: u64);
+    pub fn crocksdb_trace_options_set_sampling_frequency(opts: *mut DBTraceOptions, frequency: u64);
+    pub fn crocksdb_trace_options_set_filter(opts: *mut DBTraceOptions, filter: u64);
+    pub fn crocksdb_start_trace(
+        db: *mut DBInstance,
+        path: *const c_char,
+        opts: *const DBTraceOptions,
+        err: *mut *mut c_char,
+    );
+    pub fn crocksdb_end_trace(db: *mut DBInstance, err: *mut *mut c_char);
+    pub fn crocksdb_start_block_cache_trace(
+        db: *mut DBInstance,
+        path: *const c_char,
+        opts: *const DBTraceOptions,
+        err: *mut *mut c_char,
+    );
+    pub fn crocksdb_end_block_cache_trace(db: *mut DBInstance, err: *mut *mut c_char);
+    pub fn crocksdb_start_io_trace(
+        db: *mut DBInstance,
+        path: *const c_char,
+        opts: *const DBTraceOptions,
+        err: *mut *mut c_char,
+    );
+    pub fn crocksdb_end_io_trace(db: *mut DBInstance, err: *mut *mut c_char);
+    pub fn crocksdb_replay_trace(
+        db: *mut DBInstance,
+        column_families: *const *mut DBCFHandle,
+        num_cfs: size_t,
+        path: *const c_char,
+        num_threads: u32,
+        speedup: f64,
+        latencies: *mut DBOpLatency,
+        errors: *mut u64,
+        err: *mut *mut c_char,
+    );
 
     pub fn crocksdb_block_based_options_create() -> *mut DBBlockBasedTableOptions;
     pub fn crocksdb_block_based_options_destroy(opts: *mut DBBlockBasedTableOptions);
@@ -787,6 +1537,7 @@ extern "C" {
     pub fn crocksdb_options_set_use_fsync(options: *mut Options, v: c_int);
     pub fn crocksdb_options_set_bytes_per_sync(options: *mut Options, bytes: u64);
     pub fn crocksdb_options_set_enable_pipelined_write(options: *mut Options, v: bool);
+    pub fn crocksdb_options_set_enable_thread_tracking(options: *mut Options, v: bool);
     pub fn crocksdb_options_set_enable_multi_batch_write(options: *mut Options, v: bool);
     pub fn crocksdb_options_is_enable_multi_batch_write(options: *mut Options) -> bool;
     pub fn crocksdb_options_set_unordered_write(options: *mut Options, v: bool);
@@ -933,6 +1684,16 @@ extern "C" {
         standard_deviation: *mut c_double,
         max: *mut c_double,
     ) -> bool;
+    pub fn crocksdb_statistics_num_tickers(statistics: *mut DBStatistics) -> u32;
+    pub fn crocksdb_statistics_num_histograms(statistics: *mut DBStatistics) -> u32;
+    pub fn crocksdb_statistics_export(
+        statistics: *mut DBStatistics,
+        tickers: *mut u64,
+        num_tickers: size_t,
+        histograms: *mut DBHistogramSummary,
+        num_histograms: size_t,
+        reset: bool,
+    );
 
     pub fn crocksdb_options_set_stats_dump_period_sec(options: *mut Options, v: usize);
     pub fn crocksdb_options_set_stats_persist_period_sec(options: *mut Options, v: u32);
@@ -1106,6 +1867,27 @@ extern "C" {
         bits_per_key: c_double,
         bloom_before_level: c_int,
     ) -> *mut DBFilterPolicy;
+    pub fn crocksdb_filterpolicy_create_level_aware(
+        types: *const DBLevelFilterType,
+        bits_per_key: *const c_double,
+        num_levels: size_t,
+        skip_bottommost: bool,
+        stats: *mut DBFilterStats,
+    ) -> *mut DBFilterPolicy;
+    pub fn crocksdb_filter_stats_create() -> *mut DBFilterStats;
+    pub fn crocksdb_filter_stats_destroy(stats: *mut DBFilterStats);
+    pub fn crocksdb_filter_stats_probes(
+        stats: *const DBFilterStats,
+        filter_type: DBLevelFilterType,
+    ) -> u64;
+    pub fn crocksdb_filter_stats_useful(
+        stats: *const DBFilterStats,
+        filter_type: DBLevelFilterType,
+    ) -> u64;
+    pub fn crocksdb_filter_stats_resident_bytes(
+        stats: *const DBFilterStats,
+        filter_type: DBLevelFilterType,
+    ) -> u64;
     pub fn crocksdb_open(
         options: *mut Options,
         path: *const c_char,
@@ -1171,6 +1953,8 @@ extern "C" {
     pub fn crocksdb_readoptions_set_fill_cache(readopts: *mut DBReadOptions, v: bool);
     pub fn crocksdb_readoptions_set_auto_prefix_mode(readopts: *mut DBReadOptions, v: bool);
     pub fn crocksdb_readoptions_set_adaptive_readahead(readopts: *mut DBReadOptions, v: bool);
+    pub fn crocksdb_readoptions_set_async_io(readopts: *mut DBReadOptions, v: bool);
+    pub fn crocksdb_readoptions_set_optimize_multiget_for_io(readopts: *mut DBReadOptions, v: bool);
     pub fn crocksdb_readoptions_set_snapshot(
         readopts: *mut DBReadOptions,
         snapshot: *const DBSnapshot,
@@ -1185,6 +1969,16 @@ extern "C" {
         k: *const u8,
         kLen: size_t,
     );
+    pub fn crocksdb_readoptions_set_timestamp(
+        readopts: *mut DBReadOptions,
+        ts: *const u8,
+        tsLen: size_t,
+    );
+    pub fn crocksdb_readoptions_set_iter_start_ts(
+        readopts: *mut DBReadOptions,
+        ts: *const u8,
+        tsLen: size_t,
+    );
     pub fn crocksdb_readoptions_set_read_tier(readopts: *mut DBReadOptions, tier: c_int);
     pub fn crocksdb_readoptions_set_tailing(readopts: *mut DBReadOptions, v: bool);
     pub fn crocksdb_readoptions_set_managed(readopts: *mut DBReadOptions, v: bool);
@@ -1225,6 +2019,18 @@ extern "C" {
         valLen: *const size_t,
         err: *mut *mut c_char,
     ) -> *mut u8;
+    pub fn crocksdb_multi_get_cf(
+        db: *const DBInstance,
+        readopts: *const DBReadOptions,
+        cf_handles: *const *const DBCFHandle,
+        num_keys: size_t,
+        keys_list: *const *const u8,
+        keys_list_sizes: *const size_t,
+        values_list: *mut *mut u8,
+        values_list_sizes: *mut size_t,
+        errs: *mut *mut c_char,
+    );
+    pub fn crocksdb_free(ptr: *mut c_void);
     pub fn crocksdb_create_iterator(
         db: *mut DBInstance,
         readopts: *const DBReadOptions,
@@ -1278,6 +2084,63 @@ extern "C" {
         end_keylen: size_t,
         err: *mut *mut c_char,
     );
+    pub fn crocksdb_put_cf_with_ts(
+        db: *mut DBInstance,
+        writeopts: *const DBWriteOptions,
+        cf: *mut DBCFHandle,
+        k: *const u8,
+        kLen: size_t,
+        ts: *const u8,
+        tsLen: size_t,
+        v: *const u8,
+        vLen: size_t,
+        err: *mut *mut c_char,
+    );
+    pub fn crocksdb_delete_cf_with_ts(
+        db: *mut DBInstance,
+        writeopts: *const DBWriteOptions,
+        cf: *mut DBCFHandle,
+        k: *const u8,
+        kLen: size_t,
+        ts: *const u8,
+        tsLen: size_t,
+        err: *mut *mut c_char,
+    );
+    pub fn crocksdb_single_delete_cf_with_ts(
+        db: *mut DBInstance,
+        writeopts: *const DBWriteOptions,
+        cf: *mut DBCFHandle,
+        k: *const u8,
+        kLen: size_t,
+        ts: *const u8,
+        tsLen: size_t,
+        err: *mut *mut c_char,
+    );
+    pub fn crocksdb_delete_range_cf_with_ts(
+        db: *mut DBInstance,
+        writeopts: *const DBWriteOptions,
+        cf: *mut DBCFHandle,
+        begin_key: *const u8,
+        begin_keylen: size_t,
+        end_key: *const u8,
+        end_keylen: size_t,
+        ts: *const u8,
+        tsLen: size_t,
+        err: *mut *mut c_char,
+    );
+    pub fn crocksdb_increase_full_history_ts_low(
+        db: *mut DBInstance,
+        cf: *mut DBCFHandle,
+        ts_low: *const u8,
+        ts_low_len: size_t,
+        err: *mut *mut c_char,
+    );
+    pub fn crocksdb_get_full_history_ts_low(
+        db: *mut DBInstance,
+        cf: *mut DBCFHandle,
+        ts_low_len: *mut size_t,
+        err: *mut *mut c_char,
+    ) -> *mut u8;
     pub fn crocksdb_close(db: *mut DBInstance);
     pub fn crocksdb_pause_bg_work(db: *mut DBInstance);
     pub fn crocksdb_continue_bg_work(db: *mut DBInstance);
@@ -1349,6 +2212,7 @@ extern "C" {
     pub fn crocksdb_iter_key(iter: *const DBIterator, klen: *mut size_t) -> *mut u8;
     pub fn crocksdb_iter_value(iter: *const DBIterator, vlen: *mut size_t) -> *mut u8;
     pub fn crocksdb_iter_get_error(iter: *const DBIterator, err: *mut *mut c_char);
+    pub fn crocksdb_iter_timestamp(iter: *const DBIterator, tslen: *mut size_t) -> *const u8;
     // Write batch
     pub fn crocksdb_write(
         db: *mut DBInstance,
@@ -1422,6 +2286,35 @@ extern "C" {
         key: *const u8,
         klen: size_t,
     );
+    pub fn crocksdb_writebatch_put_cf_with_ts(
+        batch: *mut DBWriteBatch,
+        cf: *mut DBCFHandle,
+        key: *const u8,
+        klen: size_t,
+        ts: *const u8,
+        tslen: size_t,
+        val: *const u8,
+        vlen: size_t,
+        err: *mut *mut c_char,
+    );
+    pub fn crocksdb_writebatch_delete_cf_with_ts(
+        batch: *mut DBWriteBatch,
+        cf: *mut DBCFHandle,
+        key: *const u8,
+        klen: size_t,
+        ts: *const u8,
+        tslen: size_t,
+        err: *mut *mut c_char,
+    );
+    pub fn crocksdb_writebatch_single_delete_cf_with_ts(
+        batch: *mut DBWriteBatch,
+        cf: *mut DBCFHandle,
+        key: *const u8,
+        klen: size_t,
+        ts: *const u8,
+        tslen: size_t,
+        err: *mut *mut c_char,
+    );
     pub fn crocksdb_writebatch_single_delete(
         batch: *mut DBWriteBatch,
         key: *const u8,
@@ -1524,6 +2417,7 @@ extern "C" {
     pub fn crocksdb_writebatch_iterator_column_family_id(it: *mut DBWriteBatchIterator) -> u32;
     // Comparator
     pub fn crocksdb_options_set_comparator(options: *mut Options, cb: *mut DBComparator);
+    pub fn crocksdb_options_set_persist_user_defined_timestamps(options: *mut Options, v: bool);
     pub fn crocksdb_comparator_create(
         state: *mut c_void,
         destroy: unsafe extern "C" fn(*mut c_void) -> (),
@@ -1537,6 +2431,25 @@ extern "C" {
         name_fn: unsafe extern "C" fn(*mut c_void) -> *const c_char,
     ) -> *mut DBComparator;
     pub fn crocksdb_comparator_destroy(cmp: *mut DBComparator);
+    pub fn crocksdb_comparator_create_builtin(
+        name: *const c_char,
+        err: *mut *mut c_char,
+    ) -> *mut DBComparator;
+    pub fn crocksdb_comparator_timestamp_size(cmp: *const DBComparator) -> size_t;
+    pub fn crocksdb_comparator_find_shortest_separator(
+        cmp: *const DBComparator,
+        start: *const u8,
+        start_len: size_t,
+        limit: *const u8,
+        limit_len: size_t,
+        result_len: *mut size_t,
+    ) -> *mut u8;
+    pub fn crocksdb_comparator_find_short_successor(
+        cmp: *const DBComparator,
+        key: *const u8,
+        key_len: size_t,
+        result_len: *mut size_t,
+    ) -> *mut u8;
 
     // Column Family
     pub fn crocksdb_open_column_families(
@@ -1996,6 +2909,22 @@ extern "C" {
         key_manager: *mut DBEncryptionKeyManagerInstance,
     );
     #[cfg(feature = "encryption")]
+    pub fn crocksdb_encryption_key_manager_enable_cache(
+        key_manager: *mut DBEncryptionKeyManagerInstance,
+        capacity: size_t,
+    );
+    #[cfg(feature = "encryption")]
+    pub fn crocksdb_encryption_key_manager_invalidate_cache(
+        key_manager: *mut DBEncryptionKeyManagerInstance,
+        fname: *const c_char,
+    );
+    #[cfg(feature = "encryption")]
+    pub fn crocksdb_encryption_key_manager_cache_stats(
+        key_manager: *mut DBEncryptionKeyManagerInstance,
+        hits: *mut u64,
+        misses: *mut u64,
+    );
+    #[cfg(feature = "encryption")]
     pub fn crocksdb_encryption_key_manager_get_file(
         key_manager: *mut DBEncryptionKeyManagerInstance,
         fname: *const c_char,
@@ -2055,6 +2984,32 @@ extern "C" {
         inspector: *mut DBFileSystemInspectorInstance,
     ) -> *mut DBEnv;
 
+    pub fn crocksdb_token_bucket_inspector_create() -> *mut DBTokenBucketInspector;
+    pub fn crocksdb_token_bucket_inspector_destroy(inspector: *mut DBTokenBucketInspector);
+    pub fn crocksdb_token_bucket_inspector_set_rate(
+        inspector: *mut DBTokenBucketInspector,
+        op: DBFileIoOp,
+        priority: DBIoPriority,
+        bytes_per_sec: i64,
+    );
+    pub fn crocksdb_token_bucket_inspector_get_rate(
+        inspector: *const DBTokenBucketInspector,
+        op: DBFileIoOp,
+        priority: DBIoPriority,
+    ) -> i64;
+    pub fn crocksdb_token_bucket_inspector_counters(
+        inspector: *const DBTokenBucketInspector,
+        op: DBFileIoOp,
+        priority: DBIoPriority,
+        bytes: *mut u64,
+        requests: *mut u64,
+        wait_micros: *mut u64,
+    );
+    pub fn crocksdb_file_system_inspector_create_token_bucket(
+        inspector: *const DBTokenBucketInspector,
+    ) -> *mut DBFileSystemInspectorInstance;
+    pub fn crocksdb_set_thread_io_priority(priority: DBIoPriority);
+
     // SstFileReader
     pub fn crocksdb_sstfilereader_create(io_options: *const Options) -> *mut SstFileReader;
 
@@ -2213,6 +3168,31 @@ extern "C" {
         name: extern "C" fn(*mut c_void) -> *const c_char,
     ) -> *mut DBSliceTransform;
     pub fn crocksdb_slicetransform_destroy(transform: *mut DBSliceTransform);
+    pub fn crocksdb_slicetransform_create_fixed_prefix(len: size_t) -> *mut DBSliceTransform;
+    pub fn crocksdb_slicetransform_create_capped_prefix(cap_len: size_t) -> *mut DBSliceTransform;
+    pub fn crocksdb_slicetransform_create_prefix_after_header(
+        header_len: size_t,
+        prefix_len: size_t,
+    ) -> *mut DBSliceTransform;
+    pub fn crocksdb_slicetransform_create_delimited_prefix(
+        delimiter: c_char,
+        count: size_t,
+    ) -> *mut DBSliceTransform;
+    pub fn crocksdb_slicetransform_create_header_memcomparable_prefix(
+        header_len: size_t,
+    ) -> *mut DBSliceTransform;
+    pub fn crocksdb_slicetransform_name(transform: *const DBSliceTransform) -> *const c_char;
+    pub fn crocksdb_slicetransform_in_domain(
+        transform: *const DBSliceTransform,
+        key: *const u8,
+        key_len: size_t,
+    ) -> c_uchar;
+    pub fn crocksdb_slicetransform_transform(
+        transform: *const DBSliceTransform,
+        key: *const u8,
+        key_len: size_t,
+        prefix_len: *mut size_t,
+    ) -> *const u8;
     pub fn crocksdb_logger_create(
         state: *mut c_void,
         destructor: extern "C" fn(*mut c_void),
@@ -2241,6 +3221,16 @@ extern "C" {
         kLen: size_t,
         err: *mut *mut c_char,
     ) -> *mut DBPinnableSlice;
+    pub fn crocksdb_get_pinned_cf_with_ts(
+        db: *mut DBInstance,
+        readopts: *const DBReadOptions,
+        cf_handle: *mut DBCFHandle,
+        k: *const u8,
+        kLen: size_t,
+        ts: *mut *mut u8,
+        tsLen: *mut size_t,
+        err: *mut *mut c_char,
+    ) -> *mut DBPinnableSlice;
     pub fn crocksdb_pinnableslice_value(
         s: *const DBPinnableSlice,
         valLen: *mut size_t,
@@ -2248,6 +3238,8 @@ extern "C" {
     pub fn crocksdb_pinnableslice_destroy(v: *mut DBPinnableSlice);
     pub fn crocksdb_get_supported_compression_number() -> size_t;
     pub fn crocksdb_get_supported_compression(v: *mut DBCompressionType, l: size_t);
+    pub fn crocksdb_io_uring_supported() -> c_uchar;
+    pub fn crocksdb_set_io_uring_enabled(enabled: c_uchar);
 
     pub fn crocksdb_user_collected_properties_add(
         props: *mut DBUserCollectedProperties,
@@ -2383,6 +3375,22 @@ extern "C" {
         deletion_trigger: size_t,
     );
 
+    pub fn crocksdb_table_properties_collector_factory_create_mvcc(
+        user_key_len: size_t,
+        ts_size: size_t,
+        ts_encoding: DBTimestampEncoding,
+    ) -> *mut DBTablePropertiesCollectorFactory;
+
+    pub fn crocksdb_table_properties_collector_factory_create_range(
+        sample_bytes: u64,
+        sample_keys: u64,
+    ) -> *mut DBTablePropertiesCollectorFactory;
+
+    pub fn crocksdb_user_collected_properties_get_mvcc(
+        props: *const DBUserCollectedProperties,
+        mvcc: *mut DBMvccProperties,
+    ) -> c_uchar;
+
     pub fn crocksdb_get_properties_of_all_tables(
         db: *mut DBInstance,
         errptr: *mut *mut c_char,
@@ -2404,6 +3412,48 @@ extern "C" {
         limit_keys_lens: *const size_t,
         errptr: *mut *mut c_char,
     ) -> *mut DBTablePropertiesCollection;
+    pub fn crocksdb_get_range_properties_cf(
+        db: *mut DBInstance,
+        cf: *mut DBCFHandle,
+        start_key: *const u8,
+        start_key_len: size_t,
+        limit_key: *const u8,
+        limit_key_len: size_t,
+        size: *mut u64,
+        num_keys: *mut u64,
+        middle_key: *mut *mut c_char,
+        middle_key_len: *mut size_t,
+        errptr: *mut *mut c_char,
+    );
+    pub fn crocksdb_table_properties_cache_create() -> *mut DBTablePropertiesCache;
+    pub fn crocksdb_table_properties_cache_destroy(cache: *mut DBTablePropertiesCache);
+    pub fn crocksdb_table_properties_cache_len(cache: *mut DBTablePropertiesCache) -> size_t;
+    pub fn crocksdb_options_add_table_properties_cache(
+        options: *mut Options,
+        cache: *mut DBTablePropertiesCache,
+    );
+    pub fn crocksdb_table_properties_cache_aggregate(
+        cache: *mut DBTablePropertiesCache,
+        db: *mut DBInstance,
+        cf: *mut DBCFHandle,
+        start_key: *const u8,
+        start_key_len: size_t,
+        limit_key: *const u8,
+        limit_key_len: size_t,
+        names: *const *const u8,
+        name_lens: *const size_t,
+        encodings: *const DBPropertyEncoding,
+        num_names: size_t,
+        sums: *mut u64,
+        errptr: *mut *mut c_char,
+    );
+    pub fn crocksdb_get_filter_size_per_level_cf(
+        db: *mut DBInstance,
+        cf: *mut DBCFHandle,
+        sizes: *mut u64,
+        num_levels: size_t,
+        errptr: *mut *mut c_char,
+    );
 
     pub fn crocksdb_flushjobinfo_cf_name(
         info: *const DBFlushJobInfo,
@@ -2530,6 +3580,39 @@ extern "C" {
     pub fn crocksdb_eventlistener_destroy(et: *mut DBEventListener);
     pub fn crocksdb_options_add_eventlistener(opt: *mut Options, et: *mut DBEventListener);
 
+    pub fn crocksdb_event_ring_create(capacity: size_t) -> *mut DBEventRing;
+    pub fn crocksdb_event_ring_destroy(ring: *mut DBEventRing);
+    pub fn crocksdb_options_add_event_ring(opt: *mut Options, ring: *mut DBEventRing);
+    pub fn crocksdb_event_ring_drain(
+        ring: *mut DBEventRing,
+        records: *mut DBEventRecord,
+        max_records: size_t,
+    ) -> size_t;
+    pub fn crocksdb_event_ring_dropped(ring: *const DBEventRing) -> u64;
+
+    pub fn crocksdb_file_io_stats_create() -> *mut DBFileIoStats;
+    pub fn crocksdb_file_io_stats_destroy(stats: *mut DBFileIoStats);
+    pub fn crocksdb_options_add_file_io_stats(opt: *mut Options, stats: *mut DBFileIoStats);
+    pub fn crocksdb_file_io_stats_by_file_type(
+        stats: *const DBFileIoStats,
+        op: DBFileIoOp,
+        file_type: DBIoFileType,
+        hist: *mut DBIoHistogram,
+    );
+    pub fn crocksdb_file_io_stats_by_level(
+        stats: *const DBFileIoStats,
+        op: DBFileIoOp,
+        level: c_int,
+        hist: *mut DBIoHistogram,
+    );
+    pub fn crocksdb_file_io_stats_table_files(
+        stats: *const DBFileIoStats,
+        created: *mut u64,
+        created_bytes: *mut u64,
+        deleted: *mut u64,
+    );
+    pub fn crocksdb_file_io_stats_reset(stats: *mut DBFileIoStats);
+
     pub fn crocksdb_post_write_callback_init(
         buf: *mut c_void,
         buf_len: usize,
@@ -2581,6 +3664,26 @@ extern "C" {
         err: *mut *mut c_char,
     ) -> u64;
 
+    pub fn crocksdb_get_split_keys_cf(
+        db: *mut DBInstance,
+        cf: *mut DBCFHandle,
+        start_key: *const u8,
+        start_key_len: size_t,
+        limit_key: *const u8,
+        limit_key_len: size_t,
+        num_keys: size_t,
+        errptr: *mut *mut c_char,
+    ) -> *mut DBSplitKeys;
+    pub fn crocksdb_split_keys_destroy(keys: *mut DBSplitKeys);
+    pub fn crocksdb_split_keys_count(keys: *const DBSplitKeys) -> size_t;
+    pub fn crocksdb_split_keys_key(
+        keys: *const DBSplitKeys,
+        index: size_t,
+        klen: *mut size_t,
+    ) -> *const u8;
+    pub fn crocksdb_split_keys_sst_size(keys: *const DBSplitKeys) -> u64;
+    pub fn crocksdb_split_keys_memtable_size(keys: *const DBSplitKeys) -> u64;
+
     pub fn crocksdb_get_column_family_meta_data(
         db: *mut DBInstance,
         cf: *mut DBCFHandle,
@@ -2663,6 +3766,16 @@ extern "C" {
     pub fn crocksdb_set_perf_flags(flags: *const DBPerfFlags);
     pub fn crocksdb_get_perf_context() -> *mut DBPerfContext;
     pub fn crocksdb_perf_context_reset(ctx: *mut DBPerfContext);
+    pub fn crocksdb_perf_context_snapshot(
+        ctx: *mut DBPerfContext,
+        snapshot: *mut DBPerfContextSnapshot,
+    ) -> c_uchar;
+    pub fn crocksdb_perf_context_snapshot_diff(
+        before: *const DBPerfContextSnapshot,
+        after: *const DBPerfContextSnapshot,
+        diff: *mut DBPerfContextSnapshot,
+    );
+    pub fn crocksdb_perf_context_set_per_level_enabled(ctx: *mut DBPerfContext, enabled: bool);
     pub fn crocksdb_perf_context_user_key_comparison_count(ctx: *mut DBPerfContext) -> u64;
     pub fn crocksdb_perf_context_block_cache_hit_count(ctx: *mut DBPerfContext) -> u64;
     pub fn crocksdb_perf_context_block_read_count(ctx: *mut DBPerfContext) -> u64;
@@ -2760,6 +3873,18 @@ extern "C" {
     pub fn crocksdb_iostats_context_fsync_nanos(ctx: *mut DBIOStatsContext) -> u64;
     pub fn crocksdb_iostats_context_prepare_write_nanos(ctx: *mut DBIOStatsContext) -> u64;
     pub fn crocksdb_iostats_context_logger_nanos(ctx: *mut DBIOStatsContext) -> u64;
+    pub fn crocksdb_iostats_context_snapshot(
+        ctx: *mut DBIOStatsContext,
+        snapshot: *mut DBIOStatsSnapshot,
+    );
+
+    pub fn crocksdb_op_tracing_set_sample_every(every: u32);
+    pub fn crocksdb_op_tracing_sample_every() -> u32;
+    pub fn crocksdb_op_tracing_get(op: DBTracedOp, latency: *mut DBOpLatency);
+    pub fn crocksdb_op_tracing_reset();
+    pub fn crocksdb_op_latency_merge(dst: *mut DBOpLatency, src: *const DBOpLatency);
+    pub fn crocksdb_op_latency_bucket_lower_nanos(bucket: usize) -> u64;
+    pub fn crocksdb_op_latency_percentile_nanos(latency: *const DBOpLatency, p: f64) -> u64;
 
     pub fn crocksdb_sst_partitioner_request_create() -> *mut DBSstPartitionerRequest;
     pub fn crocksdb_sst_partitioner_request_destroy(state: *mut DBSstPartitionerRequest);
@@ -2895,6 +4020,21 @@ extern "C" {
         factory: *mut DBSstPartitionerFactory,
         context: *mut DBSstPartitionerContext,
     ) -> *mut DBSstPartitioner;
+    pub fn crocksdb_sst_partitioner_boundaries_create() -> *mut DBSstPartitionerBoundaries;
+    pub fn crocksdb_sst_partitioner_boundaries_destroy(boundaries: *mut DBSstPartitionerBoundaries);
+    pub fn crocksdb_sst_partitioner_boundaries_set(
+        boundaries: *mut DBSstPartitionerBoundaries,
+        keys: *const *const u8,
+        key_lens: *const size_t,
+        num_keys: size_t,
+    );
+    pub fn crocksdb_sst_partitioner_boundaries_len(
+        boundaries: *const DBSstPartitionerBoundaries,
+    ) -> size_t;
+    pub fn crocksdb_sst_partitioner_factory_create_boundary(
+        boundaries: *const DBSstPartitionerBoundaries,
+        min_output_file_size: u64,
+    ) -> *mut DBSstPartitionerFactory;
 
     pub fn crocksdb_run_ldb_tool(argc: c_int, argv: *const *const c_char, opts: *const Options);
     pub fn crocksdb_run_sst_dump_tool(
@@ -3203,6 +4343,94 @@ mod test {
         }
     }
 
+    unsafe fn shortest_separator(cmp: *const DBComparator, start: &[u8], limit: &[u8]) -> Vec<u8> {
+        let mut len = 0;
+        let ptr = crocksdb_comparator_find_shortest_separator(
+            cmp,
+            start.as_ptr(),
+            start.len(),
+            limit.as_ptr(),
+            limit.len(),
+            &mut len,
+        );
+        let res = slice::from_raw_parts(ptr, len).to_vec();
+        libc::free(ptr as *mut c_void);
+        res
+    }
+
+    unsafe fn short_successor(cmp: *const DBComparator, key: &[u8]) -> Vec<u8> {
+        let mut len = 0;
+        let ptr = crocksdb_comparator_find_short_successor(cmp, key.as_ptr(), key.len(), &mut len);
+        let res = slice::from_raw_parts(ptr, len).to_vec();
+        libc::free(ptr as *mut c_void);
+        res
+    }
+
+    fn concat(a: &[u8], b: &[u8]) -> Vec<u8> {
+        let mut v = a.to_vec();
+        v.extend_from_slice(b);
+        v
+    }
+
+    #[test]
+    fn test_builtin_comparator_shortening() {
+        unsafe {
+            let mut err = ptr::null_mut();
+            let name = CString::new("crocksdb.U64PrefixBytewiseComparator").unwrap();
+            let cmp = crocksdb_comparator_create_builtin(name.as_ptr(), &mut err);
+            assert!(err.is_null(), error_message(err));
+            let p = |n: u64| n.to_be_bytes();
+
+            // Same prefix: only the suffix is shortened.
+            assert_eq!(
+                shortest_separator(cmp, &concat(&p(1), b"abcdef"), &concat(&p(1), b"abzzz")),
+                concat(&p(1), b"abd")
+            );
+            // A whole prefix fits in between.
+            assert_eq!(
+                shortest_separator(cmp, &concat(&p(1), b"xyz"), &concat(&p(5), b"a")),
+                p(2).to_vec()
+            );
+            // Adjacent prefixes: the suffix is bumped but the prefix is kept.
+            assert_eq!(
+                shortest_separator(cmp, &concat(&p(1), b"abc"), &concat(&p(2), b"a")),
+                concat(&p(1), b"b")
+            );
+            // Keys without a full prefix are left alone.
+            assert_eq!(shortest_separator(cmp, b"abc", b"abz"), b"abc".to_vec());
+            assert_eq!(
+                short_successor(cmp, &concat(&p(3), b"abc")),
+                concat(&p(3), b"b")
+            );
+            assert_eq!(
+                short_successor(cmp, &concat(&p(3), b"\xff\xff")),
+                concat(&p(3), b"\xff\xff")
+            );
+            assert_eq!(short_successor(cmp, &p(3)), p(3).to_vec());
+            crocksdb_comparator_destroy(cmp);
+
+            let name = CString::new("crocksdb.BytewiseDescTsSuffixComparator").unwrap();
+            let cmp = crocksdb_comparator_create_builtin(name.as_ptr(), &mut err);
+            assert!(err.is_null(), error_message(err));
+            let ts = |n: u64| n.to_be_bytes();
+            let max_ts = [0xffu8; 8];
+            assert_eq!(
+                shortest_separator(cmp, &concat(b"abcdef", &ts(5)), &concat(b"abzz", &ts(1))),
+                concat(b"abd", &max_ts)
+            );
+            // Versions of the same user key can't be separated by a shorter key.
+            assert_eq!(
+                shortest_separator(cmp, &concat(b"abc", &ts(5)), &concat(b"abc", &ts(1))),
+                concat(b"abc", &ts(5))
+            );
+            assert_eq!(
+                short_successor(cmp, &concat(b"abc", &ts(3))),
+                concat(b"b", &max_ts)
+            );
+            crocksdb_comparator_destroy(cmp);
+        }
+    }
+
     #[test]
     fn test_ingest_external_file() {
         unsafe {
@@ -219,6 +219,44 @@ impl DBEncryptionKeyManager {
         };
         DBEncryptionKeyManager { inner: instance }
     }
+
+    /// Like `new`, but caches the info returned by `get_file` for up to
+    /// `capacity` files. Files created, deleted or linked by the encrypted
+    /// env are invalidated automatically; files changed by other means must
+    /// be invalidated with `invalidate_cached_file`.
+    pub fn with_cache<T: EncryptionKeyManager>(
+        key_manager: T,
+        capacity: usize,
+    ) -> DBEncryptionKeyManager {
+        let manager = DBEncryptionKeyManager::new(key_manager);
+        unsafe {
+            crocksdb_ffi::crocksdb_encryption_key_manager_enable_cache(manager.inner, capacity);
+        }
+        manager
+    }
+
+    pub fn invalidate_cached_file(&self, fname: &str) {
+        let fname = CString::new(fname).unwrap();
+        unsafe {
+            crocksdb_ffi::crocksdb_encryption_key_manager_invalidate_cache(
+                self.inner,
+                fname.as_ptr(),
+            );
+        }
+    }
+
+    /// Returns the number of cache hits and misses of `get_file`.
+    pub fn cache_stats(&self) -> (u64, u64) {
+        let (mut hits, mut misses) = (0, 0);
+        unsafe {
+            crocksdb_ffi::crocksdb_encryption_key_manager_cache_stats(
+                self.inner,
+                &mut hits,
+                &mut misses,
+            );
+        }
+        (hits, misses)
+    }
 }
 
 impl Drop for DBEncryptionKeyManager {
@@ -500,6 +538,44 @@ mod test {
         assert_eq!("get_file_path", record.fname.lock().unwrap().as_str());
     }
 
+    #[test]
+    fn get_file_cached() {
+        let key_manager = Arc::new(Mutex::new(TestEncryptionKeyManager {
+            return_value: Some(FileEncryptionInfo {
+                method: DBEncryptionMethod::Aes128Ctr,
+                key: b"test_key_get_file".to_vec(),
+                iv: b"test_iv_get_file".to_vec(),
+            }),
+            ..Default::default()
+        }));
+        let db_key_manager = DBEncryptionKeyManager::with_cache(key_manager.clone(), 16);
+        for _ in 0..3 {
+            let file_info = db_key_manager.get_file("a").unwrap();
+            assert_eq!(b"test_key_get_file", file_info.key.as_slice());
+        }
+        assert_eq!(db_key_manager.cache_stats(), (2, 1));
+
+        db_key_manager.link_file("b", "a").unwrap();
+        db_key_manager.get_file("a").unwrap();
+        db_key_manager.delete_file("a", None).unwrap();
+        db_key_manager.get_file("a").unwrap();
+        db_key_manager.invalidate_cached_file("a");
+        db_key_manager.get_file("a").unwrap();
+        db_key_manager.new_file("a").unwrap();
+        db_key_manager.get_file("a").unwrap();
+        db_key_manager.get_file("a").unwrap();
+        assert_eq!(db_key_manager.cache_stats(), (3, 5));
+        let record = key_manager.lock().unwrap();
+        assert_eq!(5, record.get_file_called.load(Ordering::SeqCst));
+
+        // Errors are not cached.
+        let key_manager = Arc::new(Mutex::new(TestEncryptionKeyManager::default()));
+        let db_key_manager = DBEncryptionKeyManager::with_cache(key_manager.clone(), 16);
+        assert!(db_key_manager.get_file("a").is_err());
+        assert!(db_key_manager.get_file("a").is_err());
+        assert_eq!(db_key_manager.cache_stats(), (0, 2));
+    }
+
     #[test]
     fn get_file_error() {
         let key_manager = Arc::new(Mutex::new(TestEncryptionKeyManager::default()));
@@ -13,11 +13,13 @@
 
 use crocksdb_ffi::{
     self, CompactionReason, DBBackgroundErrorReason, DBCompactionJobInfo, DBEventListener,
-    DBFlushJobInfo, DBIngestionInfo, DBInstance, DBMemTableInfo, DBStatusPtr,
-    DBSubcompactionJobInfo, DBWriteStallInfo, WriteStallCondition,
+    DBEventRecord, DBEventRing, DBFileIoOp, DBFileIoStats, DBFlushJobInfo, DBIngestionInfo,
+    DBInstance, DBIoFileType, DBIoHistogram, DBMemTableInfo, DBStatusPtr, DBSubcompactionJobInfo,
+    DBWriteStallInfo, WriteStallCondition,
 };
 use libc::c_void;
 use std::path::Path;
+use std::ptr;
 use std::{slice, str};
 use {TableProperties, TablePropertiesCollectionView};
 
@@ -398,3 +400,125 @@ pub fn new_event_listener<E: EventListener>(e: E) -> *mut DBEventListener {
         )
     }
 }
+
+/// A bounded queue of `DBEventRecord`s filled by the DB's background threads
+/// without calling into Rust. Records are dropped when the queue is full, so
+/// it should be drained periodically.
+pub struct EventRing {
+    pub(crate) inner: *mut DBEventRing,
+}
+
+unsafe impl Send for EventRing {}
+unsafe impl Sync for EventRing {}
+
+impl EventRing {
+    pub fn new(capacity: usize) -> EventRing {
+        unsafe {
+            EventRing {
+                inner: crocksdb_ffi::crocksdb_event_ring_create(capacity),
+            }
+        }
+    }
+
+    /// Takes up to `max` of the oldest records.
+    pub fn drain(&self, max: usize) -> Vec<DBEventRecord> {
+        let mut records = Vec::with_capacity(max);
+        unsafe {
+            let n = crocksdb_ffi::crocksdb_event_ring_drain(self.inner, records.as_mut_ptr(), max);
+            records.set_len(n);
+        }
+        records
+    }
+
+    /// Number of records dropped because the queue was full.
+    pub fn dropped(&self) -> u64 {
+        unsafe { crocksdb_ffi::crocksdb_event_ring_dropped(self.inner) }
+    }
+}
+
+impl Drop for EventRing {
+    fn drop(&mut self) {
+        unsafe {
+            crocksdb_ffi::crocksdb_event_ring_destroy(self.inner);
+        }
+        self.inner = ptr::null_mut();
+    }
+}
+
+/// Table files created and deleted since the stats were created or reset.
+#[derive(Clone, Copy, Debug, Default, PartialEq)]
+pub struct TableFileCounts {
+    pub created: u64,
+    pub created_bytes: u64,
+    pub deleted: u64,
+}
+
+/// Latency histograms of file IO, aggregated natively by file type and LSM
+/// level without calling into Rust.
+pub struct FileIoStats {
+    pub(crate) inner: *mut DBFileIoStats,
+}
+
+unsafe impl Send for FileIoStats {}
+unsafe impl Sync for FileIoStats {}
+
+impl FileIoStats {
+    pub fn new() -> FileIoStats {
+        unsafe {
+            FileIoStats {
+                inner: crocksdb_ffi::crocksdb_file_io_stats_create(),
+            }
+        }
+    }
+
+    pub fn by_file_type(&self, op: DBFileIoOp, file_type: DBIoFileType) -> DBIoHistogram {
+        let mut hist = DBIoHistogram::default();
+        unsafe {
+            crocksdb_ffi::crocksdb_file_io_stats_by_file_type(self.inner, op, file_type, &mut hist);
+        }
+        hist
+    }
+
+    /// IO on table files of `level`. Files are attributed to a level once a
+    /// flush, compaction or ingestion has been observed.
+    pub fn by_level(&self, op: DBFileIoOp, level: i32) -> DBIoHistogram {
+        let mut hist = DBIoHistogram::default();
+        unsafe {
+            crocksdb_ffi::crocksdb_file_io_stats_by_level(self.inner, op, level, &mut hist);
+        }
+        hist
+    }
+
+    pub fn table_files(&self) -> TableFileCounts {
+        let mut counts = TableFileCounts::default();
+        unsafe {
+            crocksdb_ffi::crocksdb_file_io_stats_table_files(
+                self.inner,
+                &mut counts.created,
+                &mut counts.created_bytes,
+                &mut counts.deleted,
+            );
+        }
+        counts
+    }
+
+    pub fn reset(&self) {
+        unsafe {
+            crocksdb_ffi::crocksdb_file_io_stats_reset(self.inner);
+        }
+    }
+}
+
+impl Default for FileIoStats {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+impl Drop for FileIoStats {
+    fn drop(&mut self) {
+        unsafe {
+            crocksdb_ffi::crocksdb_file_io_stats_destroy(self.inner);
+        }
+    }
+}
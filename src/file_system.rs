@@ -1,6 +1,8 @@
 // Copyright 2020 TiKV Project Authors. Licensed under Apache-2.0.
 
-pub use crocksdb_ffi::{self, DBFileSystemInspectorInstance};
+pub use crocksdb_ffi::{
+    self, DBFileIoOp, DBFileSystemInspectorInstance, DBIoPriority, DBTokenBucketInspector,
+};
 
 use libc::{c_char, c_void, size_t, strdup};
 
@@ -81,6 +83,93 @@ impl Drop for DBFileSystemInspector {
     }
 }
 
+impl DBFileSystemInspector {
+    pub fn from_token_bucket(inspector: &TokenBucketInspector) -> DBFileSystemInspector {
+        let instance = unsafe {
+            crocksdb_ffi::crocksdb_file_system_inspector_create_token_bucket(inspector.inner)
+        };
+        DBFileSystemInspector { inner: instance }
+    }
+}
+
+/// Sets the priority of file IO issued by the current thread, which selects
+/// the token bucket of `TokenBucketInspector` it is throttled by.
+pub fn set_thread_io_priority(priority: DBIoPriority) {
+    unsafe { crocksdb_ffi::crocksdb_set_thread_io_priority(priority) }
+}
+
+#[derive(Clone, Copy, Debug, Default, PartialEq)]
+pub struct IoCounters {
+    pub bytes: u64,
+    pub requests: u64,
+    pub wait_micros: u64,
+}
+
+/// Throttles file IO natively with a token bucket per IO type and priority,
+/// so the data path never calls into Rust. Buckets are unlimited until a
+/// rate is set.
+pub struct TokenBucketInspector {
+    pub(crate) inner: *mut DBTokenBucketInspector,
+}
+
+unsafe impl Send for TokenBucketInspector {}
+unsafe impl Sync for TokenBucketInspector {}
+
+impl TokenBucketInspector {
+    pub fn new() -> TokenBucketInspector {
+        unsafe {
+            TokenBucketInspector {
+                inner: crocksdb_ffi::crocksdb_token_bucket_inspector_create(),
+            }
+        }
+    }
+
+    /// `op` must be `Read` or `Write`. A rate of 0 disables throttling.
+    pub fn set_rate(&self, op: DBFileIoOp, priority: DBIoPriority, bytes_per_sec: i64) {
+        unsafe {
+            crocksdb_ffi::crocksdb_token_bucket_inspector_set_rate(
+                self.inner,
+                op,
+                priority,
+                bytes_per_sec,
+            );
+        }
+    }
+
+    pub fn rate(&self, op: DBFileIoOp, priority: DBIoPriority) -> i64 {
+        unsafe { crocksdb_ffi::crocksdb_token_bucket_inspector_get_rate(self.inner, op, priority) }
+    }
+
+    pub fn counters(&self, op: DBFileIoOp, priority: DBIoPriority) -> IoCounters {
+        let mut c = IoCounters::default();
+        unsafe {
+            crocksdb_ffi::crocksdb_token_bucket_inspector_counters(
+                self.inner,
+                op,
+                priority,
+                &mut c.bytes,
+                &mut c.requests,
+                &mut c.wait_micros,
+            );
+        }
+        c
+    }
+}
+
+impl Default for TokenBucketInspector {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+impl Drop for TokenBucketInspector {
+    fn drop(&mut self) {
+        unsafe {
+            crocksdb_ffi::crocksdb_token_bucket_inspector_destroy(self.inner);
+        }
+    }
+}
+
 #[cfg(test)]
 impl FileSystemInspector for DBFileSystemInspector {
     fn read(&self, len: usize) -> Result<usize, String> {
@@ -165,6 +254,32 @@ mod test {
         assert_eq!(1, drop_called.load(Ordering::SeqCst));
     }
 
+    #[test]
+    fn test_token_bucket_inspector() {
+        let tb = TokenBucketInspector::new();
+        let inspector = DBFileSystemInspector::from_token_bucket(&tb);
+        // Unlimited by default.
+        assert_eq!(1 << 20, inspector.read(1 << 20).unwrap());
+
+        tb.set_rate(DBFileIoOp::Write, DBIoPriority::Low, 1 << 20);
+        assert_eq!(tb.rate(DBFileIoOp::Write, DBIoPriority::Low), 1 << 20);
+        set_thread_io_priority(DBIoPriority::Low);
+        let mut written = 0;
+        while written < 1 << 18 {
+            let n = inspector.write(1 << 16).unwrap();
+            assert!(n > 0 && n <= 1 << 16);
+            written += n;
+        }
+        set_thread_io_priority(DBIoPriority::Normal);
+        let low = tb.counters(DBFileIoOp::Write, DBIoPriority::Low);
+        assert_eq!(low.bytes as usize, written);
+        // A full burst is 100ms of tokens, so the rest had to wait.
+        assert!(low.wait_micros > 0);
+        let normal = tb.counters(DBFileIoOp::Read, DBIoPriority::Normal);
+        assert_eq!(normal.bytes, 1 << 20);
+        assert_eq!(normal.requests, 1);
+    }
+
     #[test]
     fn test_inspected_operation() {
         let fs_inspector = Arc::new(Mutex::new(TestFileSystemInspector {
@@ -37,48 +37,61 @@ pub use compaction_filter::{
     DBCompactionFilter,
 };
 #[cfg(feature = "encryption")]
-pub use encryption::{DBEncryptionMethod, EncryptionKeyManager, FileEncryptionInfo};
+pub use encryption::{
+    DBEncryptionKeyManager, DBEncryptionMethod, EncryptionKeyManager, FileEncryptionInfo,
+};
 pub use event_listener::{
-    CompactionJobInfo, EventListener, FlushJobInfo, IngestionInfo, MemTableInfo, MutableStatus,
-    SubcompactionJobInfo, WriteStallInfo,
+    CompactionJobInfo, EventListener, EventRing, FileIoStats, FlushJobInfo, IngestionInfo,
+    MemTableInfo, MutableStatus, SubcompactionJobInfo, TableFileCounts, WriteStallInfo,
+};
+pub use file_system::{
+    set_thread_io_priority, FileSystemInspector, IoCounters, TokenBucketInspector,
 };
-pub use file_system::FileSystemInspector;
 pub use librocksdb_sys::{
     self as crocksdb_ffi, new_bloom_filter, ChecksumType, CompactionPriority, CompactionReason,
-    DBBackgroundErrorReason, DBBottommostLevelCompaction, DBCompactionStyle, DBCompressionType,
-    DBEntryType, DBInfoLogLevel, DBRateLimiterMode, DBRecoveryMode,
+    DBBackgroundErrorReason, DBBackgroundJob, DBBackgroundJobStage, DBBackgroundJobType,
+    DBBottommostLevelCompaction, DBCacheEntryRole, DBCacheRoleUsage, DBCacheUsage,
+    DBCompactionStyle, DBCompressionType, DBEntryType, DBEventRecord, DBEventType, DBFileIoOp,
+    DBHistogramSummary, DBIOStatsSnapshot, DBInfoLogLevel, DBIoFileType, DBIoHistogram,
+    DBIoPriority, DBLevelFilterType, DBMvccProperties, DBOpLatency, DBPerfContextLevel,
+    DBPerfContextSnapshot, DBPropertyEncoding, DBRateLimiterMode, DBRecoveryMode,
     DBSstPartitionerResult as SstPartitionerResult, DBStatisticsHistogramType,
-    DBStatisticsTickerType, DBStatusPtr, DBTableFileCreationReason, DBTitanDBBlobRunMode,
-    DBValueType, IndexType, PrepopulateBlockCache, WriteStallCondition,
+    DBStatisticsTickerType, DBStatusPtr, DBTableFileCreationReason, DBThreadType,
+    DBTimestampEncoding, DBTitanDBBlobRunMode, DBTraceFilter, DBTracedOp, DBValueType, IndexType,
+    PrepopulateBlockCache, WriteStallCondition,
 };
 pub use logger::Logger;
 pub use merge_operator::MergeOperands;
 pub use metadata::{ColumnFamilyMetaData, LevelMetaData, SstFileMetaData};
 pub use perf_context::{
-    get_perf_level, set_perf_flags, set_perf_level, IOStatsContext, PerfContext, PerfFlag,
-    PerfFlags, PerfLevel,
+    get_perf_level, op_latency, op_trace_sample_every, reset_op_latency, set_op_trace_sample_every,
+    set_perf_flags, set_perf_level, IOStatsContext, PerfContext, PerfFlag, PerfFlags, PerfLevel,
 };
 pub use rocksdb::{
-    load_latest_options, run_ldb_tool, run_sst_dump_tool, set_external_sst_file_global_seq_no,
-    BackupEngine, CFHandle, Cache, DBIterator, DBVector, Env, ExternalSstFileInfo, MapProperty,
-    MemoryAllocator, Range, SeekKey, SequentialFile, SstFileReader, SstFileWriter, Writable,
-    WritableFile, DB,
+    io_uring_supported, load_latest_options, run_ldb_tool, run_sst_dump_tool,
+    set_external_sst_file_global_seq_no, set_io_uring_enabled, BackgroundJob, BackupEngine,
+    CFHandle, Cache, CacheUsageMonitor, DBIterator, DBVector, Env, ExternalSstFileInfo,
+    MapProperty, MemoryAllocator, Range, RangePrefetch, RangePrefetchProgress, RangeProperties,
+    SecondaryCache, SecondaryCacheCounters, SeekKey, SequentialFile, SplitKeys, SstFileReader,
+    SstFileWriter, TraceReplayReport, Writable, WritableFile, DB,
 };
 pub use rocksdb_options::{
-    BlockBasedOptions, CColumnFamilyDescriptor, ColumnFamilyOptions, CompactOptions,
-    CompactionOptions, ConcurrentTaskLimiter, DBOptions, EnvOptions, FifoCompactionOptions,
-    FlushOptions, HistogramData, HyperClockCacheOptions, IngestExternalFileOptions,
-    LRUCacheOptions, MergeInstanceOptions, RateLimiter, ReadOptions, RestoreOptions, Statistics,
-    WriteBufferManager, WriteOptions,
+    BlockBasedOptions, CColumnFamilyDescriptor, CacheDumpOptions, ColumnFamilyOptions,
+    CompactOptions, CompactionOptions, ConcurrentTaskLimiter, DBOptions, EnvOptions,
+    FifoCompactionOptions, FilterStats, FlushOptions, HistogramData, HyperClockCacheOptions,
+    IngestExternalFileOptions, LRUCacheOptions, LevelFilter, MergeInstanceOptions, RateLimiter,
+    ReadOptions, RestoreOptions, Statistics, StatisticsExport, TraceOptions, WriteBufferManager,
+    WriteOptions,
 };
-pub use slice_transform::SliceTransform;
+pub use slice_transform::{BuiltinSliceTransform, SliceTransform};
 pub use sst_partitioner::{
-    SstPartitioner, SstPartitionerContext, SstPartitionerFactory, SstPartitionerRequest,
+    SstPartitioner, SstPartitionerBoundaries, SstPartitionerContext, SstPartitionerFactory,
+    SstPartitionerRequest,
 };
 pub use table_filter::TableFilter;
 pub use table_properties::{
-    TableProperties, TablePropertiesCollection, TablePropertiesCollectionView,
-    UserCollectedProperties,
+    TableProperties, TablePropertiesCache, TablePropertiesCollection,
+    TablePropertiesCollectionView, UserCollectedProperties,
 };
 pub use table_properties_collector::TablePropertiesCollector;
 pub use table_properties_collector_factory::TablePropertiesCollectorFactory;
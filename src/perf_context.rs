@@ -11,7 +11,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-use crocksdb_ffi::{self, DBIOStatsContext, DBPerfContext, DBPerfFlags};
+use crocksdb_ffi::{
+    self, DBIOStatsContext, DBIOStatsSnapshot, DBOpLatency, DBPerfContext, DBPerfContextSnapshot,
+    DBPerfFlags, DBTracedOp,
+};
 
 use std::{
     ops::{BitOr, BitOrAssign},
@@ -268,6 +271,20 @@ impl PerfContext {
         unsafe { crocksdb_ffi::crocksdb_perf_context_reset(self.inner) }
     }
 
+    /// Copies all counters, including the per-level ones, in one call.
+    pub fn snapshot(&self) -> DBPerfContextSnapshot {
+        let mut snapshot = DBPerfContextSnapshot::default();
+        let supported =
+            unsafe { crocksdb_ffi::crocksdb_perf_context_snapshot(self.inner, &mut snapshot) };
+        assert!(supported != 0);
+        snapshot
+    }
+
+    /// Enables or disables the counters broken down by LSM level.
+    pub fn set_per_level_enabled(&mut self, enabled: bool) {
+        unsafe { crocksdb_ffi::crocksdb_perf_context_set_per_level_enabled(self.inner, enabled) }
+    }
+
     pub fn user_key_comparison_count(&self) -> u64 {
         unsafe { crocksdb_ffi::crocksdb_perf_context_user_key_comparison_count(self.inner) }
     }
@@ -645,11 +662,44 @@ impl IOStatsContext {
     pub fn logger_nanos(&self) -> u64 {
         unsafe { crocksdb_ffi::crocksdb_iostats_context_logger_nanos(self.inner) }
     }
+
+    /// Copies all counters in one call.
+    pub fn snapshot(&self) -> DBIOStatsSnapshot {
+        let mut snapshot = DBIOStatsSnapshot::default();
+        unsafe {
+            crocksdb_ffi::crocksdb_iostats_context_snapshot(self.inner, &mut snapshot);
+        }
+        snapshot
+    }
+}
+
+/// Samples one in every `every` gets, multi-gets, writes, iterator seeks and
+/// steps and ingestions on each thread, recording their latency and
+/// PerfContext deltas. Zero, the default, disables sampling.
+pub fn set_op_trace_sample_every(every: u32) {
+    unsafe { crocksdb_ffi::crocksdb_op_tracing_set_sample_every(every) }
+}
+
+pub fn op_trace_sample_every() -> u32 {
+    unsafe { crocksdb_ffi::crocksdb_op_tracing_sample_every() }
+}
+
+/// Latency of the sampled `op` operations of all threads.
+pub fn op_latency(op: DBTracedOp) -> DBOpLatency {
+    let mut latency = DBOpLatency::default();
+    unsafe {
+        crocksdb_ffi::crocksdb_op_tracing_get(op, &mut latency);
+    }
+    latency
+}
+
+pub fn reset_op_latency() {
+    unsafe { crocksdb_ffi::crocksdb_op_tracing_reset() }
 }
 
 #[cfg(test)]
 mod test {
-    use rocksdb::{SeekKey, Writable, DB};
+    use rocksdb::{SeekKey, Writable, WriteBatch, DB};
     use rocksdb_options::{DBOptions, FlushOptions, WriteOptions};
 
     use super::*;
@@ -699,6 +749,104 @@ mod test {
         assert_ne!(ctx.seek_internal_seek_time(), 0);
     }
 
+    #[test]
+    fn test_perf_context_snapshot() {
+        let temp_dir = tempdir_with_prefix("test_perf_context_snapshot");
+        let mut opts = DBOptions::new();
+        opts.create_if_missing(true);
+        let db = DB::open(opts, temp_dir.path().to_str().unwrap()).unwrap();
+        let n = 10;
+        for i in 0..n {
+            let k = &[i as u8];
+            db.put(k, k).unwrap();
+            if i % 2 == 0 {
+                db.delete(k).unwrap();
+            }
+        }
+        let mut fopts = FlushOptions::default();
+        fopts.set_wait(true);
+        db.flush(&fopts).unwrap();
+
+        set_perf_level(PerfLevel::EnableCount);
+        let mut ctx = PerfContext::get();
+        ctx.reset();
+        ctx.set_per_level_enabled(true);
+        let before = ctx.snapshot();
+        let mut iter = db.iter();
+        assert!(iter.seek(SeekKey::Start).unwrap());
+        while iter.next().unwrap() {}
+        for i in 0..n {
+            db.get(&[i as u8]).unwrap();
+        }
+        let after = ctx.snapshot();
+        assert_eq!(
+            after.internal_key_skipped_count,
+            ctx.internal_key_skipped_count()
+        );
+        assert_eq!(
+            after.internal_delete_skipped_count,
+            ctx.internal_delete_skipped_count()
+        );
+        assert!(after.num_levels > 0);
+
+        let diff = after.diff(&before);
+        assert_eq!(
+            diff.internal_key_skipped_count,
+            after.internal_key_skipped_count - before.internal_key_skipped_count
+        );
+        assert_eq!(diff.internal_delete_skipped_count, n / 2);
+        let level = &diff.levels[after.num_levels as usize - 1];
+        assert!(level.get_from_table_nanos > 0 || level.user_key_return_count > 0);
+        ctx.set_per_level_enabled(false);
+    }
+
+    #[test]
+    fn test_op_latency() {
+        let temp_dir = tempdir_with_prefix("test_op_latency");
+        let mut opts = DBOptions::new();
+        opts.create_if_missing(true);
+        let db = DB::open(opts, temp_dir.path().to_str().unwrap()).unwrap();
+
+        set_op_trace_sample_every(2);
+        assert_eq!(op_trace_sample_every(), 2);
+        let before = op_latency(DBTracedOp::Get);
+        let n = 100;
+        for i in 0..n {
+            let k = &[i as u8];
+            let wb = WriteBatch::new();
+            wb.put(k, k).unwrap();
+            db.write(&wb).unwrap();
+        }
+        for i in 0..n {
+            assert!(db.get(&[i as u8]).unwrap().is_some());
+        }
+        let mut iter = db.iter();
+        assert!(iter.seek(SeekKey::Start).unwrap());
+        while iter.next().unwrap() {}
+        set_op_trace_sample_every(0);
+
+        // Sampling is process-wide, so other tests running meanwhile may add
+        // to the counters, even between reading the count and the buckets.
+        let get = op_latency(DBTracedOp::Get);
+        assert!(get.count >= before.count + n / 2);
+        assert!(get.buckets.iter().sum::<u64>() >= before.count + n / 2);
+        assert!(get.max_nanos > 0);
+        assert!(get.percentile_nanos(50.0) <= get.percentile_nanos(99.0));
+        assert!(get.percentile_nanos(99.0) <= get.max_nanos);
+        assert!(op_latency(DBTracedOp::Write).count >= n / 2);
+        let next = op_latency(DBTracedOp::IterNext);
+        assert!(next.count >= n / 2);
+        assert!(next.internal_key_skipped_count > 0);
+
+        let mut merged = get;
+        merged.merge(&next);
+        assert_eq!(merged.count, get.count + next.count);
+        assert_eq!(merged.max_nanos, get.max_nanos.max(next.max_nanos));
+        for i in 1..crocksdb_ffi::OP_LATENCY_BUCKETS {
+            assert!(DBOpLatency::bucket_lower_nanos(i) > DBOpLatency::bucket_lower_nanos(i - 1));
+        }
+    }
+
     #[test]
     fn test_iostats_context() {
         let temp_dir = tempdir_with_prefix("test_iostats_context");
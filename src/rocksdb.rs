@@ -13,22 +13,26 @@
 // limitations under the License.
 
 use crocksdb_ffi::{
-    self, DBBackupEngine, DBCFHandle, DBCache, DBCompressionType, DBEnv, DBInstance, DBMapProperty,
-    DBPinnableSlice, DBPostWriteCallback, DBSequentialFile, DBTablePropertiesCollection,
-    DBTitanDBOptions, DBWritableFile, DBWriteBatch,
+    self, DBBackgroundJob, DBBackupEngine, DBCFHandle, DBCache, DBCacheRoleUsage, DBCacheUsage,
+    DBCacheUsageMonitor, DBCompressionType, DBEnv, DBInstance, DBMapProperty, DBPinnableSlice,
+    DBPostWriteCallback, DBPropertyEncoding, DBRangePrefetch, DBSecondaryCache, DBSequentialFile,
+    DBTablePropertiesCollection, DBTitanDBOptions, DBTracedOp, DBWritableFile, DBWriteBatch,
+    TRACED_OP_COUNT,
 };
 use libc::{self, c_char, c_int, c_void, size_t};
 use librocksdb_sys::DBMemoryAllocator;
 use metadata::ColumnFamilyMetaData;
 use rocksdb_options::{
-    CColumnFamilyDescriptor, ColumnFamilyDescriptor, ColumnFamilyOptions, CompactOptions,
-    CompactionOptions, DBOptions, EnvOptions, FlushOptions, IngestExternalFileOptions,
-    LRUCacheOptions, MergeInstanceOptions, ReadOptions, RestoreOptions, UnsafeSnap, WriteOptions,
+    BlockBasedOptions, CColumnFamilyDescriptor, CacheDumpOptions, ColumnFamilyDescriptor,
+    ColumnFamilyOptions, CompactOptions, CompactionOptions, DBOptions, EnvOptions, FlushOptions,
+    IngestExternalFileOptions, LRUCacheOptions, MergeInstanceOptions, ReadOptions, RestoreOptions,
+    TraceOptions, UnsafeSnap, WriteOptions,
 };
 use std::collections::BTreeMap;
 use std::ffi::{CStr, CString};
 use std::fmt::{self, Debug, Formatter};
 use std::io;
+use std::marker::PhantomData;
 use std::mem;
 use std::mem::MaybeUninit;
 use std::ops::Deref;
@@ -41,8 +45,8 @@ use std::{fs, ptr, slice};
 
 #[cfg(feature = "encryption")]
 use encryption::{DBEncryptionKeyManager, EncryptionKeyManager};
-use file_system::{DBFileSystemInspector, FileSystemInspector};
-use table_properties::{TableProperties, TablePropertiesCollection};
+use file_system::{DBFileSystemInspector, FileSystemInspector, TokenBucketInspector};
+use table_properties::{TableProperties, TablePropertiesCache, TablePropertiesCollection};
 use table_properties_rc::TablePropertiesCollection as RcTablePropertiesCollection;
 use titan::TitanDBOptions;
 use write_batch::WriteBatch;
@@ -303,6 +307,23 @@ impl<D> DBIterator<D> {
         }
     }
 
+    /// Get the user-defined timestamp of the current entry, empty if the column family
+    /// does not enable timestamps. Must be called when `self.valid() == Ok(true)`.
+    ///
+    /// If `ReadOptions::set_iter_start_ts` is set, `key` returns the internal key, which
+    /// ends with this timestamp followed by an 8-byte sequence number and value type.
+    pub fn timestamp(&self) -> &[u8] {
+        debug_assert_eq!(self.valid(), Ok(true));
+        let mut ts_len: size_t = 0;
+        unsafe {
+            let ts_ptr = crocksdb_ffi::crocksdb_iter_timestamp(self.inner, &mut ts_len);
+            if ts_len == 0 {
+                return &[];
+            }
+            slice::from_raw_parts(ts_ptr, ts_len)
+        }
+    }
+
     #[deprecated]
     pub fn kv(&self) -> Option<(Vec<u8>, Vec<u8>)> {
         if self.valid().unwrap() {
@@ -465,6 +486,27 @@ impl<'a> Range<'a> {
     }
 }
 
+/// Approximate properties of a range, merged from the samples of the range
+/// properties collector.
+#[derive(Clone, Debug, Default, PartialEq)]
+pub struct RangeProperties {
+    pub size: u64,
+    pub num_keys: u64,
+    /// A key splitting the range in two halves by size.
+    pub middle_key: Option<Vec<u8>>,
+}
+
+/// Keys splitting a range into parts of even size, see `DB::get_split_keys_cf`.
+#[derive(Clone, Debug, Default, PartialEq)]
+pub struct SplitKeys {
+    pub keys: Vec<Vec<u8>>,
+    /// Approximate size of the range in SST files.
+    pub sst_size: u64,
+    /// Approximate size of the range in the memtables, which is not taken
+    /// into account by `keys`.
+    pub memtable_size: u64,
+}
+
 pub struct PostWriteCallback<'a, F: FnMut(u64)> {
     _callback: &'a mut F,
     raw_buf: MaybeUninit<[u64; 3]>,
@@ -1011,6 +1053,51 @@ impl DB {
         self.get_cf_opt(cf, key, &ReadOptions::new())
     }
 
+    /// Looks up `keys` in `cf` as one batch, so blocks of a file needed by
+    /// several keys are read together (in parallel with
+    /// `ReadOptions::set_optimize_multiget_for_io` and io_uring).
+    pub fn multi_get_cf_opt(
+        &self,
+        cf: &CFHandle,
+        keys: &[&[u8]],
+        readopts: &ReadOptions,
+    ) -> Vec<Result<Option<Vec<u8>>, String>> {
+        let n = keys.len();
+        let cfs = vec![cf.inner as *const DBCFHandle; n];
+        let keys_list: Vec<*const u8> = keys.iter().map(|k| k.as_ptr()).collect();
+        let keys_list_sizes: Vec<size_t> = keys.iter().map(|k| k.len() as size_t).collect();
+        let mut values_list = vec![ptr::null_mut::<u8>(); n];
+        let mut values_list_sizes = vec![0 as size_t; n];
+        let mut errs = vec![ptr::null_mut::<c_char>(); n];
+        unsafe {
+            crocksdb_ffi::crocksdb_multi_get_cf(
+                self.inner,
+                readopts.get_inner(),
+                cfs.as_ptr(),
+                n as size_t,
+                keys_list.as_ptr(),
+                keys_list_sizes.as_ptr(),
+                values_list.as_mut_ptr(),
+                values_list_sizes.as_mut_ptr(),
+                errs.as_mut_ptr(),
+            );
+            (0..n)
+                .map(|i| {
+                    if !errs[i].is_null() {
+                        return Err(crocksdb_ffi::error_message(errs[i]));
+                    }
+                    if values_list[i].is_null() {
+                        return Ok(None);
+                    }
+                    let value =
+                        slice::from_raw_parts(values_list[i], values_list_sizes[i]).to_vec();
+                    libc::free(values_list[i] as *mut c_void);
+                    Ok(Some(value))
+                })
+                .collect()
+        }
+    }
+
     pub fn create_cf<'a, T>(&mut self, cfd: T) -> Result<&CFHandle, String>
     where
         T: Into<ColumnFamilyDescriptor<'a>>,
@@ -1286,6 +1373,170 @@ impl DB {
         }
     }
 
+    /// Writes `key` at user-defined timestamp `ts`. The column family must be
+    /// opened with a timestamp-aware comparator whose timestamp size is `ts.len()`.
+    pub fn put_cf_with_ts_opt(
+        &self,
+        cf: &CFHandle,
+        key: &[u8],
+        ts: &[u8],
+        value: &[u8],
+        writeopts: &WriteOptions,
+    ) -> Result<(), String> {
+        unsafe {
+            ffi_try!(crocksdb_put_cf_with_ts(
+                self.inner,
+                writeopts.inner,
+                cf.inner,
+                key.as_ptr(),
+                key.len() as size_t,
+                ts.as_ptr(),
+                ts.len() as size_t,
+                value.as_ptr(),
+                value.len() as size_t
+            ));
+            Ok(())
+        }
+    }
+
+    pub fn put_cf_with_ts(
+        &self,
+        cf: &CFHandle,
+        key: &[u8],
+        ts: &[u8],
+        value: &[u8],
+    ) -> Result<(), String> {
+        self.put_cf_with_ts_opt(cf, key, ts, value, &WriteOptions::new())
+    }
+
+    pub fn delete_cf_with_ts_opt(
+        &self,
+        cf: &CFHandle,
+        key: &[u8],
+        ts: &[u8],
+        writeopts: &WriteOptions,
+    ) -> Result<(), String> {
+        unsafe {
+            ffi_try!(crocksdb_delete_cf_with_ts(
+                self.inner,
+                writeopts.inner,
+                cf.inner,
+                key.as_ptr(),
+                key.len() as size_t,
+                ts.as_ptr(),
+                ts.len() as size_t
+            ));
+            Ok(())
+        }
+    }
+
+    pub fn delete_cf_with_ts(&self, cf: &CFHandle, key: &[u8], ts: &[u8]) -> Result<(), String> {
+        self.delete_cf_with_ts_opt(cf, key, ts, &WriteOptions::new())
+    }
+
+    pub fn single_delete_cf_with_ts_opt(
+        &self,
+        cf: &CFHandle,
+        key: &[u8],
+        ts: &[u8],
+        writeopts: &WriteOptions,
+    ) -> Result<(), String> {
+        unsafe {
+            ffi_try!(crocksdb_single_delete_cf_with_ts(
+                self.inner,
+                writeopts.inner,
+                cf.inner,
+                key.as_ptr(),
+                key.len() as size_t,
+                ts.as_ptr(),
+                ts.len() as size_t
+            ));
+            Ok(())
+        }
+    }
+
+    pub fn delete_range_cf_with_ts_opt(
+        &self,
+        cf: &CFHandle,
+        begin_key: &[u8],
+        end_key: &[u8],
+        ts: &[u8],
+        writeopts: &WriteOptions,
+    ) -> Result<(), String> {
+        unsafe {
+            ffi_try!(crocksdb_delete_range_cf_with_ts(
+                self.inner,
+                writeopts.inner,
+                cf.inner,
+                begin_key.as_ptr(),
+                begin_key.len() as size_t,
+                end_key.as_ptr(),
+                end_key.len() as size_t,
+                ts.as_ptr(),
+                ts.len() as size_t
+            ));
+            Ok(())
+        }
+    }
+
+    /// Reads `key` as of the timestamp set by `ReadOptions::set_timestamp`,
+    /// returning the value together with the timestamp it was written at.
+    pub fn get_cf_with_ts_opt(
+        &self,
+        cf: &CFHandle,
+        key: &[u8],
+        readopts: &ReadOptions,
+    ) -> Result<Option<(DBVector, Vec<u8>)>, String> {
+        unsafe {
+            let mut ts: *mut u8 = ptr::null_mut();
+            let mut ts_len: size_t = 0;
+            let val = ffi_try!(crocksdb_get_pinned_cf_with_ts(
+                self.inner,
+                readopts.get_inner(),
+                cf.inner,
+                key.as_ptr(),
+                key.len() as size_t,
+                &mut ts,
+                &mut ts_len
+            ));
+            if val.is_null() {
+                return Ok(None);
+            }
+            let ts_vec = slice::from_raw_parts(ts, ts_len).to_vec();
+            libc::free(ts as *mut c_void);
+            Ok(Some((DBVector::from_pinned_slice(val), ts_vec)))
+        }
+    }
+
+    /// Allows compaction to drop versions older than `ts_low`. `ts_low` can
+    /// only increase.
+    pub fn increase_full_history_ts_low(&self, cf: &CFHandle, ts_low: &[u8]) -> Result<(), String> {
+        unsafe {
+            ffi_try!(crocksdb_increase_full_history_ts_low(
+                self.inner,
+                cf.inner,
+                ts_low.as_ptr(),
+                ts_low.len() as size_t
+            ));
+            Ok(())
+        }
+    }
+
+    pub fn get_full_history_ts_low(&self, cf: &CFHandle) -> Result<Vec<u8>, String> {
+        unsafe {
+            let mut len: size_t = 0;
+            let ts_low = ffi_try!(crocksdb_get_full_history_ts_low(
+                self.inner, cf.inner, &mut len
+            ));
+            if ts_low.is_null() {
+                return Ok(vec![]);
+            }
+            let res = slice::from_raw_parts(ts_low, len).to_vec();
+            libc::free(ts_low as *mut c_void);
+            Ok(res)
+        }
+    }
+
     /// Flush all memtable data.
     /// If wait, the flush will wait until the flush is done.
     pub fn flush(&self, opts: &FlushOptions) -> Result<(), String> {
@@ -1470,6 +1721,163 @@ impl DB {
         }
     }
 
+    /// Reads `[start_key, end_key)` of `cf` in the background to fill the
+    /// block cache with its data and index blocks, e.g. after a range was
+    /// ingested or moved here. The range is read in total order, whatever
+    /// the prefix extractor of `cf`. Reads are charged to the DB's rate
+    /// limiter only if its mode covers reads, and stop after `budget_bytes`
+    /// unless it is 0.
+    pub fn prefetch_range_cf(
+        &self,
+        cf: &CFHandle,
+        start_key: Option<&[u8]>,
+        end_key: Option<&[u8]>,
+        readahead_size: usize,
+        budget_bytes: u64,
+    ) -> RangePrefetch<'_> {
+        unsafe {
+            let (start, s_len) = start_key.map_or((ptr::null(), 0), |k| (k.as_ptr(), k.len()));
+            let (end, e_len) = end_key.map_or((ptr::null(), 0), |k| (k.as_ptr(), k.len()));
+            RangePrefetch {
+                inner: crocksdb_ffi::crocksdb_range_prefetch_start(
+                    self.inner,
+                    cf.inner,
+                    start,
+                    s_len,
+                    end,
+                    e_len,
+                    readahead_size,
+                    budget_bytes,
+                ),
+                _db: PhantomData,
+            }
+        }
+    }
+
+    /// Returns the flushes and compactions running at the time of the call.
+    /// Requires `DBOptions::enable_thread_tracking`.
+    pub fn background_jobs(&self) -> Result<Vec<BackgroundJob>, String> {
+        unsafe {
+            let jobs = ffi_try!(crocksdb_get_background_jobs(self.inner));
+            let n = crocksdb_ffi::crocksdb_background_jobs_count(jobs);
+            let mut res = Vec::with_capacity(n);
+            for i in 0..n {
+                let mut job = MaybeUninit::uninit();
+                crocksdb_ffi::crocksdb_background_jobs_get(jobs, i, job.as_mut_ptr());
+                let mut len = 0;
+                let name = crocksdb_ffi::crocksdb_background_jobs_cf_name(jobs, i, &mut len);
+                let name = slice::from_raw_parts(name as *const u8, len);
+                res.push(BackgroundJob {
+                    cf_name: String::from_utf8_lossy(name).into_owned(),
+                    job: job.assume_init(),
+                });
+            }
+            crocksdb_ffi::crocksdb_background_jobs_destroy(jobs);
+            Ok(res)
+        }
+    }
+
+    /// Writes the queries of this DB to the file at `path` until
+    /// `end_trace` is called.
+    pub fn start_trace<P: AsRef<Path>>(&self, path: P, opts: &TraceOptions) -> Result<(), String> {
+        let path = CString::new(path.as_ref().to_str().unwrap()).unwrap();
+        unsafe {
+            ffi_try!(crocksdb_start_trace(self.inner, path.as_ptr(), opts.inner));
+        }
+        Ok(())
+    }
+
+    pub fn end_trace(&self) -> Result<(), String> {
+        unsafe {
+            ffi_try!(crocksdb_end_trace(self.inner));
+        }
+        Ok(())
+    }
+
+    /// Writes the block cache accesses of this DB to the file at `path` until
+    /// `end_block_cache_trace` is called.
+    pub fn start_block_cache_trace<P: AsRef<Path>>(
+        &self,
+        path: P,
+        opts: &TraceOptions,
+    ) -> Result<(), String> {
+        let path = CString::new(path.as_ref().to_str().unwrap()).unwrap();
+        unsafe {
+            ffi_try!(crocksdb_start_block_cache_trace(
+                self.inner,
+                path.as_ptr(),
+                opts.inner
+            ));
+        }
+        Ok(())
+    }
+
+    pub fn end_block_cache_trace(&self) -> Result<(), String> {
+        unsafe {
+            ffi_try!(crocksdb_end_block_cache_trace(self.inner));
+        }
+        Ok(())
+    }
+
+    /// Writes the file IOs of this DB to the file at `path` until
+    /// `end_io_trace` is called.
+    pub fn start_io_trace<P: AsRef<Path>>(
+        &self,
+        path: P,
+        opts: &TraceOptions,
+    ) -> Result<(), String> {
+        let path = CString::new(path.as_ref().to_str().unwrap()).unwrap();
+        unsafe {
+            ffi_try!(crocksdb_start_io_trace(
+                self.inner,
+                path.as_ptr(),
+                opts.inner
+            ));
+        }
+        Ok(())
+    }
+
+    pub fn end_io_trace(&self) -> Result<(), String> {
+        unsafe {
+            ffi_try!(crocksdb_end_io_trace(self.inner));
+        }
+        Ok(())
+    }
+
+    /// Re-runs the query trace at `path` against this DB on `num_threads`
+    /// threads, `speedup` times faster than it was recorded. The DB must have
+    /// every column family of the trace open.
+    pub fn replay_trace<P: AsRef<Path>>(
+        &self,
+        path: P,
+        num_threads: u32,
+        speedup: f64,
+    ) -> Result<TraceReplayReport, String> {
+        let path = CString::new(path.as_ref().to_str().unwrap()).unwrap();
+        let handles: Vec<*mut DBCFHandle> = self
+            .cfs
+            .iter()
+            .filter_map(|h| h.as_ref().map(|h| h.1.inner))
+            .collect();
+        let mut report = TraceReplayReport {
+            latencies: [DBOpLatency::default(); TRACED_OP_COUNT],
+            errors: 0,
+        };
+        unsafe {
+            ffi_try!(crocksdb_replay_trace(
+                self.inner,
+                handles.as_ptr(),
+                handles.len(),
+                path.as_ptr(),
+                num_threads,
+                speedup,
+                report.latencies.as_mut_ptr(),
+                &mut report.errors
+            ));
+        }
+        Ok(report)
+    }
+
     pub fn compact_range(&self, start_key: Option<&[u8]>, end_key: Option<&[u8]>) {
         unsafe {
             let (start, s_len) = start_key.map_or((ptr::null(), 0), |k| (k.as_ptr(), k.len()));
@@ -2065,6 +2473,125 @@ impl DB {
         }
     }
 
+    /// Returns the total filter size of the live files at each of the first
+    /// `num_levels` levels.
+    pub fn get_filter_size_per_level_cf(
+        &self,
+        cf: &CFHandle,
+        num_levels: usize,
+    ) -> Result<Vec<u64>, String> {
+        let mut sizes = vec![0; num_levels];
+        unsafe {
+            ffi_try!(crocksdb_get_filter_size_per_level_cf(
+                self.inner,
+                cf.inner,
+                sizes.as_mut_ptr(),
+                num_levels
+            ));
+        }
+        Ok(sizes)
+    }
+
+    /// Returns the approximate size, number of keys and middle key of
+    /// `range`, using the samples of the collector added with
+    /// `ColumnFamilyOptions::add_range_properties_collector`.
+    pub fn get_range_properties_cf(
+        &self,
+        cf: &CFHandle,
+        range: Range,
+    ) -> Result<RangeProperties, String> {
+        let mut props = RangeProperties::default();
+        let mut middle_key = ptr::null_mut();
+        let mut middle_key_len = 0;
+        unsafe {
+            ffi_try!(crocksdb_get_range_properties_cf(
+                self.inner,
+                cf.inner,
+                range.start_key.as_ptr(),
+                range.start_key.len(),
+                range.end_key.as_ptr(),
+                range.end_key.len(),
+                &mut props.size,
+                &mut props.num_keys,
+                &mut middle_key,
+                &mut middle_key_len
+            ));
+            if !middle_key.is_null() {
+                let key = slice::from_raw_parts(middle_key as *const u8, middle_key_len);
+                props.middle_key = Some(key.to_vec());
+                libc::free(middle_key as *mut c_void);
+            }
+        }
+        Ok(props)
+    }
+
+    /// Returns up to `num_keys` keys splitting `range` into parts of even size.
+    /// Only the index blocks of the SST files overlapping `range` are read.
+    pub fn get_split_keys_cf(
+        &self,
+        cf: &CFHandle,
+        range: Range,
+        num_keys: usize,
+    ) -> Result<SplitKeys, String> {
+        unsafe {
+            let raw = ffi_try!(crocksdb_get_split_keys_cf(
+                self.inner,
+                cf.inner,
+                range.start_key.as_ptr(),
+                range.start_key.len(),
+                range.end_key.as_ptr(),
+                range.end_key.len(),
+                num_keys
+            ));
+            let count = crocksdb_ffi::crocksdb_split_keys_count(raw);
+            let mut keys = Vec::with_capacity(count);
+            for i in 0..count {
+                let mut klen = 0;
+                let key = crocksdb_ffi::crocksdb_split_keys_key(raw, i, &mut klen);
+                keys.push(slice::from_raw_parts(key, klen).to_vec());
+            }
+            let res = SplitKeys {
+                keys,
+                sst_size: crocksdb_ffi::crocksdb_split_keys_sst_size(raw),
+                memtable_size: crocksdb_ffi::crocksdb_split_keys_memtable_size(raw),
+            };
+            crocksdb_ffi::crocksdb_split_keys_destroy(raw);
+            Ok(res)
+        }
+    }
+
+    /// Sums up the numeric user properties `props` over the SST files
+    /// overlapping `range`, using the decoded properties held by `cache`.
+    pub fn aggregate_table_properties_cf(
+        &self,
+        cache: &TablePropertiesCache,
+        cf: &CFHandle,
+        range: Range,
+        props: &[(&[u8], DBPropertyEncoding)],
+    ) -> Result<Vec<u64>, String> {
+        let names: Vec<*const u8> = props.iter().map(|p| p.0.as_ptr()).collect();
+        let name_lens: Vec<usize> = props.iter().map(|p| p.0.len()).collect();
+        let encodings: Vec<DBPropertyEncoding> = props.iter().map(|p| p.1).collect();
+        let mut sums = vec![0; props.len()];
+        unsafe {
+            ffi_try!(crocksdb_table_properties_cache_aggregate(
+                cache.inner,
+                self.inner,
+                cf.inner,
+                range.start_key.as_ptr(),
+                range.start_key.len(),
+                range.end_key.as_ptr(),
+                range.end_key.len(),
+                names.as_ptr(),
+                name_lens.as_ptr(),
+                encodings.as_ptr(),
+                props.len(),
+                sums.as_mut_ptr()
+            ));
+        }
+        Ok(sums)
+    }
+
     pub fn get_all_key_versions(
         &self,
         start_key: &[u8],
@@ -2202,6 +2729,63 @@ impl Drop for DB {
     }
 }
 
+impl WriteBatch {
+    pub fn put_cf_with_ts(
+        &self,
+        cf: &CFHandle,
+        key: &[u8],
+        ts: &[u8],
+        value: &[u8],
+    ) -> Result<(), String> {
+        unsafe {
+            ffi_try!(crocksdb_writebatch_put_cf_with_ts(
+                self.inner,
+                cf.inner,
+                key.as_ptr(),
+                key.len() as size_t,
+                ts.as_ptr(),
+                ts.len() as size_t,
+                value.as_ptr(),
+                value.len() as size_t
+            ));
+            Ok(())
+        }
+    }
+
+    pub fn delete_cf_with_ts(&self, cf: &CFHandle, key: &[u8], ts: &[u8]) -> Result<(), String> {
+        unsafe {
+            ffi_try!(crocksdb_writebatch_delete_cf_with_ts(
+                self.inner,
+                cf.inner,
+                key.as_ptr(),
+                key.len() as size_t,
+                ts.as_ptr(),
+                ts.len() as size_t
+            ));
+            Ok(())
+        }
+    }
+
+    pub fn single_delete_cf_with_ts(
+        &self,
+        cf: &CFHandle,
+        key: &[u8],
+        ts: &[u8],
+    ) -> Result<(), String> {
+        unsafe {
+            ffi_try!(crocksdb_writebatch_single_delete_cf_with_ts(
+                self.inner,
+                cf.inner,
+                key.as_ptr(),
+                key.len() as size_t,
+                ts.as_ptr(),
+                ts.len() as size_t
+            ));
+            Ok(())
+        }
+    }
+}
+
 impl Writable for WriteBatch {
     fn put(&self, key: &[u8], value: &[u8]) -> Result<(), String> {
         unsafe {
@@ -2708,6 +3292,20 @@ pub fn supported_compression() -> Vec<DBCompressionType> {
     }
 }
 
+/// Whether file reads can be batched and issued asynchronously with io_uring.
+/// True if RocksDB was built with liburing (the `io_uring` feature, with
+/// liburing installed), the running kernel accepts io_uring, and it has not
+/// been turned off with `set_io_uring_enabled`.
+pub fn io_uring_supported() -> bool {
+    unsafe { crocksdb_ffi::crocksdb_io_uring_supported() != 0 }
+}
+
+/// Enables or disables io_uring for the whole process. It is enabled by
+/// default when supported.
+pub fn set_io_uring_enabled(enabled: bool) {
+    unsafe { crocksdb_ffi::crocksdb_set_io_uring_enabled(enabled as u8) }
+}
+
 pub struct Env {
     pub(crate) inner: *mut DBEnv,
     #[allow(dead_code)]
@@ -2774,10 +3372,20 @@ impl Env {
         key_manager: T,
     ) -> Result<Env, String> {
         let db_key_manager = DBEncryptionKeyManager::new(key_manager);
+        Env::new_key_managed_encrypted_env_with_manager(base_env, &db_key_manager)
+    }
+
+    // Create an encrypted env sharing a key manager the caller keeps, e.g. to
+    // read the stats of its cache.
+    #[cfg(feature = "encryption")]
+    pub fn new_key_managed_encrypted_env_with_manager(
+        base_env: Arc<Env>,
+        key_manager: &DBEncryptionKeyManager,
+    ) -> Result<Env, String> {
         let env = unsafe {
             crocksdb_ffi::crocksdb_key_managed_encrypted_env_create(
                 base_env.inner,
-                db_key_manager.inner,
+                key_manager.inner,
             )
         };
         Ok(Env {
@@ -2803,6 +3411,24 @@ impl Env {
         })
     }
 
+    /// Creates an env whose file IO is throttled natively by `inspector`.
+    pub fn new_token_bucket_inspected_env(
+        base_env: Arc<Env>,
+        inspector: &TokenBucketInspector,
+    ) -> Result<Env, String> {
+        let db_file_system_inspector = DBFileSystemInspector::from_token_bucket(inspector);
+        let env = unsafe {
+            crocksdb_ffi::crocksdb_file_system_inspected_env_create(
+                base_env.inner,
+                db_file_system_inspector.inner,
+            )
+        };
+        Ok(Env {
+            inner: env,
+            base: Some(base_env),
+        })
+    }
+
     pub fn new_sequential_file(
         &self,
         path: &str,
@@ -3020,6 +3646,34 @@ impl Cache {
     }
 }
 
+impl Cache {
+    /// Writes the blocks of the tables of `db` held by the cache to the file
+    /// at `path`, so that they can be loaded into a `SecondaryCache` after a
+    /// restart. When `cfs` of `db` are given, only blocks of their live tables
+    /// are written.
+    pub fn dump<P: AsRef<Path>>(
+        &self,
+        path: P,
+        db: &DB,
+        cfs: &[&CFHandle],
+        opts: &CacheDumpOptions,
+    ) -> Result<(), String> {
+        let path = CString::new(path.as_ref().to_str().unwrap()).unwrap();
+        let handles: Vec<*mut DBCFHandle> = cfs.iter().map(|cf| cf.inner).collect();
+        unsafe {
+            ffi_try!(crocksdb_cache_dump(
+                self.inner,
+                db.inner,
+                handles.as_ptr(),
+                handles.len(),
+                path.as_ptr(),
+                opts.inner
+            ));
+        }
+        Ok(())
+    }
+}
+
 impl Drop for Cache {
     fn drop(&mut self) {
         unsafe {
@@ -3028,6 +3682,264 @@ impl Drop for Cache {
     }
 }
 
+/// Requests made to a `SecondaryCache` since it was created. Blocks the tier
+/// evicts by itself to stay within capacity are not counted.
+#[derive(Clone, Copy, Debug, Default, PartialEq)]
+pub struct SecondaryCacheCounters {
+    /// Blocks inserted on eviction from a block cache.
+    pub inserts: u64,
+    /// Blocks inserted by `SecondaryCache::load`.
+    pub saved_inserts: u64,
+    pub rejected_inserts: u64,
+    pub lookups: u64,
+    pub hits: u64,
+}
+
+/// A second cache tier holding blocks evicted from a block cache. Hits are
+/// counted by the `SecondaryCache*` and `CompressedSecondaryCache*` tickers,
+/// and per tier by `counters`.
+pub struct SecondaryCache {
+    pub(crate) inner: *mut DBSecondaryCache,
+}
+
+unsafe impl Sync for SecondaryCache {}
+unsafe impl Send for SecondaryCache {}
+
+impl SecondaryCache {
+    /// Keeps blocks compressed with `compression_type`.
+    pub fn new_compressed(
+        capacity: usize,
+        num_shard_bits: c_int,
+        compression_type: DBCompressionType,
+    ) -> SecondaryCache {
+        unsafe {
+            SecondaryCache {
+                inner: crocksdb_ffi::crocksdb_compressed_secondary_cache_create(
+                    capacity,
+                    num_shard_bits,
+                    compression_type,
+                ),
+            }
+        }
+    }
+
+    pub fn set_capacity(&self, capacity: usize) -> Result<(), String> {
+        unsafe {
+            ffi_try!(crocksdb_secondary_cache_set_capacity(self.inner, capacity));
+        }
+        Ok(())
+    }
+
+    pub fn capacity(&self) -> Result<usize, String> {
+        unsafe { Ok(ffi_try!(crocksdb_secondary_cache_get_capacity(self.inner))) }
+    }
+
+    pub fn counters(&self) -> SecondaryCacheCounters {
+        let mut c = SecondaryCacheCounters::default();
+        unsafe {
+            crocksdb_ffi::crocksdb_secondary_cache_counters(
+                self.inner,
+                &mut c.inserts,
+                &mut c.saved_inserts,
+                &mut c.rejected_inserts,
+                &mut c.lookups,
+                &mut c.hits,
+            );
+        }
+        c
+    }
+
+    /// Reads blocks written by `Cache::dump`. Block caches using this tier
+    /// find them on a miss, whether the DB is reopened before or after the
+    /// load. `cfs` of `db` filter the blocks as when dumping.
+    pub fn load<P: AsRef<Path>>(
+        &self,
+        path: P,
+        table_opts: &BlockBasedOptions,
+        db: Option<&DB>,
+        cfs: &[&CFHandle],
+        opts: &CacheDumpOptions,
+    ) -> Result<(), String> {
+        let path = CString::new(path.as_ref().to_str().unwrap()).unwrap();
+        let db = db.map_or(ptr::null_mut(), |db| db.inner);
+        let handles: Vec<*mut DBCFHandle> = cfs.iter().map(|cf| cf.inner).collect();
+        unsafe {
+            ffi_try!(crocksdb_cache_load(
+                self.inner,
+                table_opts.inner,
+                db,
+                handles.as_ptr(),
+                handles.len(),
+                path.as_ptr(),
+                opts.inner
+            ));
+        }
+        Ok(())
+    }
+}
+
+impl Drop for SecondaryCache {
+    fn drop(&mut self) {
+        unsafe {
+            crocksdb_ffi::crocksdb_secondary_cache_destroy(self.inner);
+        }
+    }
+}
+
+#[derive(Clone, Copy, Debug, Default, PartialEq)]
+pub struct RangePrefetchProgress {
+    /// Bytes read from files so far.
+    pub bytes_read: u64,
+    pub keys: u64,
+    pub done: bool,
+}
+
+/// A prefetch started by `DB::prefetch_range_cf`. Dropping it cancels the
+/// prefetch.
+pub struct RangePrefetch<'a> {
+    inner: *mut DBRangePrefetch,
+    _db: PhantomData<&'a DB>,
+}
+
+unsafe impl<'a> Send for RangePrefetch<'a> {}
+unsafe impl<'a> Sync for RangePrefetch<'a> {}
+
+impl<'a> RangePrefetch<'a> {
+    pub fn progress(&self) -> RangePrefetchProgress {
+        let mut progress = RangePrefetchProgress::default();
+        let mut done = 0;
+        unsafe {
+            crocksdb_ffi::crocksdb_range_prefetch_progress(
+                self.inner,
+                &mut progress.bytes_read,
+                &mut progress.keys,
+                &mut done,
+            );
+        }
+        progress.done = done != 0;
+        progress
+    }
+
+    pub fn cancel(&self) {
+        unsafe {
+            crocksdb_ffi::crocksdb_range_prefetch_cancel(self.inner);
+        }
+    }
+
+    /// Waits for the prefetch to finish.
+    pub fn wait(self) -> Result<RangePrefetchProgress, String> {
+        unsafe {
+            ffi_try!(crocksdb_range_prefetch_wait(self.inner));
+        }
+        Ok(self.progress())
+    }
+}
+
+impl<'a> Drop for RangePrefetch<'a> {
+    fn drop(&mut self) {
+        unsafe {
+            crocksdb_ffi::crocksdb_range_prefetch_destroy(self.inner);
+        }
+    }
+}
+
+/// A flush or compaction returned by `DB::background_jobs`.
+#[derive(Clone, Debug)]
+pub struct BackgroundJob {
+    pub cf_name: String,
+    pub job: DBBackgroundJob,
+}
+
+/// Latencies of the queries re-run by `DB::replay_trace`.
+#[derive(Clone, Debug)]
+pub struct TraceReplayReport {
+    /// Indexed by `DBTracedOp`. Seeks backwards count as seeks.
+    pub latencies: [DBOpLatency; TRACED_OP_COUNT],
+    /// Queries that failed.
+    pub errors: u64,
+}
+
+impl TraceReplayReport {
+    pub fn latency(&self, op: DBTracedOp) -> &DBOpLatency {
+        &self.latencies[op as usize]
+    }
+}
+
+fn duration_as_micros(d: Duration) -> u64 {
+    d.as_secs()
+        .saturating_mul(1_000_000)
+        .saturating_add(u64::from(d.subsec_micros()))
+}
+
+/// Breaks down what occupies a block cache by entry role and by column
+/// family. The cache is walked on a background thread, so reading a snapshot
+/// is cheap unless it is older than the requested bound.
+pub struct CacheUsageMonitor {
+    inner: *mut DBCacheUsageMonitor,
+}
+
+unsafe impl Sync for CacheUsageMonitor {}
+unsafe impl Send for CacheUsageMonitor {}
+
+impl CacheUsageMonitor {
+    /// Walks `cache` every `refresh_interval`, or only on demand when it is
+    /// zero.
+    pub fn new(cache: &Cache, refresh_interval: Duration) -> CacheUsageMonitor {
+        unsafe {
+            CacheUsageMonitor {
+                inner: crocksdb_ffi::crocksdb_cache_usage_monitor_create(
+                    cache.inner,
+                    duration_as_micros(refresh_interval),
+                ),
+            }
+        }
+    }
+
+    /// Usage of the whole cache, walked at most `max_age` ago.
+    pub fn usage(&self, max_age: Duration) -> DBCacheUsage {
+        let mut usage = DBCacheUsage::default();
+        unsafe {
+            crocksdb_ffi::crocksdb_cache_usage_monitor_get(
+                self.inner,
+                duration_as_micros(max_age),
+                &mut usage,
+            );
+        }
+        usage
+    }
+
+    /// Table blocks of the live files of each of `cfs`, walked at most
+    /// `max_age` ago.
+    pub fn cf_usage(
+        &self,
+        db: &DB,
+        cfs: &[&CFHandle],
+        max_age: Duration,
+    ) -> Result<Vec<DBCacheRoleUsage>, String> {
+        let handles: Vec<*mut DBCFHandle> = cfs.iter().map(|cf| cf.inner).collect();
+        let mut usage = vec![DBCacheRoleUsage::default(); cfs.len()];
+        unsafe {
+            ffi_try!(crocksdb_cache_usage_monitor_get_cf(
+                self.inner,
+                db.inner,
+                handles.as_ptr(),
+                handles.len(),
+                duration_as_micros(max_age),
+                usage.as_mut_ptr()
+            ));
+        }
+        Ok(usage)
+    }
+}
+
+impl Drop for CacheUsageMonitor {
+    fn drop(&mut self) {
+        unsafe {
+            crocksdb_ffi::crocksdb_cache_usage_monitor_destroy(self.inner);
+        }
+    }
+}
+
 pub struct MemoryAllocator {
     pub(crate) inner: *mut DBMemoryAllocator,
 }
@@ -19,28 +19,34 @@ use compaction_filter::{
 };
 use comparator::{self, compare_callback, ComparatorCallback};
 use crocksdb_ffi::{
-    self, ChecksumType, DBBlockBasedTableOptions, DBBottommostLevelCompaction, DBCompactOptions,
-    DBCompactionOptions, DBCompressionType, DBConcurrentTaskLimiter, DBFifoCompactionOptions,
-    DBFlushOptions, DBHyperClockCacheOptions, DBInfoLogLevel, DBInstance, DBLRUCacheOptions,
+    self, ChecksumType, DBBlockBasedTableOptions, DBBottommostLevelCompaction, DBCacheDumpOptions,
+    DBCacheEntryRole, DBCompactOptions, DBCompactionOptions, DBCompressionType,
+    DBConcurrentTaskLimiter, DBFifoCompactionOptions, DBFilterStats, DBFlushOptions,
+    DBHyperClockCacheOptions, DBInfoLogLevel, DBInstance, DBLRUCacheOptions, DBLevelFilterType,
     DBRateLimiter, DBRateLimiterMode, DBReadOptions, DBRecoveryMode, DBRestoreOptions, DBSnapshot,
-    DBStatistics, DBStatisticsHistogramType, DBStatisticsTickerType, DBTitanDBOptions,
-    DBTitanReadOptions, DBWriteBufferManager, DBWriteOptions, IndexType, Options,
-    PrepopulateBlockCache,
+    DBStatistics, DBStatisticsHistogramType, DBStatisticsTickerType, DBTimestampEncoding,
+    DBTitanDBOptions, DBTitanReadOptions, DBTraceFilter, DBTraceOptions, DBWriteBufferManager,
+    DBWriteOptions, IndexType, Options, PrepopulateBlockCache,
 };
-use event_listener::{new_event_listener, EventListener};
+use event_listener::{new_event_listener, EventListener, EventRing, FileIoStats};
 use libc::{self, c_double, c_int, c_uchar, c_void, size_t};
 use logger::{new_logger, Logger};
 use merge_operator::MergeFn;
 use merge_operator::{self, full_merge_callback, partial_merge_callback, MergeOperatorCallback};
-use rocksdb::{Cache, Env, MemoryAllocator};
-use slice_transform::{new_slice_transform, SliceTransform};
-use sst_partitioner::{new_sst_partitioner_factory, SstPartitionerFactory};
+use rocksdb::{Cache, Env, MemoryAllocator, SecondaryCache};
+use slice_transform::{
+    new_builtin_slice_transform, new_slice_transform, BuiltinSliceTransform, SliceTransform,
+};
+use sst_partitioner::{
+    new_sst_partitioner_factory, SstPartitionerBoundaries, SstPartitionerFactory,
+};
 use std::ffi::{CStr, CString};
 use std::path::Path;
 use std::ptr;
 use std::sync::Arc;
 use std::time::{SystemTime, UNIX_EPOCH};
 use table_filter::{destroy_table_filter, table_filter, TableFilter};
+use table_properties::TablePropertiesCache;
 use table_properties_collector_factory::{
     new_table_properties_collector_factory, TablePropertiesCollectorFactory,
 };
@@ -58,7 +64,7 @@ pub struct HistogramData {
 }
 
 pub struct BlockBasedOptions {
-    inner: *mut DBBlockBasedTableOptions,
+    pub(crate) inner: *mut DBBlockBasedTableOptions,
 }
 
 impl Drop for BlockBasedOptions {
@@ -137,6 +143,43 @@ impl BlockBasedOptions {
         }
     }
 
+    /// Chooses the filter of a file by the level it is written to. `levels[i]`
+    /// configures level i, and the last entry also covers deeper levels and
+    /// ingested files. If `skip_bottommost` is set, filters are not built
+    /// for files compacted into the bottommost level; ingested files still
+    /// get the last entry's filter.
+    ///
+    /// The filter is chosen when a file is written, so files moved to
+    /// another level without being rewritten (trivial moves) keep theirs,
+    /// including files moved into the bottommost level.
+    pub fn set_level_filter_policy(
+        &mut self,
+        levels: &[LevelFilter],
+        skip_bottommost: bool,
+        stats: Option<&FilterStats>,
+    ) {
+        assert!(!levels.is_empty());
+        let types: Vec<DBLevelFilterType> = levels.iter().map(|l| l.filter_type()).collect();
+        let bits: Vec<f64> = levels
+            .iter()
+            .map(|l| match *l {
+                LevelFilter::None => 0.0,
+                LevelFilter::Bloom(bits) | LevelFilter::Ribbon(bits) => bits,
+            })
+            .collect();
+        let stats = stats.map_or(ptr::null_mut(), |s| s.inner);
+        unsafe {
+            let filter = crocksdb_ffi::crocksdb_filterpolicy_create_level_aware(
+                types.as_ptr(),
+                bits.as_ptr(),
+                levels.len(),
+                skip_bottommost,
+                stats,
+            );
+            crocksdb_ffi::crocksdb_block_based_options_set_filter_policy(self.inner, filter);
+        }
+    }
+
     pub fn set_optimize_filters_for_memory(&mut self, v: bool) {
         unsafe {
             crocksdb_ffi::crocksdb_block_based_options_set_optimize_filters_for_memory(
@@ -327,6 +370,29 @@ impl Drop for RateLimiter {
     }
 }
 
+/// All tickers and histograms of a `Statistics`, indexed by their type.
+#[derive(Clone, Debug, Default)]
+pub struct StatisticsExport {
+    pub tickers: Vec<u64>,
+    pub histograms: Vec<DBHistogramSummary>,
+}
+
+impl StatisticsExport {
+    pub fn ticker(&self, ticker_type: DBStatisticsTickerType) -> u64 {
+        self.tickers
+            .get(ticker_type as usize)
+            .copied()
+            .unwrap_or_default()
+    }
+
+    pub fn histogram(&self, hist_type: DBStatisticsHistogramType) -> DBHistogramSummary {
+        self.histograms
+            .get(hist_type as usize)
+            .copied()
+            .unwrap_or_default()
+    }
+}
+
 pub struct Statistics {
     pub(crate) inner: *mut DBStatistics,
 }
@@ -409,6 +475,33 @@ impl Statistics {
         }
     }
 
+    /// Reads all tickers and histograms in one call, resetting them if
+    /// `reset` is set. Histograms can only be reset together with all
+    /// tickers, so with `reset` any ticker or histogram update recorded
+    /// between its read and the final reset is lost; use
+    /// `get_and_reset_ticker_count` where tickers must be exact. `p999` is
+    /// parsed from `get_histogram_string` and is 0 if it is missing there.
+    pub fn export(&self, reset: bool) -> StatisticsExport {
+        unsafe {
+            let num_tickers = crocksdb_ffi::crocksdb_statistics_num_tickers(self.inner) as usize;
+            let num_histograms =
+                crocksdb_ffi::crocksdb_statistics_num_histograms(self.inner) as usize;
+            let mut export = StatisticsExport {
+                tickers: vec![0; num_tickers],
+                histograms: vec![DBHistogramSummary::default(); num_histograms],
+            };
+            crocksdb_ffi::crocksdb_statistics_export(
+                self.inner,
+                export.tickers.as_mut_ptr(),
+                num_tickers,
+                export.histograms.as_mut_ptr(),
+                num_histograms,
+                reset,
+            );
+            export
+        }
+    }
+
     pub fn get_histogram(&self, hist_type: DBStatisticsHistogramType) -> Option<HistogramData> {
         unsafe {
             let mut data = HistogramData::default();
@@ -438,6 +531,74 @@ impl Drop for Statistics {
     }
 }
 
+/// Filter configuration of a single level, see
+/// `BlockBasedOptions::set_level_filter_policy`. It applies to files written
+/// to that level; a trivially moved file keeps the filter it was built with,
+/// and `skip_bottommost` does not strip it.
+#[derive(Clone, Copy, Debug, PartialEq)]
+pub enum LevelFilter {
+    None,
+    Bloom(f64),
+    Ribbon(f64),
+}
+
+impl LevelFilter {
+    fn filter_type(&self) -> DBLevelFilterType {
+        match *self {
+            LevelFilter::None => DBLevelFilterType::None,
+            LevelFilter::Bloom(_) => DBLevelFilterType::Bloom,
+            LevelFilter::Ribbon(_) => DBLevelFilterType::Ribbon,
+        }
+    }
+}
+
+/// Probe counters of a level filter policy, grouped by filter type.
+pub struct FilterStats {
+    pub(crate) inner: *mut DBFilterStats,
+}
+
+unsafe impl Send for FilterStats {}
+unsafe impl Sync for FilterStats {}
+
+impl FilterStats {
+    pub fn new() -> Self {
+        unsafe {
+            Self {
+                inner: crocksdb_ffi::crocksdb_filter_stats_create(),
+            }
+        }
+    }
+
+    /// Number of keys checked against filters of the type.
+    pub fn probes(&self, filter_type: DBLevelFilterType) -> u64 {
+        unsafe { crocksdb_ffi::crocksdb_filter_stats_probes(self.inner, filter_type) }
+    }
+
+    /// Number of probes that ruled a key out and saved a data block read.
+    pub fn useful(&self, filter_type: DBLevelFilterType) -> u64 {
+        unsafe { crocksdb_ffi::crocksdb_filter_stats_useful(self.inner, filter_type) }
+    }
+
+    /// Total size of the filters of the type currently loaded.
+    pub fn resident_bytes(&self, filter_type: DBLevelFilterType) -> u64 {
+        unsafe { crocksdb_ffi::crocksdb_filter_stats_resident_bytes(self.inner, filter_type) }
+    }
+}
+
+impl Default for FilterStats {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+impl Drop for FilterStats {
+    fn drop(&mut self) {
+        unsafe {
+            crocksdb_ffi::crocksdb_filter_stats_destroy(self.inner);
+        }
+    }
+}
+
 pub struct WriteBufferManager {
     pub(crate) inner: *mut DBWriteBufferManager,
 }
@@ -549,6 +710,8 @@ pub struct ReadOptions {
     inner: *mut DBReadOptions,
     lower_bound: Vec<u8>,
     upper_bound: Vec<u8>,
+    timestamp: Vec<u8>,
+    iter_start_ts: Vec<u8>,
     titan_inner: *mut DBTitanReadOptions,
 }
 
@@ -572,6 +735,8 @@ impl Default for ReadOptions {
                 inner: opts,
                 lower_bound: vec![],
                 upper_bound: vec![],
+                timestamp: vec![],
+                iter_start_ts: vec![],
                 titan_inner: ptr::null_mut::<DBTitanReadOptions>(),
             }
         }
@@ -612,6 +777,20 @@ impl ReadOptions {
         }
     }
 
+    /// Lets iterators prefetch with asynchronous reads, which run in parallel
+    /// when `io_uring_supported()` is true.
+    pub fn set_async_io(&mut self, v: bool) {
+        unsafe {
+            crocksdb_ffi::crocksdb_readoptions_set_async_io(self.inner, v);
+        }
+    }
+
+    pub fn set_optimize_multiget_for_io(&mut self, v: bool) {
+        unsafe {
+            crocksdb_ffi::crocksdb_readoptions_set_optimize_multiget_for_io(self.inner, v);
+        }
+    }
+
     pub unsafe fn set_snapshot(&mut self, snapshot: &UnsafeSnap) {
         crocksdb_ffi::crocksdb_readoptions_set_snapshot(self.inner, snapshot.inner);
     }
@@ -646,6 +825,35 @@ impl ReadOptions {
         &self.upper_bound
     }
 
+    /// Reads see only versions with a user-defined timestamp not newer than `ts`.
+    /// Required when the column family enables user-defined timestamps.
+    pub fn set_timestamp(&mut self, ts: Vec<u8>) {
+        self.timestamp = ts;
+        unsafe {
+            crocksdb_ffi::crocksdb_readoptions_set_timestamp(
+                self.inner,
+                self.timestamp.as_ptr(),
+                self.timestamp.len(),
+            );
+        }
+    }
+
+    /// Makes iterators return every version with a timestamp in
+    /// `[iter_start_ts, timestamp]` instead of only the newest one.
+    ///
+    /// In this mode `DBIterator::key` returns internal keys: the user key,
+    /// then the timestamp, then the 8-byte sequence number and value type.
+    pub fn set_iter_start_ts(&mut self, ts: Vec<u8>) {
+        self.iter_start_ts = ts;
+        unsafe {
+            crocksdb_ffi::crocksdb_readoptions_set_iter_start_ts(
+                self.inner,
+                self.iter_start_ts.as_ptr(),
+                self.iter_start_ts.len(),
+            );
+        }
+    }
+
     pub fn set_read_tier(&mut self, tier: c_int) {
         unsafe {
             crocksdb_ffi::crocksdb_readoptions_set_read_tier(self.inner, tier);
@@ -997,6 +1205,25 @@ impl DBOptions {
         unsafe { crocksdb_ffi::crocksdb_options_add_eventlistener(self.inner, handle) }
     }
 
+    /// Records flush, compaction, ingestion, write stall and background error
+    /// events into `ring`.
+    pub fn add_event_ring(&mut self, ring: &EventRing) {
+        unsafe { crocksdb_ffi::crocksdb_options_add_event_ring(self.inner, ring.inner) }
+    }
+
+    /// Aggregates the latency of file reads, writes and syncs into `stats`.
+    pub fn add_file_io_stats(&mut self, stats: &FileIoStats) {
+        unsafe { crocksdb_ffi::crocksdb_options_add_file_io_stats(self.inner, stats.inner) }
+    }
+
+    /// Keeps `cache` up to date with the tables of the DB opened with these
+    /// options. A cache must not be shared by several DBs.
+    pub fn add_table_properties_cache(&mut self, cache: &TablePropertiesCache) {
+        unsafe {
+            crocksdb_ffi::crocksdb_options_add_table_properties_cache(self.inner, cache.inner);
+        }
+    }
+
     pub fn create_if_missing(&mut self, create_if_missing: bool) {
         unsafe {
             crocksdb_ffi::crocksdb_options_set_create_if_missing(self.inner, create_if_missing);
@@ -1283,6 +1510,14 @@ impl DBOptions {
         }
     }
 
+    /// Tracks the progress of flushes and compactions for
+    /// `DB::background_jobs`.
+    pub fn enable_thread_tracking(&self, v: bool) {
+        unsafe {
+            crocksdb_ffi::crocksdb_options_set_enable_thread_tracking(self.inner, v);
+        }
+    }
+
     pub fn enable_multi_batch_write(&self, v: bool) {
         unsafe {
             crocksdb_ffi::crocksdb_options_set_enable_multi_batch_write(self.inner, v);
@@ -1581,6 +1816,40 @@ impl ColumnFamilyOptions {
         }
     }
 
+    /// Adds a native collector of MVCC statistics, readable with
+    /// `UserCollectedProperties::mvcc_properties`. Keys are expected to be a
+    /// user key followed by a `ts_size`-byte timestamp; a `user_key_len` of 0
+    /// means the user key spans up to the timestamp.
+    pub fn add_mvcc_properties_collector(
+        &mut self,
+        user_key_len: usize,
+        ts_size: usize,
+        ts_encoding: DBTimestampEncoding,
+    ) {
+        assert!(ts_size <= 8);
+        unsafe {
+            let f = crocksdb_ffi::crocksdb_table_properties_collector_factory_create_mvcc(
+                user_key_len,
+                ts_size,
+                ts_encoding,
+            );
+            crocksdb_ffi::crocksdb_options_add_table_properties_collector_factory(self.inner, f);
+        }
+    }
+
+    /// Adds a native collector sampling the size and number of keys of tables
+    /// every `sample_bytes` bytes or `sample_keys` keys, for
+    /// `DB::get_range_properties_cf`.
+    pub fn add_range_properties_collector(&mut self, sample_bytes: u64, sample_keys: u64) {
+        unsafe {
+            let f = crocksdb_ffi::crocksdb_table_properties_collector_factory_create_range(
+                sample_bytes,
+                sample_keys,
+            );
+            crocksdb_ffi::crocksdb_options_add_table_properties_collector_factory(self.inner, f);
+        }
+    }
+
     pub fn compression(&mut self, t: DBCompressionType) {
         unsafe {
             crocksdb_ffi::crocksdb_options_set_compression(self.inner, t);
@@ -1698,6 +1967,27 @@ impl ColumnFamilyOptions {
         }
     }
 
+    /// Uses one of the comparators implemented in native code, selected by
+    /// its name. Unlike `add_comparator`, comparisons do not cross the FFI
+    /// boundary and index keys are shortened. See
+    /// `crocksdb_comparator_create_builtin` for the supported names.
+    pub fn set_builtin_comparator(&mut self, name: &str) -> Result<(), String> {
+        let c_name = CString::new(name).map_err(|e| format!("{:?}", e))?;
+        unsafe {
+            let cmp = ffi_try!(crocksdb_comparator_create_builtin(c_name.as_ptr()));
+            crocksdb_ffi::crocksdb_options_set_comparator(self.inner, cmp);
+        }
+        Ok(())
+    }
+
+    /// Whether user-defined timestamps are written to SST files. Only meaningful
+    /// with a timestamp-aware comparator.
+    pub fn set_persist_user_defined_timestamps(&mut self, v: bool) {
+        unsafe {
+            crocksdb_ffi::crocksdb_options_set_persist_user_defined_timestamps(self.inner, v);
+        }
+    }
+
     pub fn set_block_cache_size_mb(&mut self, cache_size: u64) {
         unsafe {
             crocksdb_ffi::crocksdb_options_optimize_for_point_lookup(self.inner, cache_size);
@@ -1951,6 +2241,14 @@ impl ColumnFamilyOptions {
         }
     }
 
+    /// Like `set_prefix_extractor`, but with a transform implemented in native code.
+    pub fn set_builtin_prefix_extractor(&mut self, transform: BuiltinSliceTransform) {
+        unsafe {
+            let transform = new_builtin_slice_transform(transform);
+            crocksdb_ffi::crocksdb_options_set_prefix_extractor(self.inner, transform);
+        }
+    }
+
     pub fn set_optimize_filters_for_hits(&mut self, v: bool) {
         unsafe {
             crocksdb_ffi::crocksdb_options_set_optimize_filters_for_hits(self.inner, v);
@@ -2067,6 +2365,24 @@ impl ColumnFamilyOptions {
         }
     }
 
+    /// Splits compaction outputs at `boundaries`, once an output file has at
+    /// least `min_output_file_size` bytes. Runs natively, without calling back
+    /// into Rust for each key.
+    pub fn set_boundary_sst_partitioner(
+        &mut self,
+        boundaries: &SstPartitionerBoundaries,
+        min_output_file_size: u64,
+    ) {
+        unsafe {
+            let f = crocksdb_ffi::crocksdb_sst_partitioner_factory_create_boundary(
+                boundaries.inner,
+                min_output_file_size,
+            );
+            crocksdb_ffi::crocksdb_options_set_sst_partitioner_factory(self.inner, f);
+            crocksdb_ffi::crocksdb_sst_partitioner_factory_destroy(f);
+        }
+    }
+
     pub fn set_compact_on_deletion(&self, sliding_window_size: usize, deletion_trigger: usize) {
         unsafe {
             crocksdb_ffi::crocksdb_options_set_compact_on_deletion(
@@ -2508,6 +2824,13 @@ impl LRUCacheOptions {
             );
         }
     }
+
+    /// Keeps blocks evicted from the cache in `cache`.
+    pub fn set_secondary_cache(&mut self, cache: &SecondaryCache) {
+        unsafe {
+            crocksdb_ffi::crocksdb_lru_cache_options_set_secondary_cache(self.inner, cache.inner);
+        }
+    }
 }
 
 impl Drop for LRUCacheOptions {
@@ -2534,6 +2857,16 @@ impl HyperClockCacheOptions {
         }
     }
 
+    /// Keeps blocks evicted from the cache in `cache`.
+    pub fn set_secondary_cache(&mut self, cache: &SecondaryCache) {
+        unsafe {
+            crocksdb_ffi::crocksdb_hyper_clock_cache_options_set_secondary_cache(
+                self.inner,
+                cache.inner,
+            );
+        }
+    }
+
     pub fn make_shared_cache(&self) -> Cache {
         unsafe {
             Cache {
@@ -2545,6 +2878,109 @@ impl HyperClockCacheOptions {
     }
 }
 
+/// Options of `Cache::dump` and `SecondaryCache::load`.
+pub struct CacheDumpOptions {
+    pub(crate) inner: *mut DBCacheDumpOptions,
+}
+
+impl CacheDumpOptions {
+    pub fn new() -> CacheDumpOptions {
+        unsafe {
+            CacheDumpOptions {
+                inner: crocksdb_ffi::crocksdb_cache_dump_options_create(),
+            }
+        }
+    }
+
+    /// Stops after `budget_bytes` of blocks. 0, the default, means no limit.
+    pub fn set_budget_bytes(&mut self, budget_bytes: u64) {
+        unsafe {
+            crocksdb_ffi::crocksdb_cache_dump_options_set_budget_bytes(self.inner, budget_bytes);
+        }
+    }
+
+    /// Only dumps entries of `roles`. Ignored when loading.
+    pub fn set_roles(&mut self, roles: &[DBCacheEntryRole]) {
+        let mask = roles.iter().fold(0, |mask, role| mask | 1 << *role as u32);
+        unsafe {
+            crocksdb_ffi::crocksdb_cache_dump_options_set_roles(self.inner, mask);
+        }
+    }
+
+    /// Throttles loading. Loaded blocks are charged whatever the mode of
+    /// the limiter.
+    pub fn set_rate_limiter(&mut self, limiter: &RateLimiter) {
+        unsafe {
+            crocksdb_ffi::crocksdb_cache_dump_options_set_rate_limiter(self.inner, limiter.inner);
+        }
+    }
+}
+
+impl Default for CacheDumpOptions {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+impl Drop for CacheDumpOptions {
+    fn drop(&mut self) {
+        unsafe {
+            crocksdb_ffi::crocksdb_cache_dump_options_destroy(self.inner);
+        }
+    }
+}
+
+/// Options of the query, block cache and IO traces started on a `DB`.
+pub struct TraceOptions {
+    pub(crate) inner: *mut DBTraceOptions,
+}
+
+impl TraceOptions {
+    pub fn new() -> TraceOptions {
+        unsafe {
+            TraceOptions {
+                inner: crocksdb_ffi::crocksdb_trace_options_create(),
+            }
+        }
+    }
+
+    /// Stops tracing once the trace file reaches `size` bytes.
+    pub fn set_max_trace_file_size(&mut self, size: u64) {
+        unsafe {
+            crocksdb_ffi::crocksdb_trace_options_set_max_trace_file_size(self.inner, size);
+        }
+    }
+
+    /// Traces one in every `frequency` requests.
+    pub fn set_sampling_frequency(&mut self, frequency: u64) {
+        unsafe {
+            crocksdb_ffi::crocksdb_trace_options_set_sampling_frequency(self.inner, frequency);
+        }
+    }
+
+    /// Leaves `queries` out of query traces.
+    pub fn set_filter(&mut self, queries: &[DBTraceFilter]) {
+        let mask = queries.iter().fold(0, |mask, q| mask | *q as u64);
+        unsafe {
+            crocksdb_ffi::crocksdb_trace_options_set_filter(self.inner, mask);
+        }
+    }
+}
+
+impl Default for TraceOptions {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+impl Drop for TraceOptions {
+    fn drop(&mut self) {
+        unsafe {
+            crocksdb_ffi::crocksdb_trace_options_destroy(self.inner);
+        }
+    }
+}
+
 pub struct MergeInstanceOptions {
     pub merge_memtable: bool,
     pub allow_source_write: bool,
@@ -13,7 +13,7 @@
 
 use crocksdb_ffi::{self, DBSliceTransform};
 use libc::{c_char, c_void, size_t};
-use std::ffi::CString;
+use std::ffi::{CStr, CString};
 use std::slice;
 
 // `SliceTransform` is a generic pluggable way of transforming one string
@@ -110,3 +110,105 @@ pub unsafe fn new_slice_transform<S: SliceTransform>(
     );
     Ok(transform)
 }
+
+/// Prefix extractors implemented in native code. Prefix bloom probes and
+/// memtable inserts never call back into Rust. Each variant has a stable name
+/// derived from its parameters, so existing SST files keep using their filters.
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+pub enum BuiltinSliceTransform {
+    /// The first `len` bytes; shorter keys are out of domain.
+    FixedPrefix(usize),
+    /// The first `len` bytes, or the whole key if it is shorter.
+    CappedPrefix(usize),
+    /// A `header_len`-byte header followed by up to `prefix_len` bytes. Keys
+    /// without a complete header are out of domain.
+    PrefixAfterHeader {
+        header_len: usize,
+        prefix_len: usize,
+    },
+    /// Everything up to and including the `count`-th `delimiter`.
+    DelimitedPrefix { delimiter: u8, count: usize },
+    /// A `header_len`-byte header followed by one memcomparable-encoded
+    /// bytes segment.
+    HeaderMemcomparablePrefix { header_len: usize },
+}
+
+impl BuiltinSliceTransform {
+    /// The name recorded in SST properties for this configuration.
+    pub fn name(&self) -> String {
+        let t = NativeSliceTransform::new(*self);
+        unsafe {
+            let name = crocksdb_ffi::crocksdb_slicetransform_name(t.0);
+            CStr::from_ptr(name).to_string_lossy().into_owned()
+        }
+    }
+
+    pub fn in_domain(&self, key: &[u8]) -> bool {
+        let t = NativeSliceTransform::new(*self);
+        unsafe {
+            crocksdb_ffi::crocksdb_slicetransform_in_domain(t.0, key.as_ptr(), key.len()) != 0
+        }
+    }
+
+    /// The prefix extracted from `key`, or `None` if it is out of domain.
+    pub fn transform<'a>(&self, key: &'a [u8]) -> Option<&'a [u8]> {
+        let t = NativeSliceTransform::new(*self);
+        let mut len: size_t = 0;
+        unsafe {
+            let prefix = crocksdb_ffi::crocksdb_slicetransform_transform(
+                t.0,
+                key.as_ptr(),
+                key.len(),
+                &mut len,
+            );
+            if prefix.is_null() {
+                return None;
+            }
+            // Built-in transforms return a sub-slice of the key.
+            let start = prefix.offset_from(key.as_ptr()) as usize;
+            Some(&key[start..start + len])
+        }
+    }
+}
+
+struct NativeSliceTransform(*mut DBSliceTransform);
+
+impl NativeSliceTransform {
+    fn new(t: BuiltinSliceTransform) -> NativeSliceTransform {
+        NativeSliceTransform(new_builtin_slice_transform(t))
+    }
+}
+
+impl Drop for NativeSliceTransform {
+    fn drop(&mut self) {
+        unsafe { crocksdb_ffi::crocksdb_slicetransform_destroy(self.0) }
+    }
+}
+
+pub fn new_builtin_slice_transform(t: BuiltinSliceTransform) -> *mut DBSliceTransform {
+    unsafe {
+        match t {
+            BuiltinSliceTransform::FixedPrefix(len) => {
+                crocksdb_ffi::crocksdb_slicetransform_create_fixed_prefix(len)
+            }
+            BuiltinSliceTransform::CappedPrefix(len) => {
+                crocksdb_ffi::crocksdb_slicetransform_create_capped_prefix(len)
+            }
+            BuiltinSliceTransform::PrefixAfterHeader {
+                header_len,
+                prefix_len,
+            } => crocksdb_ffi::crocksdb_slicetransform_create_prefix_after_header(
+                header_len, prefix_len,
+            ),
+            BuiltinSliceTransform::DelimitedPrefix { delimiter, count } => {
+                crocksdb_ffi::crocksdb_slicetransform_create_delimited_prefix(
+                    delimiter as c_char,
+                    count,
+                )
+            }
+            BuiltinSliceTransform::HeaderMemcomparablePrefix { header_len } => {
+                crocksdb_ffi::crocksdb_slicetransform_create_header_memcomparable_prefix(header_len)
+            }
+        }
+    }
+}
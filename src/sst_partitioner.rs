@@ -2,8 +2,8 @@
 
 use super::SstPartitionerResult;
 use crocksdb_ffi::{
-    self, DBSstPartitioner, DBSstPartitionerContext, DBSstPartitionerFactory,
-    DBSstPartitionerRequest,
+    self, DBSstPartitioner, DBSstPartitionerBoundaries, DBSstPartitionerContext,
+    DBSstPartitionerFactory, DBSstPartitionerRequest,
 };
 use libc::{c_char, c_uchar, c_void, size_t};
 use std::{ffi::CString, ptr, slice};
@@ -198,6 +198,63 @@ pub fn new_sst_partitioner_factory<F: SstPartitionerFactory>(
     }
 }
 
+/// Region boundaries for the built-in boundary partitioner, see
+/// `ColumnFamilyOptions::set_boundary_sst_partitioner`. The set can be
+/// replaced at any time; running compactions keep the set they started with.
+pub struct SstPartitionerBoundaries {
+    pub(crate) inner: *mut DBSstPartitionerBoundaries,
+}
+
+unsafe impl Send for SstPartitionerBoundaries {}
+unsafe impl Sync for SstPartitionerBoundaries {}
+
+impl SstPartitionerBoundaries {
+    pub fn new() -> SstPartitionerBoundaries {
+        unsafe {
+            SstPartitionerBoundaries {
+                inner: crocksdb_ffi::crocksdb_sst_partitioner_boundaries_create(),
+            }
+        }
+    }
+
+    /// Replaces the boundaries. Keys are compared bytewise and need not be
+    /// sorted.
+    pub fn set(&self, keys: &[&[u8]]) {
+        let ptrs: Vec<*const u8> = keys.iter().map(|k| k.as_ptr()).collect();
+        let lens: Vec<size_t> = keys.iter().map(|k| k.len()).collect();
+        unsafe {
+            crocksdb_ffi::crocksdb_sst_partitioner_boundaries_set(
+                self.inner,
+                ptrs.as_ptr(),
+                lens.as_ptr(),
+                keys.len(),
+            );
+        }
+    }
+
+    pub fn len(&self) -> usize {
+        unsafe { crocksdb_ffi::crocksdb_sst_partitioner_boundaries_len(self.inner) }
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.len() == 0
+    }
+}
+
+impl Default for SstPartitionerBoundaries {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+impl Drop for SstPartitionerBoundaries {
+    fn drop(&mut self) {
+        unsafe {
+            crocksdb_ffi::crocksdb_sst_partitioner_boundaries_destroy(self.inner);
+        }
+    }
+}
+
 #[cfg(test)]
 mod test {
     use std::{
@@ -576,4 +633,76 @@ mod test {
             assert_eq!(1, sl.drop_factory);
         }
     }
+
+    #[test]
+    fn boundary_partitioner() {
+        let boundaries = SstPartitionerBoundaries::new();
+        boundaries.set(&[b"m", b"c", b"m"]);
+        assert_eq!(boundaries.len(), 2);
+        let factory = unsafe {
+            crocksdb_ffi::crocksdb_sst_partitioner_factory_create_boundary(boundaries.inner, 100)
+        };
+        let context = unsafe { crocksdb_ffi::crocksdb_sst_partitioner_context_create() };
+        let partitioner = unsafe {
+            crocksdb_ffi::crocksdb_sst_partitioner_factory_create_partitioner(factory, context)
+        };
+        // Later updates only apply to new partitioners.
+        boundaries.set(&[]);
+
+        let should_partition = |prev: &[u8], current: &[u8], size: u64| unsafe {
+            let req = crocksdb_ffi::crocksdb_sst_partitioner_request_create();
+            crocksdb_ffi::crocksdb_sst_partitioner_request_set_prev_user_key(
+                req,
+                prev.as_ptr() as *const c_char,
+                prev.len(),
+            );
+            crocksdb_ffi::crocksdb_sst_partitioner_request_set_current_user_key(
+                req,
+                current.as_ptr() as *const c_char,
+                current.len(),
+            );
+            crocksdb_ffi::crocksdb_sst_partitioner_request_set_current_output_file_size(req, size);
+            let res = crocksdb_ffi::crocksdb_sst_partitioner_should_partition(partitioner, req);
+            crocksdb_ffi::crocksdb_sst_partitioner_request_destroy(req);
+            res
+        };
+        let can_do_trivial_move = |smallest: &[u8], largest: &[u8]| unsafe {
+            crocksdb_ffi::crocksdb_sst_partitioner_can_do_trivial_move(
+                partitioner,
+                smallest.as_ptr() as *const c_char,
+                smallest.len(),
+                largest.as_ptr() as *const c_char,
+                largest.len(),
+            )
+        };
+        assert_eq!(
+            should_partition(b"a", b"b", 200),
+            SstPartitionerResult::NotRequired
+        );
+        assert_eq!(
+            should_partition(b"b", b"c", 200),
+            SstPartitionerResult::Required
+        );
+        assert_eq!(
+            should_partition(b"b", b"c", 50),
+            SstPartitionerResult::NotRequired
+        );
+        assert_eq!(
+            should_partition(b"c", b"d", 200),
+            SstPartitionerResult::NotRequired
+        );
+        assert_eq!(
+            should_partition(b"d", b"z", 200),
+            SstPartitionerResult::Required
+        );
+        assert!(can_do_trivial_move(b"c", b"l"));
+        assert!(!can_do_trivial_move(b"a", b"c"));
+
+        unsafe {
+            crocksdb_ffi::crocksdb_sst_partitioner_destroy(partitioner);
+            crocksdb_ffi::crocksdb_sst_partitioner_context_destroy(context);
+            crocksdb_ffi::crocksdb_sst_partitioner_factory_destroy(factory);
+        }
+        assert!(boundaries.is_empty());
+    }
 }
@@ -12,9 +12,9 @@
 // limitations under the License.
 
 use crocksdb_ffi::{
-    self, DBTableProperties, DBTablePropertiesCollection, DBTablePropertiesCollectionIterator,
-    DBTableStrProperty, DBTableU64Property, DBUserCollectedProperties,
-    DBUserCollectedPropertiesIterator,
+    self, DBMvccProperties, DBTableProperties, DBTablePropertiesCache, DBTablePropertiesCollection,
+    DBTablePropertiesCollectionIterator, DBTableStrProperty, DBTableU64Property,
+    DBUserCollectedProperties, DBUserCollectedPropertiesIterator,
 };
 use libc::size_t;
 use std::marker::PhantomData;
@@ -257,6 +257,21 @@ impl UserCollectedProperties {
         }
     }
 
+    /// Returns the statistics written by the collector added with
+    /// `ColumnFamilyOptions::add_mvcc_properties_collector`.
+    pub fn mvcc_properties(&self) -> Option<DBMvccProperties> {
+        let mut mvcc = DBMvccProperties::default();
+        unsafe {
+            if crocksdb_ffi::crocksdb_user_collected_properties_get_mvcc(&self.inner, &mut mvcc)
+                != 0
+            {
+                Some(mvcc)
+            } else {
+                None
+            }
+        }
+    }
+
     pub fn len(&self) -> usize {
         unsafe { crocksdb_ffi::crocksdb_user_collected_properties_len(&self.inner) }
     }
@@ -333,3 +348,46 @@ impl<'a> Iterator for UserCollectedPropertiesIter<'a> {
         }
     }
 }
+
+/// Decoded properties of the live tables of a DB, kept up to date by a
+/// listener added with `DBOptions::add_table_properties_cache` and queried
+/// with `DB::aggregate_table_properties_cf`.
+pub struct TablePropertiesCache {
+    pub(crate) inner: *mut DBTablePropertiesCache,
+}
+
+unsafe impl Send for TablePropertiesCache {}
+unsafe impl Sync for TablePropertiesCache {}
+
+impl TablePropertiesCache {
+    pub fn new() -> TablePropertiesCache {
+        unsafe {
+            TablePropertiesCache {
+                inner: crocksdb_ffi::crocksdb_table_properties_cache_create(),
+            }
+        }
+    }
+
+    /// Number of tables currently cached.
+    pub fn len(&self) -> usize {
+        unsafe { crocksdb_ffi::crocksdb_table_properties_cache_len(self.inner) }
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.len() == 0
+    }
+}
+
+impl Default for TablePropertiesCache {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+impl Drop for TablePropertiesCache {
+    fn drop(&mut self) {
+        unsafe {
+            crocksdb_ffi::crocksdb_table_properties_cache_destroy(self.inner);
+        }
+    }
+}
@@ -13,11 +13,16 @@
 
 use std::sync::atomic::{AtomicBool, Ordering};
 use std::sync::{Arc, RwLock};
+use std::thread;
+use std::time::{Duration, Instant};
 
 use rocksdb::CompactionFilterDecision;
 use rocksdb::CompactionFilterValueType;
 use rocksdb::TitanDBOptions;
-use rocksdb::{ColumnFamilyOptions, CompactionFilter, DBOptions, Writable, DB};
+use rocksdb::{
+    ColumnFamilyOptions, CompactionFilter, DBBackgroundJobStage, DBBackgroundJobType, DBOptions,
+    Writable, DB,
+};
 
 use super::tempdir_with_prefix;
 
@@ -110,3 +115,75 @@ fn test_compaction_filter_impl(titan: bool) {
     }
     assert!(drop_called.load(Ordering::Relaxed));
 }
+
+struct BlockingFilter {
+    released: Arc<AtomicBool>,
+}
+
+impl CompactionFilter for BlockingFilter {
+    fn unsafe_filter(
+        &mut self,
+        _: usize,
+        _: &[u8],
+        _: &[u8],
+        _: CompactionFilterValueType,
+    ) -> CompactionFilterDecision {
+        while !self.released.load(Ordering::Relaxed) {
+            thread::sleep(Duration::from_millis(1));
+        }
+        CompactionFilterDecision::Keep
+    }
+}
+
+#[test]
+fn test_background_jobs() {
+    let path = tempdir_with_prefix("_rust_rocksdb_test_background_jobs");
+    let released = Arc::new(AtomicBool::new(false));
+    let mut cf_opts = ColumnFamilyOptions::new();
+    cf_opts
+        .set_compaction_filter::<&str, BlockingFilter>(
+            "blocking",
+            BlockingFilter {
+                released: released.clone(),
+            },
+        )
+        .unwrap();
+    let mut opts = DBOptions::new();
+    opts.create_if_missing(true);
+    opts.enable_thread_tracking(true);
+    let db = DB::open_cf(
+        opts,
+        path.path().to_str().unwrap(),
+        vec![("default", cf_opts)],
+    )
+    .unwrap();
+    let db = Arc::new(db);
+    for i in 0..10 {
+        db.put(format!("key{}", i).as_bytes(), b"value").unwrap();
+    }
+    assert!(db.background_jobs().unwrap().is_empty());
+
+    let db1 = db.clone();
+    let compaction = thread::spawn(move || db1.compact_range(None, None));
+    let start = Instant::now();
+    // The compaction shows up in the prepare stage before it reaches the
+    // filter, so wait until it is blocked there.
+    let job = loop {
+        let jobs = db.background_jobs().unwrap();
+        if let Some(job) = jobs.into_iter().find(|j| {
+            j.job.job_type() == Some(DBBackgroundJobType::Compaction)
+                && j.job.stage() == Some(DBBackgroundJobStage::CompactionProcessKV)
+        }) {
+            break job;
+        }
+        assert!(start.elapsed() < Duration::from_secs(10));
+        thread::sleep(Duration::from_millis(10));
+    };
+    released.store(true, Ordering::Relaxed);
+    compaction.join().unwrap();
+
+    assert_eq!(job.cf_name, "default");
+    assert_eq!(job.job.input_level, 0);
+    assert!(job.job.output_level > 0);
+    assert!(job.job.input_bytes > 0);
+}
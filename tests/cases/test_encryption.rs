@@ -11,9 +11,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+use std::io::{Read, Write};
 use std::sync::Arc;
 
-use rocksdb::{DBOptions, Env, FlushOptions, Writable, DB};
+use rocksdb::{DBOptions, Env, EnvOptions, FlushOptions, Writable, DB};
 
 use super::tempdir_with_prefix;
 
@@ -36,6 +37,90 @@ fn test_ctr_encrypted_env() {
     }
 }
 
+#[test]
+fn test_ctr_encrypted_env_unaligned_io() {
+    let base_env = Arc::new(Env::new_mem());
+    let ciphertext = &[16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1];
+    let env = Env::new_ctr_encrypted_env(Arc::clone(&base_env), ciphertext).unwrap();
+    let data: Vec<u8> = (0..100_000u32).map(|i| (i * 7 % 251) as u8).collect();
+
+    // Writes and reads that straddle cipher blocks and keystream chunks.
+    let mut f = env.new_writable_file("/f", EnvOptions::new()).unwrap();
+    let mut written = 0;
+    for (i, n) in [7, 4093, 40_000, 1, 15].iter().cycle().enumerate() {
+        let end = (written + n).min(data.len());
+        f.write_all(&data[written..end]).unwrap();
+        written = end;
+        if written == data.len() {
+            assert!(i > 4);
+            break;
+        }
+    }
+    f.close().unwrap();
+
+    let mut f = env.new_sequential_file("/f", EnvOptions::new()).unwrap();
+    let mut read = vec![];
+    let mut buf = [0; 33_333];
+    loop {
+        let n = f.read(&mut buf).unwrap();
+        if n == 0 {
+            break;
+        }
+        read.extend_from_slice(&buf[..n]);
+    }
+    assert_eq!(read, data);
+
+    let mut raw = vec![];
+    let mut f = base_env
+        .new_sequential_file("/f", EnvOptions::new())
+        .unwrap();
+    f.read_to_end(&mut raw).unwrap();
+    assert!(raw.len() > data.len());
+    assert!(!raw.windows(64).any(|w| w == &data[..64]));
+}
+
+// Produced by RocksDB's stock CTRCipherStream, which encrypted files were
+// written with before the env switched to its own stream.
+#[test]
+fn test_ctr_encrypted_env_stock_vector() {
+    let key = &[16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1];
+    let initial_counter = 0x0102_0304_0506_0708u64;
+    let iv: Vec<u8> = (0xa0..0xb0).collect();
+    let plaintext = b"Written by the stock CTRCipherStream in 16-byte cipher blocks.";
+    let ciphertext: &[u8] = &[
+        0x4f, 0x7a, 0x61, 0x7c, 0x7c, 0x6d, 0x66, 0x28, 0xc2, 0xd7, 0x8c, 0xda, 0xc0, 0xcb, 0x8c,
+        0xdd, 0x6d, 0x67, 0x6b, 0x63, 0x28, 0x4b, 0x5c, 0x5a, 0xe3, 0xc7, 0xdc, 0xc6, 0xcd, 0xdc,
+        0xff, 0xda, 0x68, 0x6d, 0x69, 0x65, 0x28, 0x61, 0x66, 0x28, 0x91, 0x98, 0x81, 0xcc, 0xd1,
+        0xda, 0xc9, 0x8e, 0x78, 0x61, 0x78, 0x60, 0x6d, 0x7a, 0x28, 0x6a, 0xcc, 0xc1, 0xcf, 0xc5,
+        0xdb, 0x80,
+    ];
+
+    // The 4KB file prefix starts with the initial counter block, followed by
+    // the IV block. The rest is opaque to the cipher stream of the data.
+    let mut raw = vec![0u8; 4096];
+    raw[..8].copy_from_slice(&initial_counter.to_le_bytes());
+    raw[16..32].copy_from_slice(&iv);
+    raw.extend_from_slice(ciphertext);
+    let base_env = Arc::new(Env::new_mem());
+    let mut f = base_env.new_writable_file("/f", EnvOptions::new()).unwrap();
+    f.write_all(&raw).unwrap();
+    f.close().unwrap();
+
+    // Reads straddle cipher blocks.
+    let env = Env::new_ctr_encrypted_env(Arc::clone(&base_env), key).unwrap();
+    let mut f = env.new_sequential_file("/f", EnvOptions::new()).unwrap();
+    let mut read = vec![];
+    let mut buf = [0; 7];
+    loop {
+        let n = f.read(&mut buf).unwrap();
+        if n == 0 {
+            break;
+        }
+        read.extend_from_slice(&buf[..n]);
+    }
+    assert_eq!(read, &plaintext[..]);
+}
+
 fn test_ctr_encrypted_env_impl(encrypted_env: Arc<Env>) {
     let path = tempdir_with_prefix("_rust_rocksdb_cryption_env");
     let path_str = path.path().to_str().unwrap();
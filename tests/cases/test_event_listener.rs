@@ -361,3 +361,138 @@ fn compact_files_to_bottom(db: &DB) {
     // output_level should be from 0 to 6.
     db.compact_range(None, None);
 }
+
+#[test]
+fn test_event_ring() {
+    let path = tempdir_with_prefix("_rust_rocksdb_event_ring");
+    let path_str = path.path().to_str().unwrap();
+
+    let ring = EventRing::new(3);
+    let mut opts = DBOptions::new();
+    opts.add_event_ring(&ring);
+    opts.create_if_missing(true);
+    let db = DB::open(opts, path_str).unwrap();
+    let mut fopts = FlushOptions::default();
+    fopts.set_wait(true);
+    // Both files hold k0 and k1, so the compaction rewrites them instead of
+    // trivially moving them, which would read no input.
+    for i in 0..2 {
+        db.put(b"k0", format!("v{}", i).as_bytes()).unwrap();
+        db.put(b"k1", format!("v{}", i).as_bytes()).unwrap();
+        db.flush(&fopts).unwrap();
+    }
+    db.compact_range(None, None);
+
+    let records = ring.drain(16);
+    assert_eq!(records.len(), 3);
+    assert_eq!(ring.dropped(), 0);
+    for r in &records[..2] {
+        assert_eq!(r.event_type(), Some(DBEventType::FlushCompleted));
+        assert_ne!(r.elapsed_micros, 0);
+        assert_eq!(r.cf_name(), b"default");
+        assert_eq!(r.output_level, 0);
+        assert_ne!(r.file_number, 0);
+        assert!(r.path().ends_with(b".sst"));
+    }
+    let compaction = &records[2];
+    assert_eq!(
+        compaction.event_type(),
+        Some(DBEventType::CompactionCompleted)
+    );
+    assert_eq!(compaction.num_input_files, 2);
+    assert_eq!(compaction.status_code, 0);
+    assert!(compaction.input_bytes > 0);
+    assert_eq!(compaction.num_output_files, 1);
+    assert!(ring.drain(16).is_empty());
+
+    // Capacity is rounded up to 4; events beyond it are dropped.
+    for i in 0..6 {
+        db.put(format!("k{}", i).as_bytes(), b"v").unwrap();
+        db.flush(&fopts).unwrap();
+    }
+    assert_eq!(ring.drain(16).len(), 4);
+    assert!(ring.dropped() >= 2);
+    drop(db);
+
+    // The column families of an atomic flush share its job id, but each
+    // still gets its own duration.
+    let path = tempdir_with_prefix("_rust_rocksdb_event_ring_atomic_flush");
+    let ring = EventRing::new(16);
+    let mut opts = DBOptions::new();
+    opts.add_event_ring(&ring);
+    opts.create_if_missing(true);
+    opts.create_missing_column_families(true);
+    opts.set_atomic_flush(true);
+    let db = DB::open_cf(
+        opts,
+        path.path().to_str().unwrap(),
+        vec![
+            ("default", ColumnFamilyOptions::new()),
+            ("write", ColumnFamilyOptions::new()),
+        ],
+    )
+    .unwrap();
+    let default = db.cf_handle("default").unwrap();
+    let write = db.cf_handle("write").unwrap();
+    db.put_cf(default, b"k0", b"v").unwrap();
+    db.put_cf(write, b"k0", b"v").unwrap();
+    db.flush_cfs(&[default, write], &fopts).unwrap();
+    let records = ring.drain(16);
+    assert_eq!(records.len(), 2);
+    assert_eq!(records[0].job_id, records[1].job_id);
+    for r in &records {
+        assert_eq!(r.event_type(), Some(DBEventType::FlushCompleted));
+        assert_ne!(r.elapsed_micros, 0);
+    }
+}
+
+#[test]
+fn test_file_io_stats() {
+    let path = tempdir_with_prefix("_rust_rocksdb_file_io_stats");
+    let path_str = path.path().to_str().unwrap();
+
+    let stats = FileIoStats::new();
+    let mut opts = DBOptions::new();
+    opts.add_file_io_stats(&stats);
+    opts.create_if_missing(true);
+    let db = DB::open(opts, path_str).unwrap();
+    let mut fopts = FlushOptions::default();
+    fopts.set_wait(true);
+    // Both files hold k0 and k1, so compaction rewrites them instead of
+    // trivially moving them.
+    for i in 0..2 {
+        db.put(b"k0", format!("v{}", i).as_bytes()).unwrap();
+        db.put(b"k1", format!("v{}", i).as_bytes()).unwrap();
+        db.flush(&fopts).unwrap();
+    }
+    let writes = stats.by_file_type(DBFileIoOp::Write, DBIoFileType::Table);
+    assert_ne!(writes.count, 0);
+    assert_ne!(writes.bytes, 0);
+    assert_eq!(writes.buckets.iter().sum::<u64>(), writes.count);
+    assert!(writes.percentile_micros(99.0) >= writes.percentile_micros(50.0));
+    let wal = stats.by_file_type(DBFileIoOp::Write, DBIoFileType::Wal);
+    assert_ne!(wal.count, 0);
+    assert_eq!(stats.table_files().created, 2);
+    // The level of a file is known before it is written.
+    assert_eq!(stats.by_level(DBFileIoOp::Write, 0).count, writes.count);
+
+    db.compact_range(None, None);
+    assert_ne!(stats.by_level(DBFileIoOp::Read, 0).count, 0);
+    let output_writes: u64 = (1..7)
+        .map(|l| stats.by_level(DBFileIoOp::Write, l).count)
+        .sum();
+    assert_ne!(output_writes, 0);
+    let files = stats.table_files();
+    assert_eq!(files.created, 3);
+    // Obsolete files may be purged in the background.
+    assert!(files.deleted <= 2);
+
+    stats.reset();
+    assert_eq!(
+        stats
+            .by_file_type(DBFileIoOp::Write, DBIoFileType::Table)
+            .count,
+        0
+    );
+    assert_eq!(stats.table_files(), TableFileCounts::default());
+}
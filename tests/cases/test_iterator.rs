@@ -286,6 +286,106 @@ fn read_with_upper_bound() {
     }
 }
 
+#[test]
+fn read_with_async_io() {
+    let path = tempdir_with_prefix("_rust_rocksdb_read_with_async_io");
+    let mut opts = DBOptions::new();
+    opts.create_if_missing(true);
+    let db = DB::open(opts, path.path().to_str().unwrap()).unwrap();
+    let mut fopts = FlushOptions::default();
+    fopts.set_wait(true);
+    for i in 0..100 {
+        let k = format!("k{:03}", i);
+        db.put(k.as_bytes(), k.as_bytes()).unwrap();
+        if i % 25 == 0 {
+            db.flush(&fopts).unwrap();
+        }
+    }
+
+    // Results don't depend on whether reads are actually issued in parallel,
+    // so this runs the same with or without io_uring. io_uring is not
+    // toggled here because the switch is process-wide and other tests run
+    // concurrently.
+    if !cfg!(feature = "io_uring") {
+        assert!(!io_uring_supported());
+    }
+    let mut readopts = ReadOptions::new();
+    readopts.set_async_io(true);
+    readopts.set_optimize_multiget_for_io(true);
+    readopts.set_readahead_size(4096);
+    let mut iter = db.iter_opt(readopts);
+    iter.seek(SeekKey::Start).unwrap();
+    let vec = next_collect(&mut iter);
+    assert_eq!(vec.len(), 100);
+    assert_eq!(vec[42].0, b"k042");
+}
+
+#[test]
+fn multi_get_with_async_io() {
+    // Reads through an inspected env over an encrypted one, and counts read
+    // requests at a priority only this thread uses. Blocks of a batch reach
+    // the inspector as one MultiRead, while looking keys up one by one would
+    // charge one read per block.
+    let path = tempdir_with_prefix("_rust_rocksdb_multi_get_with_async_io");
+    let encrypted = Env::new_default_ctr_encrypted_env(&[8, 7, 6, 5, 4, 3, 2, 1]).unwrap();
+    let inspector = TokenBucketInspector::new();
+    let env = Env::new_token_bucket_inspected_env(Arc::new(encrypted), &inspector).unwrap();
+    let mut opts = DBOptions::new();
+    opts.create_if_missing(true);
+    opts.set_env(Arc::new(env));
+    let mut bbto = BlockBasedOptions::new();
+    bbto.set_no_block_cache(true);
+    bbto.set_block_size(256);
+    let mut cf_opts = ColumnFamilyOptions::new();
+    cf_opts.set_block_based_table_factory(&bbto);
+    cf_opts.compression(DBCompressionType::No);
+    let db = DB::open_cf(
+        opts,
+        path.path().to_str().unwrap(),
+        vec![("default", cf_opts)],
+    )
+    .unwrap();
+    let value = vec![b'v'; 512];
+    for i in 0..64 {
+        db.put(format!("k{:03}", i).as_bytes(), &value).unwrap();
+    }
+    let mut fopts = FlushOptions::default();
+    fopts.set_wait(true);
+    db.flush(&fopts).unwrap();
+
+    // Every other key, so no two keys share or neighbour a block.
+    let keys: Vec<Vec<u8>> = (0..64)
+        .step_by(2)
+        .map(|i| format!("k{:03}", i).into_bytes())
+        .collect();
+    let mut key_refs: Vec<&[u8]> = keys.iter().map(|k| k.as_slice()).collect();
+    key_refs.push(b"missing");
+    let mut readopts = ReadOptions::new();
+    readopts.set_async_io(true);
+    readopts.set_optimize_multiget_for_io(true);
+    let cf = db.cf_handle("default").unwrap();
+
+    set_thread_io_priority(DBIoPriority::High);
+    let before = inspector.counters(DBFileIoOp::Read, DBIoPriority::High);
+    let values = db.multi_get_cf_opt(cf, &key_refs, &readopts);
+    let after = inspector.counters(DBFileIoOp::Read, DBIoPriority::High);
+    set_thread_io_priority(DBIoPriority::Normal);
+
+    assert_eq!(values.len(), keys.len() + 1);
+    for v in &values[..keys.len()] {
+        assert_eq!(v.as_ref().unwrap().as_deref(), Some(value.as_slice()));
+    }
+    assert_eq!(values[keys.len()], Ok(None));
+    let requests = after.requests - before.requests;
+    assert!(requests > 0);
+    assert!(
+        requests < keys.len() as u64,
+        "{} read requests for {} keys",
+        requests,
+        keys.len()
+    );
+}
+
 #[test]
 fn test_total_order_seek() {
     let path = tempdir_with_prefix("_rust_rocksdb_total_order_seek");
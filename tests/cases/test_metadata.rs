@@ -12,8 +12,8 @@
 // limitations under the License.
 
 use rocksdb::{
-    CFHandle, ColumnFamilyOptions, CompactionOptions, DBCompressionType, DBOptions, FlushOptions,
-    Writable, DB,
+    BlockBasedOptions, CFHandle, ColumnFamilyOptions, CompactionOptions, DBCompressionType,
+    DBOptions, FlushOptions, Range, Writable, DB,
 };
 
 use super::tempdir_with_prefix;
@@ -119,3 +119,48 @@ fn test_compact_files() {
         .unwrap();
     assert_eq!(get_files_cf(&db, cf_handle, 0).len(), 1);
 }
+
+#[test]
+fn test_get_split_keys() {
+    let path = tempdir_with_prefix("_rust_rocksdb_test_split_keys");
+    let mut opts = DBOptions::new();
+    opts.create_if_missing(true);
+    let mut cf_opts = ColumnFamilyOptions::new();
+    cf_opts.set_disable_auto_compactions(true);
+    let mut block_opts = BlockBasedOptions::new();
+    block_opts.set_block_size(256);
+    cf_opts.set_block_based_table_factory(&block_opts);
+    cf_opts.compression(DBCompressionType::No);
+    let db = DB::open_cf(
+        opts,
+        path.path().to_str().unwrap(),
+        vec![("default", cf_opts)],
+    )
+    .unwrap();
+    let cf = db.cf_handle("default").unwrap();
+
+    let mut fopts = FlushOptions::default();
+    fopts.set_wait(true);
+    for i in 0..1000 {
+        db.put(format!("k{:04}", i).as_bytes(), &[0; 100]).unwrap();
+        if i % 250 == 249 {
+            db.flush(&fopts).unwrap();
+        }
+    }
+    let split = db.get_split_keys_cf(cf, Range::new(b"k", b"l"), 3).unwrap();
+    assert_eq!(split.keys.len(), 3);
+    assert!(split.sst_size > 0);
+    assert_eq!(split.memtable_size, 0);
+    let mut prev = b"k".to_vec();
+    for key in &split.keys {
+        assert!(*key > prev && key.as_slice() < b"l".as_ref());
+        prev = key.clone();
+    }
+    // Files are of even size, so the middle key falls close to the middle.
+    assert!(split.keys[1].as_slice() > b"k0400".as_ref());
+    assert!(split.keys[1].as_slice() < b"k0600".as_ref());
+
+    db.put(b"k5000", &[0; 100]).unwrap();
+    let split = db.get_split_keys_cf(cf, Range::new(b"k", b"l"), 3).unwrap();
+    assert!(split.memtable_size > 0);
+}
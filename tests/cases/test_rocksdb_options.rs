@@ -14,16 +14,19 @@
 use std::path::Path;
 use std::sync::Arc;
 use std::thread;
-use std::time::Duration;
+use std::time::{Duration, Instant};
 
 use rocksdb::crocksdb_ffi::{
-    CompactionPriority, DBCompressionType, DBInfoLogLevel as InfoLogLevel, DBRateLimiterMode,
-    DBStatisticsHistogramType as HistogramType, DBStatisticsTickerType as TickerType,
+    CompactionPriority, DBCacheEntryRole, DBCompressionType, DBInfoLogLevel as InfoLogLevel,
+    DBLevelFilterType, DBRateLimiterMode, DBStatisticsHistogramType as HistogramType,
+    DBStatisticsTickerType as TickerType,
 };
 use rocksdb::{
-    BlockBasedOptions, Cache, ColumnFamilyOptions, CompactOptions, DBOptions, Env,
-    FifoCompactionOptions, FlushOptions, HyperClockCacheOptions, IndexType, LRUCacheOptions,
-    RateLimiter, ReadOptions, SeekKey, SliceTransform, Statistics, Writable, WriteOptions, DB,
+    BlockBasedOptions, Cache, CacheDumpOptions, CacheUsageMonitor, ColumnFamilyOptions,
+    CompactOptions, DBOptions, Env, EnvOptions, FifoCompactionOptions, FilterStats, FlushOptions,
+    HyperClockCacheOptions, IndexType, IngestExternalFileOptions, LRUCacheOptions, LevelFilter,
+    RateLimiter, ReadOptions, SecondaryCache, SeekKey, SliceTransform, SstFileWriter, Statistics,
+    Writable, WriteOptions, DB,
 };
 
 use super::tempdir_with_prefix;
@@ -372,6 +375,256 @@ fn test_hyper_clock_cache() {
     DB::open_cf(opts, path.path().to_str().unwrap(), vec!["default"]).unwrap();
 }
 
+#[test]
+fn test_compressed_secondary_cache() {
+    let secondary = SecondaryCache::new_compressed(1 << 20, -1, DBCompressionType::Lz4);
+    assert_eq!(secondary.capacity().unwrap(), 1 << 20);
+    secondary.set_capacity(4 << 20).unwrap();
+    assert_eq!(secondary.capacity().unwrap(), 4 << 20);
+
+    let mut lru_opts = LRUCacheOptions::new();
+    lru_opts.set_capacity(64 << 10);
+    lru_opts.set_secondary_cache(&secondary);
+    let mut hcc_opts = HyperClockCacheOptions::new(64 << 10, 4096);
+    hcc_opts.set_secondary_cache(&secondary);
+    let caches = vec![Cache::new_lru_cache(lru_opts), hcc_opts.make_shared_cache()];
+    for cache in &caches {
+        let path = tempdir_with_prefix("_rust_rocksdb_compressed_secondary_cache");
+        let mut opts = DBOptions::new();
+        opts.create_if_missing(true);
+        let statistics = Statistics::new();
+        opts.set_statistics(&statistics);
+        let mut cf_opts = ColumnFamilyOptions::new();
+        let mut block_opts = BlockBasedOptions::new();
+        block_opts.set_block_size(4096);
+        block_opts.set_block_cache(cache);
+        cf_opts.set_block_based_table_factory(&block_opts);
+        let db = DB::open_cf(
+            opts,
+            path.path().to_str().unwrap(),
+            vec![("default", cf_opts)],
+        )
+        .unwrap();
+        for i in 0..10_000 {
+            db.put(format!("k{:05}", i).as_bytes(), &[b'v'; 64])
+                .unwrap();
+        }
+        let mut fopts = FlushOptions::default();
+        fopts.set_wait(true);
+        db.flush(&fopts).unwrap();
+        // The working set is larger than the primary cache, so evicted blocks
+        // are looked up in the secondary tier.
+        for _ in 0..3 {
+            for i in (0..10_000).step_by(7) {
+                let v = db.get(format!("k{:05}", i).as_bytes()).unwrap().unwrap();
+                assert_eq!(&*v, &[b'v'; 64][..]);
+            }
+        }
+        assert!(statistics.get_ticker_count(TickerType::BlockCacheMiss) > 0);
+        // Blocks are only admitted for real on their second eviction; a first
+        // lookup finds a placeholder.
+        let secondary_hits = statistics
+            .get_ticker_count(TickerType::CompressedSecondaryCacheDummyHits)
+            + statistics.get_ticker_count(TickerType::CompressedSecondaryCacheHits);
+        assert!(secondary_hits > 0);
+    }
+    // Both block caches spill into and look up the same tier.
+    let counters = secondary.counters();
+    assert!(counters.inserts > 0);
+    assert!(counters.lookups > 0 && counters.hits <= counters.lookups);
+    assert_eq!(counters.saved_inserts, 0);
+}
+
+#[test]
+fn test_cache_usage_monitor() {
+    let mut lru_opts = LRUCacheOptions::new();
+    lru_opts.set_capacity(8 << 20);
+    let cache = Cache::new_lru_cache(lru_opts);
+    let monitor = CacheUsageMonitor::new(&cache, Duration::from_secs(0));
+
+    let path = tempdir_with_prefix("_rust_rocksdb_cache_usage_monitor");
+    let mut opts = DBOptions::new();
+    opts.create_if_missing(true);
+    let mut cf_opts = ColumnFamilyOptions::new();
+    let mut block_opts = BlockBasedOptions::new();
+    block_opts.set_block_cache(&cache);
+    block_opts.set_bloom_filter(10.0, false);
+    block_opts.set_cache_index_and_filter_blocks(true);
+    cf_opts.set_block_based_table_factory(&block_opts);
+    let db = DB::open_cf(
+        opts,
+        path.path().to_str().unwrap(),
+        vec![("default", cf_opts)],
+    )
+    .unwrap();
+    for i in 0..1000 {
+        db.put(format!("k{:04}", i).as_bytes(), b"v").unwrap();
+    }
+    let mut fopts = FlushOptions::default();
+    fopts.set_wait(true);
+    db.flush(&fopts).unwrap();
+    for i in 0..1000 {
+        db.get(format!("k{:04}", i).as_bytes()).unwrap().unwrap();
+    }
+
+    let usage = monitor.usage(Duration::from_secs(0));
+    assert_eq!(usage.capacity, 8 << 20);
+    assert!(usage.roles.count(DBCacheEntryRole::DataBlock) > 0);
+    assert!(usage.roles.count(DBCacheEntryRole::IndexBlock) > 0);
+    assert!(usage.roles.count(DBCacheEntryRole::FilterBlock) > 0);
+
+    let cf = db.cf_handle("default").unwrap();
+    let cf_usage = monitor
+        .cf_usage(&db, &[cf], Duration::from_secs(0))
+        .unwrap();
+    assert_eq!(cf_usage.len(), 1);
+    for role in &[
+        DBCacheEntryRole::DataBlock,
+        DBCacheEntryRole::IndexBlock,
+        DBCacheEntryRole::FilterBlock,
+    ] {
+        assert!(cf_usage[0].bytes(*role) > 0);
+        assert!(cf_usage[0].bytes(*role) <= usage.roles.bytes(*role));
+    }
+
+    // A sub-second refresh interval keeps the snapshot fresh without
+    // waiting, and a sub-second max age doesn't force a walk either.
+    let monitor = CacheUsageMonitor::new(&cache, Duration::from_millis(10));
+    let first = monitor.usage(Duration::from_secs(3600));
+    thread::sleep(Duration::from_millis(200));
+    let second = monitor.usage(Duration::from_millis(500));
+    assert!(second.collected_at_micros > first.collected_at_micros);
+}
+
+#[test]
+fn test_cache_dump_and_load() {
+    let dir = tempdir_with_prefix("_rust_rocksdb_cache_dump_and_load");
+    let db_path = dir.path().join("db");
+    let dump_path = dir.path().join("cache_dump");
+    let statistics = Statistics::new();
+    let open = |cache: &Cache| {
+        let mut opts = DBOptions::new();
+        opts.create_if_missing(true);
+        opts.set_statistics(&statistics);
+        let mut cf_opts = ColumnFamilyOptions::new();
+        let mut block_opts = BlockBasedOptions::new();
+        block_opts.set_block_cache(cache);
+        cf_opts.set_block_based_table_factory(&block_opts);
+        DB::open_cf(opts, db_path.to_str().unwrap(), vec![("default", cf_opts)]).unwrap()
+    };
+
+    let mut lru_opts = LRUCacheOptions::new();
+    lru_opts.set_capacity(8 << 20);
+    let cache = Cache::new_lru_cache(lru_opts);
+    let db = open(&cache);
+    for i in 0..1000 {
+        db.put(format!("k{:04}", i).as_bytes(), b"v").unwrap();
+    }
+    let mut fopts = FlushOptions::default();
+    fopts.set_wait(true);
+    db.flush(&fopts).unwrap();
+    for i in 0..1000 {
+        db.get(format!("k{:04}", i).as_bytes()).unwrap().unwrap();
+    }
+    let cf = db.cf_handle("default").unwrap();
+    let mut dump_opts = CacheDumpOptions::new();
+    dump_opts.set_roles(&[DBCacheEntryRole::DataBlock, DBCacheEntryRole::IndexBlock]);
+    cache.dump(&dump_path, &db, &[cf], &dump_opts).unwrap();
+    assert!(std::fs::metadata(&dump_path).unwrap().len() > 0);
+    drop(db);
+
+    let secondary = SecondaryCache::new_compressed(8 << 20, -1, DBCompressionType::No);
+    let mut lru_opts = LRUCacheOptions::new();
+    lru_opts.set_capacity(8 << 20);
+    lru_opts.set_secondary_cache(&secondary);
+    let warm_cache = Cache::new_lru_cache(lru_opts);
+    let mut load_opts = CacheDumpOptions::new();
+    load_opts.set_rate_limiter(&RateLimiter::new(64 << 20, 100_000, 10));
+    secondary
+        .load(&dump_path, &BlockBasedOptions::new(), None, &[], &load_opts)
+        .unwrap();
+    let db = open(&warm_cache);
+    statistics.reset();
+    for i in 0..1000 {
+        let v = db.get(format!("k{:04}", i).as_bytes()).unwrap().unwrap();
+        assert_eq!(&*v, b"v");
+    }
+    // The data blocks come from the loaded dump rather than the files.
+    assert!(statistics.get_ticker_count(TickerType::SecondaryCacheHits) > 0);
+    let counters = secondary.counters();
+    assert!(counters.saved_inserts > 0);
+    assert!(counters.hits > 0 && counters.hits <= counters.lookups);
+
+    // At a rate of the dump's size per second, loading it takes about a
+    // second, less the first refill.
+    let dump_len = std::fs::metadata(&dump_path).unwrap().len();
+    let slow_secondary = SecondaryCache::new_compressed(8 << 20, -1, DBCompressionType::No);
+    let mut slow_opts = CacheDumpOptions::new();
+    slow_opts.set_rate_limiter(&RateLimiter::new(dump_len as i64, 100_000, 10));
+    let start = Instant::now();
+    slow_secondary
+        .load(&dump_path, &BlockBasedOptions::new(), None, &[], &slow_opts)
+        .unwrap();
+    assert!(start.elapsed() >= Duration::from_millis(400));
+}
+
+#[test]
+fn test_prefetch_range() {
+    let path = tempdir_with_prefix("_rust_rocksdb_prefetch_range");
+    let mut opts = DBOptions::new();
+    opts.create_if_missing(true);
+    let statistics = Statistics::new();
+    opts.set_statistics(&statistics);
+    let mut cf_opts = ColumnFamilyOptions::new();
+    let mut block_opts = BlockBasedOptions::new();
+    let mut lru_opts = LRUCacheOptions::new();
+    lru_opts.set_capacity(8 << 20);
+    block_opts.set_block_cache(&Cache::new_lru_cache(lru_opts));
+    block_opts.set_block_size(1024);
+    cf_opts.set_block_based_table_factory(&block_opts);
+    // Prefetched ranges cross prefixes.
+    cf_opts
+        .set_prefix_extractor(
+            "FixedPrefixTransform",
+            FixedPrefixTransform { prefix_len: 3 },
+        )
+        .unwrap();
+    let db = DB::open_cf(
+        opts,
+        path.path().to_str().unwrap(),
+        vec![("default", cf_opts)],
+    )
+    .unwrap();
+    for i in 0..1000 {
+        db.put(format!("k{:04}", i).as_bytes(), &[b'v'; 32])
+            .unwrap();
+    }
+    let mut fopts = FlushOptions::default();
+    fopts.set_wait(true);
+    db.flush(&fopts).unwrap();
+    let cf = db.cf_handle("default").unwrap();
+
+    // The budget is exhausted by the first block read.
+    let prefetch = db.prefetch_range_cf(cf, None, None, 0, 1);
+    let progress = prefetch.wait().unwrap();
+    assert!(progress.done);
+    assert_eq!(progress.keys, 1);
+
+    let prefetch = db.prefetch_range_cf(cf, Some(b"k0150"), Some(b"k0250"), 64 << 10, 0);
+    let progress = prefetch.wait().unwrap();
+    assert_eq!(progress.keys, 100);
+    assert!(progress.bytes_read > 0);
+
+    statistics.reset();
+    for i in 150..250 {
+        db.get(format!("k{:04}", i).as_bytes()).unwrap().unwrap();
+    }
+    assert_eq!(
+        statistics.get_ticker_count(TickerType::BlockCacheDataMiss),
+        0
+    );
+}
+
 #[cfg(feature = "jemalloc")]
 #[test]
 fn test_set_jemalloc_nodump_allocator_for_lru_cache() {
@@ -456,6 +709,76 @@ fn test_set_optimize_filters_for_hits() {
     .unwrap();
 }
 
+#[test]
+fn test_level_filter_policy() {
+    let path = tempdir_with_prefix("_rust_rocksdb_level_filter_policy");
+    let mut opts = DBOptions::new();
+    opts.create_if_missing(true);
+    let mut cf_opts = ColumnFamilyOptions::new();
+    cf_opts.set_num_levels(2);
+    let stats = FilterStats::new();
+    let mut block_opts = BlockBasedOptions::new();
+    block_opts.set_level_filter_policy(
+        &[LevelFilter::Ribbon(10.0), LevelFilter::Bloom(10.0)],
+        true,
+        Some(&stats),
+    );
+    cf_opts.set_block_based_table_factory(&block_opts);
+    let db = DB::open_cf(
+        opts,
+        path.path().to_str().unwrap(),
+        vec![("default", cf_opts)],
+    )
+    .unwrap();
+    let cf = db.cf_handle("default").unwrap();
+
+    db.put(b"k1", b"v").unwrap();
+    db.put(b"k3", b"v").unwrap();
+    let mut fopts = FlushOptions::default();
+    fopts.set_wait(true);
+    db.flush(&fopts).unwrap();
+    let sizes = db.get_filter_size_per_level_cf(cf, 2).unwrap();
+    assert!(sizes[0] > 0);
+    assert_eq!(sizes[1], 0);
+
+    assert!(db.get(b"k2").unwrap().is_none());
+    assert!(stats.probes(DBLevelFilterType::Ribbon) > 0);
+    assert!(stats.useful(DBLevelFilterType::Ribbon) > 0);
+    assert!(stats.resident_bytes(DBLevelFilterType::Ribbon) > 0);
+    assert_eq!(stats.probes(DBLevelFilterType::Bloom), 0);
+
+    // The bottommost level is written without filters. The second file
+    // overlaps the first so that compaction rewrites them rather than
+    // trivially moving them, which would keep the Ribbon filter.
+    db.put(b"k2", b"v").unwrap();
+    db.flush(&fopts).unwrap();
+    db.compact_range(None, None);
+    let sizes = db.get_filter_size_per_level_cf(cf, 2).unwrap();
+    assert_eq!(sizes, vec![0, 0]);
+    assert_eq!(db.get(b"k1").unwrap().unwrap(), b"v");
+    assert_eq!(db.get(b"k2").unwrap().unwrap(), b"v");
+
+    // Ingested files are not written as bottommost, so they keep the last
+    // entry's filter even when they land in the bottommost level.
+    let sst_path = path.path().join("ingest.sst");
+    let sst_path = sst_path.to_str().unwrap();
+    let mut ingest_cf_opts = ColumnFamilyOptions::new();
+    ingest_cf_opts.set_num_levels(2);
+    ingest_cf_opts.set_block_based_table_factory(&block_opts);
+    let mut writer = SstFileWriter::new(EnvOptions::new(), ingest_cf_opts);
+    writer.open(sst_path).unwrap();
+    writer.put(b"k5", b"v").unwrap();
+    writer.put(b"k7", b"v").unwrap();
+    writer.finish().unwrap();
+    db.ingest_external_file_cf(cf, &IngestExternalFileOptions::new(), &[sst_path])
+        .unwrap();
+    let sizes = db.get_filter_size_per_level_cf(cf, 2).unwrap();
+    assert_eq!(sizes[0], 0);
+    assert!(sizes[1] > 0);
+    assert!(db.get(b"k6").unwrap().is_none());
+    assert!(stats.probes(DBLevelFilterType::Bloom) > 0);
+}
+
 #[test]
 fn test_set_force_consistency_checks() {
     let path = tempdir_with_prefix("_rust_rocksdb_force_consistency_checks");
@@ -1005,3 +1328,96 @@ fn test_bottommost_file_compaction_delay() {
         .unwrap();
     assert_eq!(db.get_options().get_bottommost_file_compaction_delay(), 200);
 }
+
+#[test]
+fn test_builtin_comparator() {
+    let mut cf_opts = ColumnFamilyOptions::new();
+    assert!(cf_opts.set_builtin_comparator("no.SuchComparator").is_err());
+
+    let path = tempdir_with_prefix("_rust_rocksdb_builtin_comparator");
+    let path_str = path.path().to_str().unwrap();
+    let mut opts = DBOptions::new();
+    opts.create_if_missing(true);
+    cf_opts
+        .set_builtin_comparator("crocksdb.BytewiseDescTsSuffixComparator")
+        .unwrap();
+    let db = DB::open_cf(opts, path_str, vec![("default", cf_opts)]).unwrap();
+    let mut keys = vec![];
+    for (user_key, ts) in &[(b"a", 1u64), (b"a", 3), (b"b", 2), (b"a", 2)] {
+        let mut key = user_key.to_vec();
+        key.extend_from_slice(&ts.to_be_bytes());
+        db.put(&key, b"v").unwrap();
+        keys.push(key);
+    }
+    let mut fopts = FlushOptions::default();
+    fopts.set_wait(true);
+    db.flush(&fopts).unwrap();
+
+    let mut iter = db.iter();
+    iter.seek(SeekKey::Start).unwrap();
+    let mut order = vec![];
+    while iter.valid().unwrap() {
+        order.push(iter.key().to_vec());
+        iter.next().unwrap();
+    }
+    assert_eq!(
+        order,
+        vec![
+            keys[1].clone(),
+            keys[3].clone(),
+            keys[0].clone(),
+            keys[2].clone()
+        ]
+    );
+}
+
+#[test]
+fn test_u64_prefix_comparator() {
+    let path = tempdir_with_prefix("_rust_rocksdb_u64_prefix_comparator");
+    let path_str = path.path().to_str().unwrap();
+    let mut opts = DBOptions::new();
+    opts.create_if_missing(true);
+    let mut cf_opts = ColumnFamilyOptions::new();
+    cf_opts
+        .set_builtin_comparator("crocksdb.U64PrefixBytewiseComparator")
+        .unwrap();
+    // Tiny blocks so that most index entries come from shortened separators.
+    let mut block_opts = BlockBasedOptions::new();
+    block_opts.set_block_size(64);
+    cf_opts.set_block_based_table_factory(&block_opts);
+    let db = DB::open_cf(opts, path_str, vec![("default", cf_opts)]).unwrap();
+    let key = |prefix: u64, suffix: u32| {
+        let mut k = prefix.to_be_bytes().to_vec();
+        k.extend_from_slice(format!("key{:06}", suffix).as_bytes());
+        k
+    };
+    let mut keys = vec![];
+    for prefix in &[1u64, 2, 256, 1 << 40] {
+        for i in 0..100 {
+            keys.push(key(*prefix, i));
+        }
+    }
+    for k in keys.iter().rev() {
+        db.put(k, b"value").unwrap();
+    }
+    let mut fopts = FlushOptions::default();
+    fopts.set_wait(true);
+    db.flush(&fopts).unwrap();
+
+    for k in &keys {
+        assert_eq!(db.get(k).unwrap().unwrap(), b"value");
+    }
+    assert!(db.get(&key(2, 100)).unwrap().is_none());
+    let mut iter = db.iter();
+    iter.seek(SeekKey::Start).unwrap();
+    let mut order = vec![];
+    while iter.valid().unwrap() {
+        order.push(iter.key().to_vec());
+        iter.next().unwrap();
+    }
+    assert_eq!(order, keys);
+    // Seeking into a gap between prefixes lands on the next prefix.
+    iter.seek(SeekKey::Key(&3u64.to_be_bytes())).unwrap();
+    assert!(iter.valid().unwrap());
+    assert_eq!(iter.key(), &key(256, 0)[..]);
+}
@@ -12,7 +12,8 @@
 // limitations under the License.
 
 use rocksdb::{
-    BlockBasedOptions, ColumnFamilyOptions, DBOptions, SeekKey, SliceTransform, Writable, DB,
+    BlockBasedOptions, BuiltinSliceTransform, ColumnFamilyOptions, DBOptions, FlushOptions,
+    ReadOptions, SeekKey, SliceTransform, Writable, DB,
 };
 
 use super::tempdir_with_prefix;
@@ -99,3 +100,218 @@ fn test_slice_transform() {
 
     // TODO: support total_order mode and add test later.
 }
+
+#[test]
+fn test_builtin_slice_transform() {
+    let path = tempdir_with_prefix("_rust_rocksdb_builtin_slice_transform_test");
+    let mut opts = DBOptions::new();
+    opts.create_if_missing(true);
+    let mut cf_opts = ColumnFamilyOptions::new();
+    let mut block_opts = BlockBasedOptions::new();
+    block_opts.set_bloom_filter(10.0, false);
+    block_opts.set_whole_key_filtering(false);
+    cf_opts.set_block_based_table_factory(&block_opts);
+    cf_opts.set_memtable_prefix_bloom_size_ratio(0.25);
+    cf_opts.set_builtin_prefix_extractor(BuiltinSliceTransform::DelimitedPrefix {
+        delimiter: b'/',
+        count: 2,
+    });
+    let db = DB::open_cf(
+        opts,
+        path.path().to_str().unwrap(),
+        vec![("default", cf_opts)],
+    )
+    .unwrap();
+
+    for k in &[&b"t/a/1"[..], b"t/a/2", b"t/b/1", b"t/c"] {
+        db.put(k, b"v").unwrap();
+    }
+    let mut fopts = FlushOptions::default();
+    fopts.set_wait(true);
+    db.flush(&fopts).unwrap();
+
+    let mut ropts = ReadOptions::new();
+    ropts.set_prefix_same_as_start(true);
+    let mut it = db.iter_opt(ropts);
+    it.seek(SeekKey::Key(b"t/a/")).unwrap();
+    let mut keys = vec![];
+    while it.valid().unwrap() {
+        keys.push(it.key().to_vec());
+        it.next().unwrap();
+    }
+    assert_eq!(keys, vec![b"t/a/1".to_vec(), b"t/a/2".to_vec()]);
+
+    let props = db.get_properties_of_all_tables().unwrap();
+    assert!(!props.is_empty());
+    for (_, p) in props.iter() {
+        assert_eq!(p.prefix_extractor_name(), "crocksdb.DelimitedPrefix.47.2");
+    }
+
+    // Names are persisted in SST properties, so they must not change.
+    let names = [
+        (
+            BuiltinSliceTransform::FixedPrefix(3),
+            "rocksdb.FixedPrefix.3",
+        ),
+        (
+            BuiltinSliceTransform::CappedPrefix(3),
+            "rocksdb.CappedPrefix.3",
+        ),
+        (
+            BuiltinSliceTransform::PrefixAfterHeader {
+                header_len: 2,
+                prefix_len: 3,
+            },
+            "crocksdb.PrefixAfterHeader.2.3",
+        ),
+        (
+            BuiltinSliceTransform::DelimitedPrefix {
+                delimiter: b'/',
+                count: 2,
+            },
+            "crocksdb.DelimitedPrefix.47.2",
+        ),
+        (
+            BuiltinSliceTransform::HeaderMemcomparablePrefix { header_len: 1 },
+            "crocksdb.HeaderMemcomparablePrefix.1",
+        ),
+    ];
+    for (t, name) in &names {
+        assert_eq!(t.name(), *name);
+    }
+
+    // A memcomparable group: 8 data bytes padded with zeros, then a marker
+    // that is 0xFF if more groups follow, or 0xFF minus the padding.
+    let group = |data: &[u8], last: bool| {
+        let mut g = data.to_vec();
+        g.resize(8, 0);
+        g.push(if last {
+            0xFF - (8 - data.len()) as u8
+        } else {
+            0xFF
+        });
+        g
+    };
+    // Exactly one 9-byte group after the header.
+    let mut one_group = b"t".to_vec();
+    one_group.extend(group(b"abcde", true));
+    let mut two_groups = b"t".to_vec();
+    two_groups.extend(group(b"abcdefgh", false));
+    two_groups.extend(group(b"ijk", true));
+    let with_suffix = |key: &[u8]| {
+        let mut k = key.to_vec();
+        k.extend_from_slice(b"_suffix");
+        k
+    };
+    let mut unclosed = b"t".to_vec();
+    unclosed.extend(group(b"abcdefgh", false));
+    let mut no_marker = b"t".to_vec();
+    no_marker.extend_from_slice(b"abcdefgh");
+
+    // (transform, key, expected prefix or None if out of domain)
+    let cases: Vec<(BuiltinSliceTransform, Vec<u8>, Option<Vec<u8>>)> = vec![
+        (
+            BuiltinSliceTransform::CappedPrefix(3),
+            b"".to_vec(),
+            Some(b"".to_vec()),
+        ),
+        (
+            BuiltinSliceTransform::CappedPrefix(3),
+            b"ab".to_vec(),
+            Some(b"ab".to_vec()),
+        ),
+        (
+            BuiltinSliceTransform::CappedPrefix(3),
+            b"abc".to_vec(),
+            Some(b"abc".to_vec()),
+        ),
+        (
+            BuiltinSliceTransform::CappedPrefix(3),
+            b"abcdef".to_vec(),
+            Some(b"abc".to_vec()),
+        ),
+        (
+            BuiltinSliceTransform::PrefixAfterHeader {
+                header_len: 2,
+                prefix_len: 3,
+            },
+            b"a".to_vec(),
+            None,
+        ),
+        (
+            BuiltinSliceTransform::PrefixAfterHeader {
+                header_len: 2,
+                prefix_len: 3,
+            },
+            b"ab".to_vec(),
+            Some(b"ab".to_vec()),
+        ),
+        (
+            BuiltinSliceTransform::PrefixAfterHeader {
+                header_len: 2,
+                prefix_len: 3,
+            },
+            b"abcd".to_vec(),
+            Some(b"abcd".to_vec()),
+        ),
+        (
+            BuiltinSliceTransform::PrefixAfterHeader {
+                header_len: 2,
+                prefix_len: 3,
+            },
+            b"abcdefg".to_vec(),
+            Some(b"abcde".to_vec()),
+        ),
+        (
+            BuiltinSliceTransform::HeaderMemcomparablePrefix { header_len: 1 },
+            b"".to_vec(),
+            None,
+        ),
+        (
+            BuiltinSliceTransform::HeaderMemcomparablePrefix { header_len: 1 },
+            b"t".to_vec(),
+            None,
+        ),
+        (
+            BuiltinSliceTransform::HeaderMemcomparablePrefix { header_len: 1 },
+            one_group.clone(),
+            Some(one_group.clone()),
+        ),
+        (
+            BuiltinSliceTransform::HeaderMemcomparablePrefix { header_len: 1 },
+            with_suffix(&one_group),
+            Some(one_group.clone()),
+        ),
+        (
+            BuiltinSliceTransform::HeaderMemcomparablePrefix { header_len: 1 },
+            with_suffix(&two_groups),
+            Some(two_groups.clone()),
+        ),
+        (
+            BuiltinSliceTransform::HeaderMemcomparablePrefix { header_len: 1 },
+            unclosed.clone(),
+            None,
+        ),
+        (
+            BuiltinSliceTransform::HeaderMemcomparablePrefix { header_len: 1 },
+            no_marker.clone(),
+            None,
+        ),
+    ];
+    for (t, key, expected) in &cases {
+        assert_eq!(
+            t.in_domain(key),
+            expected.is_some(),
+            "{:?} in_domain({:?})",
+            t,
+            key
+        );
+        assert_eq!(
+            t.transform(key),
+            expected.as_deref(),
+            "{:?} transform({:?})",
+            t,
+            key
+        );
+    }
+}
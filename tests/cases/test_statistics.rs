@@ -120,3 +120,54 @@ fn test_shared_db_statistics() {
     let get_micros = statistics.get_histogram(HistogramType::DbGet).unwrap();
     assert_eq!(get_micros.max, 0.0);
 }
+
+#[test]
+fn test_statistics_export() {
+    let path = tempdir_with_prefix("_rust_rocksdb_statistics_export");
+    let mut opts = DBOptions::new();
+    opts.create_if_missing(true);
+    let statistics = Statistics::new();
+    opts.set_statistics(&statistics);
+    let db = DB::open(opts, path.path().to_str().unwrap()).unwrap();
+
+    let io = IOStatsContext::get();
+    let before = io.snapshot();
+    for i in 0..100 {
+        db.put(format!("k{:03}", i).as_bytes(), b"v").unwrap();
+    }
+    let mut fopts = FlushOptions::default();
+    fopts.set_wait(true);
+    db.flush(&fopts).unwrap();
+    for i in 0..100 {
+        assert_eq!(
+            db.get(format!("k{:03}", i).as_bytes()).unwrap().unwrap(),
+            b"v"
+        );
+    }
+    let after = io.snapshot();
+    assert!(after.bytes_written > before.bytes_written);
+    assert_eq!(after.bytes_written, io.bytes_written());
+
+    let export = statistics.export(false);
+    assert!(export.tickers.len() > TickerType::BlockCacheHit as usize);
+    assert!(export.histograms.len() > HistogramType::DbGet as usize);
+    assert_eq!(
+        export.ticker(TickerType::NumberKeysWritten),
+        statistics.get_ticker_count(TickerType::NumberKeysWritten)
+    );
+    let get = export.histogram(HistogramType::DbGet);
+    assert_eq!(get.count, 100);
+    assert!(get.p50 <= get.p99 && get.p99 <= get.max);
+    assert!(get.p999 > 0.0 && get.p999 <= get.max);
+
+    let export = statistics.export(true);
+    assert_eq!(export.ticker(TickerType::NumberKeysWritten), 100);
+    assert_eq!(export.histogram(HistogramType::DbGet).count, 100);
+    let export = statistics.export(false);
+    assert_eq!(export.ticker(TickerType::NumberKeysWritten), 0);
+    assert_eq!(export.histogram(HistogramType::DbGet).count, 0);
+
+    let empty = Statistics::new_empty();
+    let export = empty.export(false);
+    assert!(export.tickers.is_empty() && export.histograms.is_empty());
+}
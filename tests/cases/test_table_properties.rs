@@ -13,11 +13,14 @@
 
 use std::collections::HashMap;
 use std::fmt;
+use std::thread;
+use std::time::Duration;
 
 use rocksdb::{
-    ColumnFamilyOptions, DBEntryType, DBOptions, FlushOptions, Range, ReadOptions, SeekKey,
-    TableFilter, TableProperties, TablePropertiesCollection, TablePropertiesCollector,
-    TablePropertiesCollectorFactory, UserCollectedProperties, Writable, DB,
+    ColumnFamilyOptions, DBEntryType, DBOptions, DBPropertyEncoding, DBTimestampEncoding,
+    FlushOptions, Range, ReadOptions, SeekKey, TableFilter, TableProperties, TablePropertiesCache,
+    TablePropertiesCollection, TablePropertiesCollector, TablePropertiesCollectorFactory,
+    UserCollectedProperties, Writable, DB,
 };
 
 use super::tempdir_with_prefix;
@@ -296,3 +299,157 @@ fn test_table_properties_with_table_filter() {
     // First sst will be skipped
     assert_eq!(iter.key(), key5.as_ref());
 }
+
+#[test]
+fn test_mvcc_properties_collector() {
+    let mut opts = DBOptions::new();
+    let mut cf_opts = ColumnFamilyOptions::new();
+    opts.create_if_missing(true);
+    cf_opts.add_mvcc_properties_collector(0, 8, DBTimestampEncoding::BigEndianDesc);
+    let path = tempdir_with_prefix("_rust_rocksdb_mvcc_collector");
+    let db = DB::open_cf(
+        opts,
+        path.path().to_str().unwrap(),
+        vec![("default", cf_opts)],
+    )
+    .unwrap();
+
+    let key = |k: &[u8], ts: u64| {
+        let mut key = k.to_vec();
+        key.extend_from_slice(&(!ts).to_be_bytes());
+        key
+    };
+    db.put(&key(b"k1", 5), b"v").unwrap();
+    db.put(&key(b"k1", 3), b"v").unwrap();
+    db.delete(&key(b"k1", 7)).unwrap();
+    db.put(&key(b"k2", 4), b"v").unwrap();
+    let mut fopts = FlushOptions::default();
+    fopts.set_wait(true);
+    db.flush(&fopts).unwrap();
+
+    let collection = db.get_properties_of_all_tables().unwrap();
+    assert_eq!(collection.len(), 1);
+    for (_, props) in collection.iter() {
+        let mvcc = props.user_collected_properties().mvcc_properties().unwrap();
+        assert_eq!(mvcc.num_rows, 2);
+        assert_eq!(mvcc.num_versions, 4);
+        assert_eq!(mvcc.num_puts, 3);
+        assert_eq!(mvcc.num_deletes, 1);
+        assert_eq!(mvcc.max_row_versions, 3);
+        assert_eq!(mvcc.min_ts, 3);
+        assert_eq!(mvcc.max_ts, 7);
+    }
+}
+
+#[test]
+fn test_range_properties_collector() {
+    let mut opts = DBOptions::new();
+    let mut cf_opts = ColumnFamilyOptions::new();
+    opts.create_if_missing(true);
+    cf_opts.add_range_properties_collector(u64::MAX, 2);
+    let path = tempdir_with_prefix("_rust_rocksdb_range_collector");
+    let db = DB::open_cf(
+        opts,
+        path.path().to_str().unwrap(),
+        vec![("default", cf_opts)],
+    )
+    .unwrap();
+    let cf = db.cf_handle("default").unwrap();
+
+    for i in 0..100 {
+        let key = format!("key{:02}", i);
+        db.put(key.as_bytes(), b"0123456789").unwrap();
+    }
+    let mut fopts = FlushOptions::default();
+    fopts.set_wait(true);
+    db.flush(&fopts).unwrap();
+
+    // Samples are taken at every odd key, the one of "key99" is out of range.
+    let props = db
+        .get_range_properties_cf(cf, Range::new(b"key00", b"key99"))
+        .unwrap();
+    assert_eq!(props.num_keys, 98);
+    assert_eq!(props.size, 98 * 15);
+    assert_eq!(props.middle_key.unwrap(), b"key49");
+
+    let props = db
+        .get_range_properties_cf(cf, Range::new(b"zzz", b"zzzz"))
+        .unwrap();
+    assert_eq!(props.num_keys, 0);
+    assert!(props.middle_key.is_none());
+}
+
+#[test]
+fn test_table_properties_cache() {
+    let cache = TablePropertiesCache::new();
+    let mut opts = DBOptions::new();
+    let mut cf_opts = ColumnFamilyOptions::new();
+    opts.create_if_missing(true);
+    opts.add_table_properties_cache(&cache);
+    cf_opts.set_disable_auto_compactions(true);
+    cf_opts.add_table_properties_collector_factory::<ExampleCollector, ExampleFactory>(
+        "example-collector",
+        ExampleFactory::new(),
+    );
+    let path = tempdir_with_prefix("_rust_rocksdb_properties_cache");
+    let db = DB::open_cf(
+        opts,
+        path.path().to_str().unwrap(),
+        vec![("default", cf_opts)],
+    )
+    .unwrap();
+    let cf = db.cf_handle("default").unwrap();
+
+    let mut fopts = FlushOptions::default();
+    fopts.set_wait(true);
+    for k in &[b"key1", b"key2", b"key3", b"key4"] {
+        db.put(*k, b"v").unwrap();
+    }
+    db.flush(&fopts).unwrap();
+    for k in &[b"key1", b"key2"] {
+        db.delete(*k).unwrap();
+    }
+    db.flush(&fopts).unwrap();
+    assert_eq!(cache.len(), 2);
+
+    let props: Vec<(&[u8], DBPropertyEncoding)> = vec![
+        (
+            &[Props::NumKeys as u8],
+            DBPropertyEncoding::FixedLittleEndian,
+        ),
+        (
+            &[Props::NumPuts as u8],
+            DBPropertyEncoding::FixedLittleEndian,
+        ),
+        (
+            &[Props::NumDeletes as u8],
+            DBPropertyEncoding::FixedLittleEndian,
+        ),
+        (b"no-such-property", DBPropertyEncoding::Varint),
+    ];
+    let range = || Range::new(b"key1", b"key5");
+    let sums = db
+        .aggregate_table_properties_cf(&cache, cf, range(), &props)
+        .unwrap();
+    assert_eq!(sums, vec![6, 4, 2, 0]);
+    // ["key3", "key4") only overlaps the first file.
+    let sums = db
+        .aggregate_table_properties_cf(&cache, cf, Range::new(b"key3", b"key4"), &props)
+        .unwrap();
+    assert_eq!(sums, vec![4, 4, 0, 0]);
+
+    db.compact_range(None, None);
+    let sums = db
+        .aggregate_table_properties_cf(&cache, cf, range(), &props)
+        .unwrap();
+    assert_eq!(sums, vec![2, 2, 0, 0]);
+    // Entries of the compacted inputs are evicted once their files are
+    // deleted, which may happen after `compact_range` returns.
+    for _ in 0..100 {
+        if cache.len() == 1 {
+            break;
+        }
+        thread::sleep(Duration::from_millis(10));
+    }
+    assert_eq!(cache.len(), 1);
+}
@@ -0,0 +1,80 @@
+// Copyright 2026 TiKV Project Authors. Licensed under Apache-2.0.
+
+use rocksdb::{
+    DBOptions, DBTraceFilter, DBTracedOp, FlushOptions, SeekKey, TraceOptions, Writable, DB,
+};
+
+use super::tempdir_with_prefix;
+
+#[test]
+fn test_trace_and_replay() {
+    let path = tempdir_with_prefix("_rust_rocksdb_test_trace");
+    let trace_dir = tempdir_with_prefix("_rust_rocksdb_test_trace_files");
+    let query_trace = trace_dir.path().join("query");
+    let block_cache_trace = trace_dir.path().join("block_cache");
+    let io_trace = trace_dir.path().join("io");
+    let empty_block_cache_trace = trace_dir.path().join("empty_block_cache");
+    let empty_io_trace = trace_dir.path().join("empty_io");
+    let mut opts = DBOptions::new();
+    opts.create_if_missing(true);
+    let db = DB::open(opts, path.path().to_str().unwrap()).unwrap();
+
+    let mut trace_opts = TraceOptions::new();
+    trace_opts.set_filter(&[DBTraceFilter::IterSeekForPrev]);
+    db.start_trace(&query_trace, &trace_opts).unwrap();
+    let n = 20;
+    for i in 0..n {
+        let k = format!("key{:02}", i);
+        db.put(k.as_bytes(), b"value").unwrap();
+    }
+    for i in 0..n {
+        let k = format!("key{:02}", i);
+        assert!(db.get(k.as_bytes()).unwrap().is_some());
+    }
+    let mut iter = db.iter();
+    assert!(iter.seek(SeekKey::Key(b"key05")).unwrap());
+    assert!(iter.seek_for_prev(SeekKey::Key(b"key10")).unwrap());
+    drop(iter);
+    db.end_trace().unwrap();
+    assert!(query_trace.metadata().unwrap().len() > 0);
+
+    let mut fopts = FlushOptions::default();
+    fopts.set_wait(true);
+    db.flush(&fopts).unwrap();
+    let trace_opts = TraceOptions::default();
+    // Traces without any reads only hold their headers.
+    db.start_block_cache_trace(&empty_block_cache_trace, &trace_opts)
+        .unwrap();
+    db.start_io_trace(&empty_io_trace, &trace_opts).unwrap();
+    db.end_io_trace().unwrap();
+    db.end_block_cache_trace().unwrap();
+    db.start_block_cache_trace(&block_cache_trace, &trace_opts)
+        .unwrap();
+    db.start_io_trace(&io_trace, &trace_opts).unwrap();
+    for i in 0..n {
+        let k = format!("key{:02}", i);
+        assert!(db.get(k.as_bytes()).unwrap().is_some());
+    }
+    db.end_io_trace().unwrap();
+    db.end_block_cache_trace().unwrap();
+    let len = |path: &std::path::Path| path.metadata().unwrap().len();
+    assert!(len(&block_cache_trace) > len(&empty_block_cache_trace));
+    assert!(len(&io_trace) > len(&empty_io_trace));
+
+    let replay_path = tempdir_with_prefix("_rust_rocksdb_test_trace_replay");
+    let mut opts = DBOptions::new();
+    opts.create_if_missing(true);
+    let replay_db = DB::open(opts, replay_path.path().to_str().unwrap()).unwrap();
+    let report = replay_db.replay_trace(&query_trace, 2, 100.0).unwrap();
+    assert_eq!(report.errors, 0);
+    assert_eq!(report.latency(DBTracedOp::Write).count, n);
+    assert_eq!(report.latency(DBTracedOp::Get).count, n);
+    // Seeks backwards were filtered out of the trace.
+    assert_eq!(report.latency(DBTracedOp::IterSeek).count, 1);
+    let get = report.latency(DBTracedOp::Get);
+    assert!(get.percentile_nanos(99.0) <= get.max_nanos);
+    for i in 0..n {
+        let k = format!("key{:02}", i);
+        assert!(replay_db.get(k.as_bytes()).unwrap().is_some());
+    }
+}
@@ -0,0 +1,87 @@
+// Copyright 2024 TiKV Project Authors. Licensed under Apache-2.0.
+
+use rocksdb::{ColumnFamilyOptions, DBOptions, ReadOptions, SeekKey, WriteBatch, DB};
+
+use super::tempdir_with_prefix;
+
+// `BytewiseComparatorWithU64Ts` encodes timestamps as fixed64 little-endian.
+fn ts(v: u64) -> Vec<u8> {
+    v.to_le_bytes().to_vec()
+}
+
+fn read_at(v: u64) -> ReadOptions {
+    let mut ropts = ReadOptions::new();
+    ropts.set_timestamp(ts(v));
+    ropts
+}
+
+#[test]
+fn test_user_timestamp() {
+    let path = tempdir_with_prefix("_rust_rocksdb_user_timestamp");
+    let mut opts = DBOptions::new();
+    opts.create_if_missing(true);
+    let mut cf_opts = ColumnFamilyOptions::new();
+    cf_opts
+        .set_builtin_comparator("leveldb.BytewiseComparator.u64ts")
+        .unwrap();
+    let db = DB::open_cf(
+        opts,
+        path.path().to_str().unwrap(),
+        vec![("default", cf_opts)],
+    )
+    .unwrap();
+    let cf = db.cf_handle("default").unwrap();
+
+    db.put_cf_with_ts(cf, b"k1", &ts(10), b"v10").unwrap();
+    db.put_cf_with_ts(cf, b"k1", &ts(20), b"v20").unwrap();
+    let wb = WriteBatch::new();
+    wb.put_cf_with_ts(cf, b"k2", &ts(15), b"v15").unwrap();
+    db.write(&wb).unwrap();
+    db.delete_cf_with_ts(cf, b"k2", &ts(30)).unwrap();
+
+    assert!(db
+        .get_cf_with_ts_opt(cf, b"k1", &read_at(5))
+        .unwrap()
+        .is_none());
+    let (v, t) = db
+        .get_cf_with_ts_opt(cf, b"k1", &read_at(15))
+        .unwrap()
+        .unwrap();
+    assert_eq!(&*v, b"v10");
+    assert_eq!(t, ts(10));
+    let (v, _) = db
+        .get_cf_with_ts_opt(cf, b"k1", &read_at(25))
+        .unwrap()
+        .unwrap();
+    assert_eq!(&*v, b"v20");
+    assert!(db
+        .get_cf_with_ts_opt(cf, b"k2", &read_at(20))
+        .unwrap()
+        .is_some());
+    assert!(db
+        .get_cf_with_ts_opt(cf, b"k2", &read_at(30))
+        .unwrap()
+        .is_none());
+
+    // All versions of k1 in [10, 25].
+    let mut ropts = read_at(25);
+    ropts.set_iter_start_ts(ts(10));
+    let mut iter = db.iter_cf_opt(cf, ropts);
+    iter.seek(SeekKey::Start).unwrap();
+    let mut versions = vec![];
+    while iter.valid().unwrap() {
+        // With `iter_start_ts` the key is internal: user key, timestamp, and
+        // the 8-byte sequence number and type footer.
+        let key = iter.key();
+        assert_eq!(&key[key.len() - 16..key.len() - 8], iter.timestamp());
+        if &key[..key.len() - 16] == b"k1" {
+            versions.push(iter.timestamp().to_vec());
+        }
+        iter.next().unwrap();
+    }
+    assert_eq!(versions, vec![ts(20), ts(10)]);
+
+    db.increase_full_history_ts_low(cf, &ts(12)).unwrap();
+    assert_eq!(db.get_full_history_ts_low(cf).unwrap(), ts(12));
+    assert!(db.increase_full_history_ts_low(cf, &ts(11)).is_err());
+}